@@ -0,0 +1,639 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "GameSettings.h"
+#include "CSVParser.h"
+#include "CSVTokenizer.h"
+#include "WordSampler.h"
+#include "Playfield.h"
+#include "Word.h"
+#include "FramePacer.h"
+#include "RenderBackend.h"
+#include "ParticleSystem.h"
+#include "KeystrokeRecorder.h"
+#include "PersistenceWorker.h"
+
+using namespace std;
+
+// Microbenchmarks for the hot paths of the game.
+// The results are written in the JSON format of Google Benchmark, so the results of two commits can be compared with its tools/compare.py.
+// usage (start from the repository root, because the resources are loaded with relative paths):
+//		typing_game_bench [--words 10,100,1000,10000,100000] [--min-time <seconds>] [--filter <substring>] [--out <file>]
+// every benchmark is run once for every word count. Without --out the JSON is written to stdout.
+
+mutex mutex_glob;	// normally defined in main.cpp, which is not part of the benchmark executable
+
+// result of one benchmark run. The times are per iteration
+typedef struct benchmark_result
+{
+	string name;
+	unsigned long long iterations;
+	double real_time_ns;
+	double cpu_time_ns;
+	double items_per_second;	// items (words) processed per second
+	vector<pair<string, double>> counters;	// user counters of the benchmark (e.g. "bytes_used" or "draw_calls"). written into the JSON
+} benchmark_result_t;
+
+// settings of the benchmark run. set by the command line arguments
+typedef struct benchmark_config
+{
+	vector<unsigned int> word_counts;
+	double min_time;			// minimum measuring time of a benchmark. in seconds
+	string filter;				// only run benchmarks that contain this string in their name
+	string out_filename;		// write the JSON to this file instead of stdout
+} benchmark_config_t;
+
+static benchmark_config_t bench_config;
+static vector<benchmark_result_t> bench_results;
+
+// run a benchmark function with an increasing number of iterations until the minimum measuring time is reached
+// the result is stored in bench_results and printed to stderr
+// name: input. name of the benchmark (including the word count)
+// items_per_iteration: input. number of items that are processed in one iteration. used to calculate the throughput
+// func: input. function that runs the benchmarked code <iterations> times. Signature: void func(unsigned long long iterations)
+template <typename F>
+static void run_benchmark(const string& name, unsigned long long items_per_iteration, F func)
+{
+	if (name.find(bench_config.filter) == string::npos)
+		return;
+
+	unsigned long long iterations = 1;
+	double real_time = 0, cpu_time = 0;		// in seconds
+
+	func(1);	// warm up (fills the caches and the glyph textures of the fonts)
+	while (1)
+	{
+		auto real_start = chrono::steady_clock::now();
+		clock_t cpu_start = clock();
+		func(iterations);
+		cpu_time = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
+		real_time = chrono::duration<double>(chrono::steady_clock::now() - real_start).count();
+
+		if (real_time >= bench_config.min_time || iterations >= 1000000000ULL)
+			break;
+		// estimate the needed number of iterations from the last run. grow at least by a factor of 2 and at most by a factor of 10
+		double factor = (real_time > 0) ? bench_config.min_time * 1.4 / real_time : 10;
+		if (factor < 2)
+			factor = 2;
+		else if (factor > 10)
+			factor = 10;
+		iterations = (unsigned long long)(iterations * factor);
+	}
+
+	benchmark_result_t result;
+	result.name = name;
+	result.iterations = iterations;
+	result.real_time_ns = real_time * 1e9 / iterations;
+	result.cpu_time_ns = cpu_time * 1e9 / iterations;
+	result.items_per_second = (real_time > 0) ? items_per_iteration * iterations / real_time : 0;
+	bench_results.push_back(result);
+
+	cerr << name << ": " << result.real_time_ns << " ns/iteration, " << result.items_per_second << " items/s (" << iterations << " iterations)" << endl;
+}
+
+// store a user counter of the last benchmark, e.g. the memory usage of the data structure as "bytes_used". written in the JSON
+// name: input. name of the benchmark. nothing is stored if this benchmark was not run (see --filter)
+// counter_name: input. name of the counter in the JSON
+// value: input. value of the counter
+static void set_counter(const string& name, const string& counter_name, double value)
+{
+	if (bench_results.empty() || bench_results.back().name != name)
+		return;
+	bench_results.back().counters.push_back(make_pair(counter_name, value));
+	cerr << name << ": " << counter_name << " " << value << endl;
+}
+
+// write a csv file with num_words words. the words are taken from the word list of the game (repeated if necessary)
+// filename: input. path of the file to create
+// num_words: input. number of words in the file
+// source_words: input. words to take
+static void write_word_file(const string& filename, unsigned int num_words, const vector<string>& source_words)
+{
+	ofstream fout(filename);
+	for (unsigned int i = 0; i < num_words; i++)
+		fout << source_words[i % source_words.size()] << "\n";
+}
+
+// benchmarks of the startup: time until the assets are loaded by the AssetLoader of a new GameSettings object.
+// the first phase is the time until the Start Screen can be shown, the word list phase the time until a round can be started
+static void benchmark_startup()
+{
+	run_benchmark("startup_first_font", 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+		{
+			GameSettings startup_settings;
+			startup_settings.set_read_only(true);
+			startup_settings.get_asset_loader().wait_for(GameSettings::FONT_PHASE);
+		}
+	});
+	run_benchmark("startup_playable", 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+		{
+			GameSettings startup_settings;
+			startup_settings.set_read_only(true);
+			startup_settings.wait_until_playable();
+		}
+	});
+	run_benchmark("startup_all_assets", 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+		{
+			GameSettings startup_settings;
+			startup_settings.set_read_only(true);
+			startup_settings.get_asset_loader().wait_for(GameSettings::NUM_LOAD_PHASES - 1);
+		}
+	});
+}
+
+// benchmark of the FPS_CAP mode of the FramePacer without a window. the time per iteration should be the frame time of the cap (8.33 ms at 120 FPS),
+// the pacing error (deviation from the frame time) is written to stderr
+static void benchmark_frame_pacer()
+{
+	FramePacer pacer;
+	pacer.set_mode(FramePacer::FPS_CAP, 120);
+	run_benchmark("framepacer_fps_cap_120", 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			pacer.wait_frame();
+	});
+	if (bench_config.filter.empty() || string("framepacer_fps_cap_120").find(bench_config.filter) != string::npos)
+		cerr << pacer.get_report() << endl;
+}
+
+// benchmarks of the CSVParser, which is used to load the word list and to get a random word for every new word on the Playfield
+static void benchmark_csvparser(GameSettings& settings, unsigned int num_words, const vector<string>& source_words)
+{
+	string filename = "bench_word_list.csv";
+	write_word_file(filename, num_words, source_words);
+	string suffix = "/" + to_string(num_words);
+
+	run_benchmark("csvparser_construct" + suffix, num_words, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+		{
+			CSVParser parser(filename, settings.csv_delimiter, settings.csv_column);
+			if (parser.num_elem == 0)
+				cerr << "word file can't be read" << endl;
+		}
+	});
+
+	// load throughput of the tokenizer in bytes per second. once with the plain word list and once with a quoted word column and a frequency column
+	for (int quoted = 0; quoted < 2; quoted++)
+	{
+		string content;
+		for (unsigned int i = 0; i < num_words; i++)
+		{
+			if (quoted)
+				content += "\"" + source_words[i % source_words.size()] + (i % 10 == 0 ? "\"\"s" : "") + "\";" + to_string(i) + "\r\n";
+			else
+				content += source_words[i % source_words.size()] + "\r\n";
+		}
+		vector<char> buffer(content.size());
+		vector<string_view> fields;
+		CSVTokenizer tokenizer(settings.csv_delimiter, quoted ? 0 : CSVTokenizer::ALL_COLUMNS);
+		run_benchmark(string(quoted ? "csvtokenizer_quoted_column" : "csvtokenizer_plain") + suffix, content.size(), [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+			{
+				memcpy(buffer.data(), content.data(), content.size());	// the quoted fields are unescaped in place
+				tokenizer.tokenize(buffer.data(), buffer.size(), fields);
+			}
+		});
+	}
+
+	CSVParser parser(filename, settings.csv_delimiter, settings.csv_column);
+	run_benchmark("csvparser_get_random_elem" + suffix, 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			parser.get_random_elem();
+	});
+
+	// a word with a length range and a tier, like in the ramp word mode. must not depend on the size of the word list
+	const WordIndex& word_index = parser.get_word_index();
+	run_benchmark("wordindex_get_word" + suffix, 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			word_index.get_word(3 + i % 8, 5 + i % 8, (unsigned int)(i % WordIndex::NUM_TIERS));
+	});
+
+	WordSampler sampler;
+	sampler.init(parser);
+	run_benchmark("wordsampler_init" + suffix, num_words, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			sampler.init(parser);
+	});
+
+	// a reloaded word list during a round. the words of the letters are built by the WordListWatcher, so this must not depend on the size of the word list
+	shared_ptr<WordSampler::letter_index_t> letter_index = make_shared<WordSampler::letter_index_t>();
+	WordSampler::build_index(parser, *letter_index);
+	run_benchmark("wordsampler_set_word_list" + suffix, 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			sampler.set_word_list(letter_index);
+	});
+
+	// the time per word must not depend on the size of the word list
+	run_benchmark("wordsampler_get_word_index" + suffix, 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			sampler.get_word_index();
+	});
+
+	run_benchmark("wordsampler_record_keystroke" + suffix, 1, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			sampler.record_keystroke((char)('a' + i % 26), i % 7 != 0);
+	});
+
+	remove(filename.c_str());
+}
+
+// compare the memory usage and the access times of the word stores (see WordStore.h). the word file contains every word only once,
+// because the front coded store removes duplicates (a number is appended to the repeated source words)
+static void benchmark_word_stores(GameSettings& settings, unsigned int num_words, const vector<string>& source_words)
+{
+	string filename = "bench_word_store.csv";
+	vector<string> unique_words(source_words);
+	sort(unique_words.begin(), unique_words.end());
+	unique_words.erase(unique(unique_words.begin(), unique_words.end()), unique_words.end());
+	vector<string> words;
+	for (unsigned int i = 0; i < num_words; i++)
+		words.push_back(unique_words[i % unique_words.size()] + to_string(i / unique_words.size()));
+	{
+		ofstream fout(filename);
+		for (unsigned int i = 0; i < num_words; i++)
+			fout << words[i] << "\n";
+	}
+	string suffix = "/" + to_string(num_words);
+	const int store_types[] = { CSVParser::OFFSET_TABLE_STORE, CSVParser::FRONT_CODED_STORE };
+	const string store_names[] = { "offset_table", "front_coded" };
+
+	for (int type = 0; type < 2; type++)
+	{
+		string name = "wordstore_" + store_names[type];
+		CSVParser parser(filename, settings.csv_delimiter, settings.csv_column, store_types[type]);
+		if (parser.num_elem != num_words)
+			cerr << "word file can't be read" << endl;
+
+		run_benchmark(name + "_construct" + suffix, num_words, [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+				CSVParser parser_tmp(filename, settings.csv_delimiter, settings.csv_column, store_types[type]);
+		});
+		set_counter(name + "_construct" + suffix, "bytes_used", (double)parser.get_memory_size());
+
+		// random access by ordinal, like a new word on the Playfield
+		string word;
+		run_benchmark(name + "_get_elem" + suffix, 1, [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+				parser.get_elem(CSVParser::random_index(parser.num_elem), word);
+		});
+
+		// membership test. the offset table has to compare every word, so only the front coded store is measured with big word lists
+		if (store_types[type] == CSVParser::FRONT_CODED_STORE || num_words <= 10000)
+		{
+			run_benchmark(name + "_find_elem" + suffix, 1, [&](unsigned long long iterations) {
+				for (unsigned long long i = 0; i < iterations; i++)
+					parser.find_elem(words[CSVParser::random_index(num_words)]);
+			});
+		}
+	}
+
+	remove(filename.c_str());
+}
+
+// benchmark of the queries of the Stats Screen (all three lists) on a keystroke file with num_keys keystrokes (the word count of the run).
+// the keystrokes are recorded in rounds of 300 keystrokes (about one round of a fast typist) with every 17th keystroke wrong. the size of the file is stored as "file_bytes"
+static void benchmark_keystroke_query(unsigned int num_keys)
+{
+	const unsigned int keys_per_round = 300;
+	string filename = "bench_keystrokes.bin";
+	string name = "keystroke_query/" + to_string(num_keys);
+	if (name.find(bench_config.filter) == string::npos)
+		return;
+
+	remove(filename.c_str());
+	PersistenceWorker persistence;
+	KeystrokeRecorder recorder(filename, persistence);
+	for (unsigned int i = 0; i < num_keys; i++)
+	{
+		if (i % keys_per_round == 0)
+			recorder.start_round();
+		char expected = (char)('a' + i * 7 % 26);
+		recorder.record_keystroke(expected, (i % 17 == 0) ? '#' : expected, 3 + i % 8);
+	}
+	recorder.end_round();
+	persistence.flush();
+
+	vector<letter_stat_t> letter_stats;
+	vector<bigram_stat_t> bigram_stats;
+	vector<wpm_point_t> wpm_points;
+	run_benchmark(name, num_keys, [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+		{
+			recorder.get_letter_stats(letter_stats);
+			recorder.get_bigram_stats(bigram_stats);
+			recorder.get_wpm_over_time(wpm_points);
+		}
+	});
+	ifstream fin(filename, ios::binary | ios::ate);
+	set_counter(name, "file_bytes", (double)fin.tellg());
+	fin.close();
+
+	remove(filename.c_str());
+}
+
+// benchmarks of the particle effects with num_particles live particles (the word count of the run). the frame budget is 16.7 ms at 60 FPS.
+// the time step is 0, so no particle expires while the benchmark runs
+// render_backend: input. offscreen render target with the size of the window. NULL if offscreen rendering is not supported (the rasterizing benchmark is skipped)
+static void benchmark_particles(GameSettings& settings, unsigned int num_particles, TextureRenderBackend* render_backend)
+{
+	if (num_particles > ParticleSystem::MAX_PARTICLES)
+		return;
+
+	// shatter words until the pool has the wanted number of particles
+	ParticleSystem particles;
+	Word word("particles", settings.getFont(), 100, 0);
+	word.setPosition(600, 400);
+	while (particles.get_num_particles() < num_particles)
+	{
+		unsigned int num_before = particles.get_num_particles();
+		particles.spawn_shatter(word, word.get_velocity_vector());
+		if (particles.get_num_particles() == num_before)	// the font has no glyphs
+			return;
+	}
+	string suffix = "/" + to_string(num_particles);
+
+	run_benchmark("particles_step" + suffix, particles.get_num_particles(), [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+			particles.step(0);
+	});
+
+	// building the vertices and copying them into the command buffer. runs in the main thread
+	DrawCommandBuffer commands(sf::Vector2u((unsigned int)settings.get_window_size().x, (unsigned int)settings.get_window_size().y));
+	run_benchmark("particles_record_draw_commands" + suffix, particles.get_num_particles(), [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+		{
+			commands.reset();
+			commands.draw_entity(particles);
+		}
+	});
+
+	if (render_backend == NULL)
+		return;
+	run_benchmark("particles_draw_on_window" + suffix, particles.get_num_particles(), [&](unsigned long long iterations) {
+		for (unsigned long long i = 0; i < iterations; i++)
+		{
+			commands.reset();
+			commands.clear();
+			commands.draw_entity(particles);
+			commands.replay(*render_backend);
+			render_backend->display();
+		}
+	});
+}
+
+// benchmarks of the Playfield and its Words. Needs access to the private members of the Playfield (declared as friend there)
+template <typename U>
+class PlayfieldBenchmark
+{
+public:
+	// run all benchmarks that use a Playfield with the boundary type U and num_words words on it
+	// bound_name: input. name of the boundary type used in the benchmark name
+	// render_backend: input. offscreen render target with the size of the window. NULL if offscreen rendering is not supported (the rasterizing benchmarks are skipped)
+	static void run(GameSettings& settings, unsigned int num_words, const string& bound_name, const vector<string>& source_words, TextureRenderBackend* render_backend)
+	{
+		Playfield<U> playfield(settings);
+		string suffix = "/" + to_string(num_words);
+
+		// the words are put on the playfield without its update() function, because the number of words in the settings is limited
+		for (unsigned int i = 0; i < num_words; i++)
+		{
+			Word* new_word = new Word(source_words[i % source_words.size()], settings.getFont(), 100, 0);	// no max_health: the words don't die
+			playfield.spawn_word(*new_word, playfield.boundary);
+			playfield.word_list.push_back(new_word);
+			playfield.collision_cnt.push_back(0);
+		}
+
+		run_benchmark("spawn_word_" + bound_name + suffix, num_words, [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+			{
+				for (auto word_list_it = playfield.word_list.begin(); word_list_it != playfield.word_list.end(); word_list_it++)
+					playfield.spawn_word(**word_list_it, playfield.boundary);
+			}
+		});
+
+		run_benchmark("word_reflection_" + bound_name + suffix, num_words, [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+			{
+				for (auto word_list_it = playfield.word_list.begin(); word_list_it != playfield.word_list.end(); word_list_it++)
+					playfield.word_reflection(**word_list_it, playfield.boundary);
+			}
+		});
+
+		// the following benchmarks don't depend on the boundary type, so they only run once
+		if (bound_name == "rect")
+		{
+			run_benchmark("word_update_physics" + suffix, num_words, [&](unsigned long long iterations) {
+				for (unsigned long long i = 0; i < iterations; i++)
+				{
+					for (auto word_list_it = playfield.word_list.begin(); word_list_it != playfield.word_list.end(); word_list_it++)
+						(*word_list_it)->update_physics();
+				}
+			});
+
+			// type the letters of the alphabet one after the other. most key presses reset the writing index, some advance it
+			sf::Event::KeyEvent key_evnt = {};
+			run_benchmark("word_key_pressed_processor" + suffix, num_words, [&](unsigned long long iterations) {
+				for (unsigned long long i = 0; i < iterations; i++)
+				{
+					key_evnt.code = (sf::Keyboard::Key)(sf::Keyboard::A + i % 26);
+					for (auto word_list_it = playfield.word_list.begin(); word_list_it != playfield.word_list.end(); word_list_it++)
+						(*word_list_it)->key_pressed_processor(key_evnt);
+				}
+			});
+		}
+
+		// recording the draw commands is the part of the drawing that runs in the main thread. the replay runs in the render thread
+		DrawCommandBuffer commands(sf::Vector2u((unsigned int)settings.get_window_size().x, (unsigned int)settings.get_window_size().y));
+		run_benchmark("playfield_record_draw_commands_" + bound_name + suffix, num_words, [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+			{
+				commands.reset();
+				commands.clear();
+				commands.draw_entity(playfield);
+			}
+		});
+
+		// the render cost without OpenGL: the draw calls, vertices, texture binds and state changes of a frame
+		CountingRenderBackend counting_backend;
+		string counting_name = "playfield_render_counting_" + bound_name + suffix;
+		run_benchmark(counting_name, num_words, [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+			{
+				commands.reset();
+				commands.clear();
+				commands.draw_entity(playfield);
+				commands.replay(counting_backend);
+				counting_backend.display();
+			}
+		});
+		if (counting_backend.get_num_frames() > 0)
+		{
+			const CountingRenderBackend::render_stats_t& render_stats = counting_backend.get_frame_stats();
+			set_counter(counting_name, "draw_calls", (double)render_stats.draw_calls);
+			set_counter(counting_name, "vertices", (double)render_stats.vertices);
+			set_counter(counting_name, "texture_binds", (double)render_stats.texture_binds);
+			set_counter(counting_name, "state_changes", (double)render_stats.state_changes);
+			if (!bench_results.empty() && bench_results.back().name == counting_name)
+				cerr << counting_backend.get_report() << endl;
+		}
+
+		if (render_backend == NULL)
+			return;
+		run_benchmark("playfield_draw_on_window_" + bound_name + suffix, num_words, [&](unsigned long long iterations) {
+			for (unsigned long long i = 0; i < iterations; i++)
+			{
+				commands.reset();
+				commands.clear();
+				commands.draw_entity(playfield);
+				commands.replay(*render_backend);
+				render_backend->display();
+			}
+		});
+	}
+};
+
+// write all results in the JSON format of Google Benchmark
+static void write_json(ostream& out)
+{
+	time_t now = time(0);
+	char date[64];
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+	out << "{\n";
+	out << "  \"context\": {\n";
+	out << "    \"date\": \"" << date << "\",\n";
+	out << "    \"executable\": \"typing_game_bench\",\n";
+	out << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+	out << "    \"library_build_type\": \"release\"\n";
+#else
+	out << "    \"library_build_type\": \"debug\"\n";
+#endif
+	out << "  },\n";
+	out << "  \"benchmarks\": [\n";
+	for (size_t i = 0; i < bench_results.size(); i++)
+	{
+		const benchmark_result_t& result = bench_results[i];
+		out << "    {\n";
+		out << "      \"name\": \"" << result.name << "\",\n";
+		out << "      \"run_name\": \"" << result.name << "\",\n";
+		out << "      \"run_type\": \"iteration\",\n";
+		out << "      \"iterations\": " << result.iterations << ",\n";
+		out << "      \"real_time\": " << result.real_time_ns << ",\n";
+		out << "      \"cpu_time\": " << result.cpu_time_ns << ",\n";
+		out << "      \"time_unit\": \"ns\",\n";
+		out << "      \"items_per_second\": " << result.items_per_second << (result.counters.empty() ? "\n" : ",\n");
+		for (size_t j = 0; j < result.counters.size(); j++)
+			out << "      \"" << result.counters[j].first << "\": " << result.counters[j].second << (j + 1 < result.counters.size() ? ",\n" : "\n");
+		out << "    }" << (i + 1 < bench_results.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n";
+	out << "}\n";
+}
+
+// parse the command line arguments into bench_config
+// return: -1 if an argument is invalid. 0 if no error
+static int parse_args(int argc, char* argv[])
+{
+	bench_config.word_counts = { 10, 100, 1000, 10000, 100000 };	// from the current maximum number of words on the Playfield up to 100k
+	bench_config.min_time = 0.5;
+	bench_config.filter = "";
+	bench_config.out_filename = "";
+
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "--words" && i + 1 < argc)
+		{
+			bench_config.word_counts.clear();
+			stringstream ss(argv[++i]);
+			string value;
+			while (getline(ss, value, ','))
+			{
+				if (atoi(value.c_str()) <= 0)
+					return -1;
+				bench_config.word_counts.push_back((unsigned int)atoi(value.c_str()));
+			}
+		}
+		else if (arg == "--min-time" && i + 1 < argc)
+			bench_config.min_time = atof(argv[++i]);
+		else if (arg == "--filter" && i + 1 < argc)
+			bench_config.filter = argv[++i];
+		else if (arg == "--out" && i + 1 < argc)
+			bench_config.out_filename = argv[++i];
+		else
+			return -1;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (parse_args(argc, argv) < 0)
+	{
+		cerr << "usage: typing_game_bench [--words 10,100,1000,10000,100000] [--min-time <seconds>] [--filter <substring>] [--out <file>]" << endl;
+		return 1;
+	}
+
+	srand(1);	// the same random numbers in every run
+
+	GameSettings settings;
+	settings.set_read_only(true);
+
+	// words for the generated word lists and the Playfield
+	vector<string> source_words;
+	CSVParser word_list_csv(settings.wordlist_csv_filename, settings.csv_delimiter, settings.csv_column);
+	for (unsigned int i = 0; i < 1000; i++)
+		source_words.push_back(word_list_csv.get_random_elem());
+
+	// without OpenGL (e.g. on a CI machine) only the draw calls are counted
+	TextureRenderBackend texture_backend;
+	TextureRenderBackend* render_backend = &texture_backend;
+	if (!texture_backend.create((unsigned int)settings.get_window_size().x, (unsigned int)settings.get_window_size().y))
+	{
+		cerr << "offscreen render texture can't be created. the draw benchmarks are skipped" << endl;
+		render_backend = NULL;
+	}
+
+	benchmark_startup();	// independent of the word count
+	benchmark_frame_pacer();
+	for (size_t i = 0; i < bench_config.word_counts.size(); i++)
+	{
+		unsigned int num_words = bench_config.word_counts[i];
+		benchmark_csvparser(settings, num_words, source_words);
+		benchmark_word_stores(settings, num_words, source_words);
+		benchmark_keystroke_query(num_words);
+		benchmark_particles(settings, num_words, render_backend);
+		PlayfieldBenchmark<sf::RectangleShape>::run(settings, num_words, "rect", source_words, render_backend);
+		PlayfieldBenchmark<sf::CircleShape>::run(settings, num_words, "circ", source_words, render_backend);
+	}
+
+	if (bench_config.out_filename.empty())
+	{
+		write_json(cout);
+	}
+	else
+	{
+		ofstream fout(bench_config.out_filename);
+		write_json(fout);
+		if (!fout.good())
+		{
+			cerr << "output file " << bench_config.out_filename << " can't be written" << endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
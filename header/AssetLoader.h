@@ -0,0 +1,56 @@
+#ifndef _ASSETLOADER_HPP_
+#define _ASSETLOADER_HPP_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Entity.h"
+
+
+// loads the assets of the game (fonts, textures, word list) in a background thread, so the window can be shown immediately at the start of the program.
+// the loading is split in phases, which are run one after another in the order they were added. every phase is timed (see get_report()).
+// a screen can ask if a phase is done (is_done()) without waiting, or wait for it (wait_for()). e.g. the START Button is enabled as soon as the phases of the Playfield are done.
+// if a phase throws an exception, the remaining phases are skipped and the exception is rethrown in the thread that waits for a phase or calls rethrow_error()
+// threads that wait for the assets of the skipped phases in other ways (e.g. for a font of the FontManager) are released by the skip handler (see set_skip_handler())
+class AssetLoader
+{
+public:
+	AssetLoader();
+	~AssetLoader();
+
+	unsigned int add_phase(const std::string& name, const std::function<void()>& task);
+	void set_skip_handler(const std::function<void()>& handler);
+	void start();
+	bool is_done(unsigned int phase);
+	bool is_finished();
+	void wait_for(unsigned int phase);
+	void rethrow_error();
+	float get_progress();
+	std::string get_report();
+
+private:
+	typedef struct load_phase
+	{
+		std::string name;				// used in the report and the trace
+		std::function<void()> task;		// loads the assets of the phase. may throw an exception
+		sf::Time duration;				// time the task needed. valid when the phase is done
+		sf::Time end_time;				// time from start() until the end of the phase. valid when the phase is done
+	} load_phase_t;
+
+	std::vector<load_phase_t> phases;		// not changed after start() (except the times of the running phase)
+	std::function<void()> skip_handler;		// called when the remaining phases are skipped. may be empty. not changed after start()
+	std::mutex state_mutex;					// protects num_done and error
+	std::condition_variable state_cv;		// signals a waiting thread that a phase is done
+	unsigned int num_done;					// the phases are done in order, so every phase with an index below num_done is done
+	std::exception_ptr error;				// exception of the failed phase. empty if no phase failed
+	bool stop;								// signals the load thread to skip the remaining phases. protected by state_mutex
+	std::thread load_thread;
+
+	void load_task();
+};
+
+#endif // _ASSETLOADER_HPP_
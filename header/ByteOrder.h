@@ -0,0 +1,74 @@
+#ifndef _BYTEORDER_HPP_
+#define _BYTEORDER_HPP_
+
+#include <vector>
+#include "Entity.h"
+
+
+// helper functions to read and write numbers in little endian byte order, independent of the byte order of the computer.
+// used by every binary file format of the game (settings file, score history, keystroke recorder) and the compressed word store
+
+// read an unsigned number in little endian byte order
+// data: input. first byte of the number
+// num_bytes: input. size of the number in bytes (at most 8)
+// return: the number
+inline sf::Uint64 read_uint_le(const char* data, unsigned int num_bytes)
+{
+	sf::Uint64 value = 0;
+	for (unsigned int i = 0; i < num_bytes; i++)
+		value |= (sf::Uint64)(sf::Uint8)data[i] << (8 * i);
+	return value;
+}
+
+// write an unsigned number in little endian byte order into a buffer
+// data: output. first byte of the number
+// value: input. number to write
+// num_bytes: input. size of the number in bytes (at most 8)
+inline void write_uint_le(char* data, sf::Uint64 value, unsigned int num_bytes)
+{
+	for (unsigned int i = 0; i < num_bytes; i++)
+		data[i] = (char)((value >> (8 * i)) & 0xFF);
+}
+
+// append an unsigned number in little endian byte order to a buffer
+// buffer: input/ output. the number is appended at the end
+// value: input. number to append
+// num_bytes: input. size of the number in bytes (at most 8)
+inline void append_uint_le(std::vector<char>& buffer, sf::Uint64 value, unsigned int num_bytes)
+{
+	for (unsigned int i = 0; i < num_bytes; i++)
+		buffer.push_back((char)((value >> (8 * i)) & 0xFF));
+}
+
+// append a variable length number to a buffer. every byte contains 7 bits of the number (lowest bits first). the highest bit is set if more bytes follow
+// value: input. the number
+// buffer: input/ output. the number is appended at the end
+inline void append_varint(sf::Uint32 value, std::vector<char>& buffer)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back((char)((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back((char)value);
+}
+
+// read a variable length number (see append_varint())
+// data: input. first byte of the number
+// data_end: input. first byte after the data
+// value: output. the number
+// return: first byte after the number. NULL if the number is incomplete or too big
+inline const char* read_varint(const char* data, const char* data_end, sf::Uint32& value)
+{
+	value = 0;
+	for (unsigned int shift = 0; data < data_end && shift < 32; shift += 7)
+	{
+		sf::Uint8 byte = (sf::Uint8)*data++;
+		value |= (sf::Uint32)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+			return data;
+	}
+	return NULL;
+}
+
+#endif // _BYTEORDER_HPP_
@@ -1,26 +1,58 @@
-#ifndef _CSVPARSER_HPP_
-#define _CSVPARSER_HPP_
-
-#include <fstream>
-
-
-// reads from a csv file. Used to obtain random words for the Playfield
-// the csv file parsing is not really accurate, because it doesn't handle quotation marks here
-class CSVParser
-{
-public:
-	char delimiter;				// delimiter which separates the values in the file
-	unsigned int num_elem;		// number of Elements in the opened file
-
-	CSVParser(const std::string& csv_filename = "", char csv_delimiter = ';');
-	CSVParser& operator = (const CSVParser& csvparser_orig);
-	CSVParser(const CSVParser& csvparser_orig);
-
-	std::string get_random_elem();
-
-private:
-	std::string filename;	// path of the opened file
-	std::ifstream fin;		// File pointer. open file for reading
-};
-
-#endif // _CSVPARSER_HPP_
+#ifndef _CSVPARSER_HPP_
+#define _CSVPARSER_HPP_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <string_view>
+#include "WordIndex.h"
+#include "WordStore.h"
+#include "CSVTokenizer.h"
+
+
+// reads from a csv file. Used to obtain random words for the Playfield
+// the whole file is read once in the constructor and the values are stored in a WordStore (see WordStore.h), so a value can be accessed by its index without searching the file.
+// small files are stored in an offset table in the order of the file. huge files (word lists with millions of values) are sorted, deduplicated and stored front coded.
+// in the same pass the values are sorted into the buckets of a WordIndex (length, letter set, difficulty tier), see get_word_index()
+// the file is split into values by the CSVTokenizer (RFC 4180 with quoted values). either every value of the file is used or only the values of one column
+class CSVParser
+{
+public:
+	enum word_store_types	// how the values are stored in memory
+	{
+		AUTO_STORE = 0,			// offset table for files smaller than FRONT_CODING_MIN_FILE_SIZE, front coded otherwise
+		OFFSET_TABLE_STORE,		// see OffsetTableStore
+		FRONT_CODED_STORE		// see FrontCodedStore
+	};
+
+	enum store_limits
+	{
+		FRONT_CODING_MIN_FILE_SIZE = 64 * 1024 * 1024	// in bytes. from this file size on the AUTO_STORE is front coded
+	};
+
+	char delimiter;				// delimiter which separates the values in the file
+	int column;					// index of the column with the words or CSVTokenizer::ALL_COLUMNS
+	unsigned int num_elem;		// number of Elements in the opened file
+
+	CSVParser(const std::string& csv_filename = "", char csv_delimiter = ';', int csv_column = CSVTokenizer::ALL_COLUMNS, int store_type = AUTO_STORE);
+
+	std::string get_elem(unsigned int index) const;
+	void get_elem(unsigned int index, std::string& value) const;
+	std::string get_random_elem() const;
+	int find_elem(const std::string& value) const;
+	const std::string& get_error_msg() const;
+	size_t get_memory_size() const;
+	const WordIndex& get_word_index() const;
+
+	static unsigned int random_index(unsigned int num);
+
+private:
+	std::string filename;						// path of the opened file
+	std::string error_msg;						// description of the first error in the file. empty if there was no error
+	std::shared_ptr<const WordStore> word_store;	// all values of the file. shared by the copies of the CSVParser, because it is not changed after the file is read
+	WordIndex word_index;						// the values sorted by length, letter set and difficulty tier
+
+	static void sort_values(std::vector<std::string_view>& values);
+};
+
+#endif // _CSVPARSER_HPP_
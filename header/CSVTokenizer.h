@@ -0,0 +1,41 @@
+#ifndef _CSVTOKENIZER_HPP_
+#define _CSVTOKENIZER_HPP_
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+
+// splits the content of a csv file into fields (RFC 4180).
+// - fields are separated by the delimiter, records by "\n", "\r\n" or "\r"
+// - a field that starts with a quotation mark is quoted: it can contain delimiters, line ends and quotation marks (written as two quotation marks "")
+// - a UTF-8 byte order mark at the start of the content is skipped
+// the content is scanned in blocks of 64 bytes. a bit mask with the positions of all delimiters, quotation marks and line ends of the block is created
+// (with SSE2 if available), so only these positions are processed one by one. the bytes in between are skipped.
+// quoted fields are unescaped in place (the quotation marks are removed), so the content buffer is changed and the fields point into it.
+// malformed content (quotation mark in an unquoted field, characters after the closing quotation mark, missing closing quotation mark) is read anyway,
+// but the first error is stored (see get_error_msg())
+class CSVTokenizer
+{
+public:
+	enum column_select
+	{
+		ALL_COLUMNS = -1	// every field of every record is returned
+	};
+
+	CSVTokenizer(char csv_delimiter = ';', int csv_column = ALL_COLUMNS);
+
+	int tokenize(char* data, size_t size, std::vector<std::string_view>& fields);
+	const std::string& get_error_msg() const;
+
+private:
+	char delimiter;				// delimiter which separates the fields of a record
+	int column;					// index of the column whose fields are returned (first column: 0) or ALL_COLUMNS
+	std::string error_msg;		// description of the first error in the content of the last tokenize(). empty if there was no error
+
+	static unsigned long long get_special_chars(const char* data, size_t size, char delimiter);
+	size_t unescape_field(char* field, size_t length, size_t line);
+	void set_error(const std::string& msg, size_t line);
+};
+
+#endif // _CSVTOKENIZER_HPP_
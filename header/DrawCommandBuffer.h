@@ -0,0 +1,87 @@
+#ifndef _DRAWCOMMANDBUFFER_HPP_
+#define _DRAWCOMMANDBUFFER_HPP_
+
+#include <vector>
+#include "SFML/Graphics.hpp"
+
+class RenderLayer;
+class RenderBackend;
+class Entity;
+
+
+// records the draw calls of one frame, so they can be replayed on a render target later and by another thread (see RenderThread.h).
+// draw_on_window() of every Entity records its draw calls into a command buffer instead of drawing on the window directly. the draw() methods have the same interface as sf::RenderTarget.
+// every drawn object is copied into the buffer, so the entities can change (e.g. the words are moved by the physics thread) while the buffer is replayed.
+// the copies are stored in a pool for every type of drawable, which is reused by the next frame. after the first frames, recording doesn't allocate memory anymore.
+// a text is copied with its glyph geometry, which is built by the recording thread. the replaying thread still reads the glyphs and binds the glyph texture of the font,
+// so the recording thread must not render new glyphs while a buffer is replayed: the fonts are warmed before they are used and new characters are rendered with FontManager::warm_string() (see FontManager.h).
+// the fonts, textures and RenderLayers used by the commands must exist until the buffer is replayed.
+// every command stores the type of the Entity that recorded it (see draw_entity()), so a CountingRenderBackend can show the draw calls of every Entity type.
+class DrawCommandBuffer
+{
+public:
+	enum command_type
+	{
+		CLEAR = 0,		// clear the target with a color
+		TEXT,			// draw a glyph run (sf::Text, e.g. a Word)
+		RECTANGLE,		// draw an sf::RectangleShape (e.g. a health bar or a Button)
+		CIRCLE,			// draw an sf::CircleShape
+		SPRITE,			// draw an sf::Sprite
+		VERTICES,		// draw a range of vertices (e.g. the ProfilerOverlay)
+		LAYER_BEGIN,	// the following commands are drawn on the render texture of a RenderLayer
+		LAYER_END,		// the following commands are drawn on the target again
+		LAYER_DRAW,		// draw the cached content of a RenderLayer
+		NUM_COMMAND_TYPES
+	};
+
+	DrawCommandBuffer(const sf::Vector2u& target_size = sf::Vector2u(0, 0), const sf::Window* mouse_window = NULL);
+
+	void reset();
+	void clear(const sf::Color& color = sf::Color::Black);
+	void draw(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+	void draw(const sf::RectangleShape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+	void draw(const sf::CircleShape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+	void draw(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+	void draw(const sf::Vertex* vertices, size_t num_vertices, sf::PrimitiveType type, const sf::RenderStates& states = sf::RenderStates::Default);
+	void begin_layer(RenderLayer& layer);
+	void end_layer(RenderLayer& layer);
+	void draw_layer(RenderLayer& layer);
+	void draw_entity(Entity& entity);
+	sf::Vector2u getSize() const;
+	const sf::Window* get_window() const;
+	unsigned int get_num_commands() const;
+	void replay(RenderBackend& backend) const;
+
+private:
+	typedef struct draw_command
+	{
+		command_type type;
+		unsigned int index;				// index of the drawable in the pool of its type. for VERTICES: index of the first vertex
+		unsigned int num_vertices;		// only for VERTICES
+		sf::PrimitiveType primitive;	// only for VERTICES
+		sf::Color color;				// only for CLEAR
+		RenderLayer* layer;				// only for the LAYER commands
+		const char* owner;				// name of the Entity type that recorded the command. NULL outside of an Entity
+		sf::RenderStates states;
+	} draw_command_t;
+
+	sf::Vector2u size;					// size of the target that the buffer is replayed on
+	const sf::Window* window;			// window that the buffer is replayed on. used for the mouse position (see Button::update_hover()). NULL for offscreen targets
+	const char* owner;					// name of the Entity type that is recorded at the moment (see draw_entity())
+	std::vector<draw_command_t> commands;	// commands of the frame in the order they were recorded
+	// pools of the copied drawables. only the first num_* Elements are used by the current frame, the others are kept for the next frames
+	std::vector<sf::Text> texts;
+	std::vector<sf::RectangleShape> rectangles;
+	std::vector<sf::CircleShape> circles;
+	std::vector<sf::Sprite> sprites;
+	unsigned int num_texts;
+	unsigned int num_rectangles;
+	unsigned int num_circles;
+	unsigned int num_sprites;
+	std::vector<sf::Vertex> vertices;	// vertices of all VERTICES commands. cleared every frame, the capacity is kept
+
+	draw_command_t& add_command(command_type type, unsigned int index, const sf::RenderStates& states);
+	template <typename T> unsigned int add_to_pool(std::vector<T>& pool, unsigned int& num_used, const T& drawable);
+};
+
+#endif // _DRAWCOMMANDBUFFER_HPP_
@@ -0,0 +1,56 @@
+#ifndef _FONTMANAGER_HPP_
+#define _FONTMANAGER_HPP_
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Entity.h"
+#include "ResourceManager.h"
+
+
+// loads all fonts of the game once (with the ResourceManager) and keeps them in memory, so a font change is only a switch to another font object (no disk access).
+// the glyphs of all printable ASCII characters are rendered into the glyph texture of every font at the character sizes used by the game (see warm_sizes in FontManager.cpp),
+// so there is no glyph upload when a text is drawn the first time (e.g. on the first frame of a round).
+// the fonts are loaded by the AssetLoader of the GameSettings: first the font of the settings, the other fonts after the assets of the Playfield.
+// get_font() waits if the requested font is not loaded yet.
+// if the AssetLoader fails before all fonts are loaded, it calls cancel_pending(), so get_font() doesn't wait forever for a font that is never loaded
+// the RenderThread draws with the glyph textures of the fonts while the main thread records the next frame, so a glyph that is not rendered yet must not be loaded by the main thread at the same time.
+// glyphs that are not warmed when the font is loaded (e.g. non-ASCII characters of a word list or of a status message) are rendered with warm_string() or warm_text(), which lock glyph_mutex.
+// the render thread holds glyph_mutex while it replays a frame. afterwards the glyphs are in the cache and the main thread only reads them, which needs no lock
+class FontManager
+{
+public:
+	FontManager();
+
+	void init(ResourceManager& resource_manager, const std::vector<std::string>& font_filenames);
+	void load_font(unsigned int font_id);
+	void load_remaining();
+	void cancel_pending();
+	const sf::Font& get_font(unsigned int font_id);
+	bool is_loaded(unsigned int font_id);
+	const std::string& get_filename(unsigned int font_id);
+	static void warm_string(const sf::Font& font, const sf::String& string, unsigned int char_size, bool bold);
+	static void warm_text(const sf::Text& text);
+
+	static std::mutex glyph_mutex;			// locked while glyphs are added to a font that is in use and while the render thread draws a frame
+private:
+	enum font_states
+	{
+		FONT_PENDING = 0,	// not loaded yet
+		FONT_LOADED,
+		FONT_FAILED			// the file can't be loaded
+	};
+
+	ResourceManager* resources;				// loads the font files
+	std::vector<std::shared_ptr<const sf::Font> > fonts;	// one font per font id. the vector is not resized after init()
+	std::vector<std::string> filenames;		// path of every font
+	std::vector<int> states;				// state of every font (see font_states). protected by state_mutex
+	std::mutex state_mutex;
+	std::condition_variable state_cv;		// signals a waiting get_font() that a font is loaded
+
+	int wait_for_font(unsigned int font_id);
+	static void warm_glyphs(const sf::Font& font);
+};
+
+#endif // _FONTMANAGER_HPP_
@@ -0,0 +1,115 @@
+#ifndef _FRAMECAPTURE_HPP_
+#define _FRAMECAPTURE_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SFML/Graphics.hpp"
+
+
+// records the frames of the game for QA and bug reports, as a PNG sequence or as an uncompressed Y4M video.
+// the frames are captured by the thread that draws them (the RenderThread for the window, the stress test for its offscreen texture) and read directly into a ring of preallocated frame buffers.
+// encoder threads in the background compress and write the buffered frames, so the drawing thread never waits for the compression or the disk.
+// if all buffers are in use, because the encoders fall behind, the new frame is dropped. the dropped frames are counted and printed by get_report().
+// the frames are captured with a fixed frame rate (see capture_config_t). every frame gets the number of its time slot since the start of the capture:
+//   PNG sequence: the files are numbered by the time slot, so dropped frames are visible as gaps in the numbering (<path>_000000.png, <path>_000001.png, ...)
+//   Y4M:          the video must contain every time slot, so gaps (dropped frames or no drawn frames in the idle mode) are filled with the frame before.
+//                 the frames must be written in order, so Y4M uses only one encoder thread
+// the pixels are read with glReadPixels() from the framebuffer of the render target into the buffer (sf::Texture::copyToImage() would allocate a new sf::Image for every frame and copy it twice).
+// glReadPixels() is core OpenGL (also OpenGL ES), so the capture also works with a software renderer (e.g. Mesa llvmpipe without a GPU).
+// OpenGL returns the rows bottom-up, so the buffers are stored bottom-up and the encoders flip the rows. the time of the readback is measured and printed by get_report()
+class FrameCapture
+{
+public:
+	enum capture_formats
+	{
+		PNG_SEQUENCE = 0,
+		Y4M
+	};
+
+	enum capture_limits
+	{
+		DEFAULT_CAPTURE_FPS = 30,	// in frames per second
+		MIN_CAPTURE_FPS = 1,
+		MAX_CAPTURE_FPS = 240,
+		RING_SIZE = 8,				// number of preallocated frame buffers
+		MAX_PNG_ENCODERS = 4		// maximum number of encoder threads of the PNG format
+	};
+
+	// configuration of the capture. Can be set with command line arguments (see parse_args())
+	typedef struct capture_config
+	{
+		std::string path;			// path of the Y4M file (*.y4m) or prefix of the PNG files. empty if nothing is captured
+		int format;					// see capture_formats. derived from the path
+		unsigned int fps;			// frame rate of the capture
+	} capture_config_t;
+
+	FrameCapture();
+	~FrameCapture();
+
+	int start(const capture_config_t& capture_config, unsigned int width, unsigned int height);
+	void stop();
+	bool is_running();
+	void capture_window(sf::RenderWindow& window);
+	void capture_texture(sf::RenderTexture& texture);
+	std::string get_report();
+	static int parse_args(int argc, char* argv[], capture_config_t& capture_config);
+	static bool is_capture_arg(const std::string& arg);
+
+private:
+	enum slot_states
+	{
+		FREE = 0,		// can be filled with a new frame
+		FILLING,		// the capturing thread copies a frame into the buffer
+		QUEUED,			// waits for an encoder
+		ENCODING		// an encoder writes the frame
+	};
+
+	typedef struct frame_slot
+	{
+		std::vector<sf::Uint8> pixels;		// RGBA pixels of the frame. the rows are stored bottom-up (like OpenGL returns them). allocated by start()
+		unsigned long long frame_number;	// time slot of the frame since the start of the capture
+		int state;							// see slot_states
+	} frame_slot_t;
+
+	capture_config_t config;
+	unsigned int frame_width;
+	unsigned int frame_height;
+	unsigned int num_encoders;			// number of encoder threads
+	bool running;						// true between start() and stop()
+
+	// only used by the capturing thread
+	sf::Time capture_start;				// time of the first captured frame (see GameClock::now())
+	bool has_capture_start;
+	unsigned long long next_frame_number;	// first time slot that is not captured yet
+
+	std::mutex ring_mutex;				// protects all members below (except the pixels of the slots, which are only used by the thread in the state of the slot)
+	std::condition_variable ring_cv;	// signals the encoders that a frame was queued or that they shall terminate
+	std::vector<frame_slot_t> ring;		// the preallocated frame buffers
+	std::deque<unsigned int> queue;		// indexes of the queued slots in the order of the capture
+	bool stop_requested;				// signals the encoders to terminate after the queue is empty
+	unsigned long long captured_frames;	// frames that were copied into a buffer
+	unsigned long long dropped_frames;	// frames that were not captured, because all buffers were in use
+	unsigned long long encoded_frames;	// frames that were written
+	unsigned long long failed_frames;	// frames that could not be written
+	unsigned long long repeated_frames;	// frames that were repeated to fill gaps in the Y4M video
+	sf::Time readback_time;				// time the capturing thread needed to read the captured frames
+	size_t max_queue_length;			// longest queue since start()
+	std::ofstream y4m_file;				// only used by the encoder thread of the Y4M format
+	std::vector<std::thread> encoder_threads;
+
+	bool is_capture_due(unsigned long long& frame_number);
+	int acquire_slot();
+	void capture_target(sf::RenderTarget& target);
+	void fill_slot(int slot, unsigned long long frame_number, sf::RenderTarget& target);
+	void encoder_task();
+	bool encode_png(const frame_slot_t& slot, sf::Image& image);
+	bool encode_y4m(const frame_slot_t& slot, std::vector<sf::Uint8>& yuv, unsigned long long& last_frame_number, unsigned long long& num_repeated);
+	void convert_to_yuv(const std::vector<sf::Uint8>& pixels, std::vector<sf::Uint8>& yuv);
+};
+
+#endif // _FRAMECAPTURE_HPP_
@@ -0,0 +1,83 @@
+#ifndef _FRAMEPACER_HPP_
+#define _FRAMEPACER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include "Entity.h"
+
+
+// paces the frames of the main loop. Modes:
+//   VSYNC:    display() waits for the vertical sync of the monitor. if the frame rate shows that V-Sync has no effect (e.g. disabled by the driver), the pacer falls back to FPS_CAP
+//   FPS_CAP:  the frames are limited to a fixed frame rate. wait_frame() sleeps until shortly before the start of the next frame and spins the rest of the time,
+//             because a sleep can take up to a few milliseconds longer than requested
+//   UNCAPPED: no waiting at all. used to measure the maximum frame rate (e.g. for render benchmarks)
+// the achieved frame rate and the pacing error (root mean square deviation of the frame times from the target frame time) are measured over every second and over the whole run.
+// in VSYNC and UNCAPPED mode the target frame time is the average frame time, so the pacing error is the jitter of the frames
+// the pacer is used by the thread that displays the frames (see RenderThread.h). get_mode(), get_fps_cap(), get_frame_rate() and get_pacing_error() can be called from any thread
+class FramePacer
+{
+public:
+	enum pacing_modes
+	{
+		VSYNC = 0,
+		FPS_CAP,
+		UNCAPPED,
+		NUM_PACING_MODES
+	};
+
+	enum fps_cap_range	// minimum, maximum and default frame rate of the FPS_CAP mode. in frames per second
+	{
+		MIN_FPS_CAP = 10,
+		MAX_FPS_CAP = 1000,
+		DEFAULT_FPS_CAP = 60
+	};
+
+	FramePacer(sf::Window* pacing_window = NULL);
+
+	void set_mode(int pacing_mode, unsigned int cap);
+	int get_mode();
+	unsigned int get_fps_cap();
+	void wait_frame();
+	void skip_frame();
+	float get_frame_rate();
+	float get_pacing_error();
+	std::string get_report();
+	static std::string get_mode_name(int pacing_mode, unsigned int cap);
+	static int parse_args(int argc, char* argv[], int& pacing_mode, unsigned int& cap);
+
+private:
+	typedef std::chrono::steady_clock pacing_clock;
+
+	enum pacing_timing
+	{
+		SPIN_TIME_US = 2000,			// the last part of the wait is spun instead of slept. in microseconds
+		STATS_INTERVAL_MS = 1000,		// the frame rate and the pacing error are updated every interval. in milliseconds
+		VSYNC_MAX_FPS = 500				// V-Sync counts as not effective, if the frame rate is higher than this
+	};
+
+	typedef struct frame_stats		// sums of the frame times of several frames. the frame times are in seconds
+	{
+		unsigned long long frames;
+		double sum;
+		double sum_squares;
+	} frame_stats_t;
+
+	sf::Window* window;					// the V-Sync of this window is enabled in VSYNC mode. NULL if there is no window
+	std::atomic<int> mode;				// current mode (see pacing_modes)
+	std::atomic<unsigned int> fps_cap;	// frame rate of the FPS_CAP mode
+	pacing_clock::time_point next_frame;	// start of the next frame in FPS_CAP mode
+	pacing_clock::time_point last_frame;	// end of the last wait_frame()
+	bool has_last_frame;				// false after set_mode() or skip_frame(). the time to the next frame is not measured then
+	frame_stats_t interval_stats;		// frames of the current interval
+	frame_stats_t total_stats;			// all frames since the mode was set
+	pacing_clock::time_point interval_start;
+	std::atomic<float> frame_rate;		// frame rate of the last complete interval. in frames per second
+	std::atomic<float> pacing_error;	// pacing error of the last complete interval. in milliseconds
+
+	double get_target_frame_time(const frame_stats_t& stats);
+	double get_pacing_error(const frame_stats_t& stats);
+	void add_frame_time(double frame_time);
+};
+
+#endif // _FRAMEPACER_HPP_
@@ -0,0 +1,113 @@
+#ifndef _FRAMEPROFILER_HPP_
+#define _FRAMEPROFILER_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "Entity.h"
+#include "FramePacer.h"
+
+
+// Collects the durations of the stages of every frame (main thread and render thread) and of every physics tick (physics thread).
+// Every metric has a ring buffer of the last samples. A ring buffer is only written by one thread and can be read by any other thread without locking.
+// Collecting a sample only costs a few atomic stores, so the samples are always collected, also if the overlay is not shown.
+class FrameProfiler
+{
+public:
+	enum metric_id		// defines an ID for every measured stage
+	{
+		EVENT_POLL = 0,		// main thread. processing of the window events
+		UPDATE,				// main thread. update() of all entities
+		DRAW,				// main thread. draw_on_window() of all entities (records the draw commands of the frame)
+		PARTICLE_DRAW,		// main thread. building the vertices of the particle effects (part of DRAW)
+		RENDER_WAIT,		// main thread. waiting for the render thread to finish the previous frame
+		MUTEX_WAIT_MAIN,	// main thread. time waiting on mutex_glob in one frame
+		FRAME,				// main thread. duration of the whole frame
+		RENDER,				// render thread. replay of the draw commands on the window
+		DISPLAY,			// render thread. display() of the window (waits for V-Sync)
+		PHYSICS_TICK,		// physics thread. update_physics() of all entities (without the sleep time)
+		PARTICLE_UPDATE,	// physics thread. moving the particles of the particle effects (part of PHYSICS_TICK)
+		MUTEX_WAIT_PHYSICS,	// physics thread. time waiting on mutex_glob in one physics tick
+		NUM_METRICS
+	};
+
+	enum num_samples
+	{
+		NUM_SAMPLES = 256	// number of samples that are stored for every metric
+	};
+
+	FrameProfiler();
+
+	void add_sample(metric_id metric, sf::Time duration);
+	void accumulate(metric_id metric, sf::Time duration);
+	void flush_accumulator(metric_id metric);
+	void lock(std::mutex& mtx, metric_id wait_metric);
+	unsigned int copy_samples(metric_id metric, float* samples_out);
+	static const char* get_metric_name(metric_id metric);
+
+private:
+	struct sample_ring	// lock-free ring buffer with a single writer
+	{
+		std::atomic<float> samples[NUM_SAMPLES];	// in milliseconds
+		std::atomic<unsigned int> num_written;		// number of samples written so far. the next sample is written at the index num_written % NUM_SAMPLES
+		float accumulator;							// sum of durations that become one sample. only used by the thread that writes the metric. in milliseconds
+	} rings[NUM_METRICS];
+};
+
+extern FrameProfiler frame_profiler;	// defined in FrameProfiler.cpp. collects the samples of the game
+
+
+// The ProfilerOverlay inherits from Entity
+// shows the statistics (last, minimum, average, 99th percentile) of every metric of the FrameProfiler and a graph of the frame times.
+// toggled with the F3 key. All text and shapes of the overlay are put in one vertex array, that is drawn with a single draw call.
+// The memory for the vertices is allocated once, so there is no allocation while the overlay is shown.
+class ProfilerOverlay : public Entity
+{
+public:
+	ProfilerOverlay();
+	virtual ~ProfilerOverlay();
+
+	bool load_font(const std::string& font_filename);
+	bool is_visible();
+	void set_frame_pacer(FramePacer* pacer);
+
+	virtual void update();
+	virtual void update_physics();
+	virtual void draw_on_window(DrawCommandBuffer& target);
+	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
+	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
+	virtual bool is_animating();
+	virtual const char* get_entity_name();
+
+private:
+	typedef struct metric_stats
+	{
+		float last, min, avg, p99;	// in milliseconds
+	} metric_stats_t;
+
+	enum layout		// layout of the overlay. in pixels
+	{
+		CHAR_SIZE = 14,
+		MARGIN = 8,
+		GRAPH_HEIGHT = 60,
+		MAX_VERTICES = 8192
+	};
+
+	bool visible;									// if the overlay is shown
+	bool font_loaded;								// the overlay can only be drawn if its font is loaded
+	FramePacer* frame_pacer;						// the frame rate and pacing error of the pacer are shown below the table. NULL if not set
+	sf::Font font;									// monospace font, so the columns of the table are aligned
+	metric_stats_t stats[FrameProfiler::NUM_METRICS];	// statistics of every metric. calculated in update()
+	float samples[FrameProfiler::NUM_SAMPLES];		// copy of the samples of one metric
+	float sorted_samples[FrameProfiler::NUM_SAMPLES];	// copy of the samples that gets partially sorted to get the percentile
+	unsigned int num_frame_samples;					// number of valid samples of the frame time (for the graph)
+	float frame_samples[FrameProfiler::NUM_SAMPLES];	// frame times for the graph. oldest sample first
+	char text_buffer[1024];							// formatted text of the overlay
+	std::vector<sf::Vertex> vertices;				// quads of the overlay. allocated once with MAX_VERTICES
+	unsigned int num_vertices;						// number of used vertices
+
+	void add_quad(const sf::FloatRect& rect, const sf::FloatRect& tex_rect, const sf::Color& color);
+	void add_text(const char* text, sf::Vector2f position, const sf::Color& color);
+};
+
+#endif // _FRAMEPROFILER_HPP_
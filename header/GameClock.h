@@ -0,0 +1,32 @@
+#ifndef _GAMECLOCK_HPP_
+#define _GAMECLOCK_HPP_
+
+#include <atomic>
+#include "SFML/System.hpp"
+
+
+// Clock that is used by the game logic instead of sf::Clock. Works like sf::Clock, but the time source can be switched.
+// In the normal game the real time is used. In the headless simulation the simulated time is used, which only advances when advance_simulated_time() is called.
+// So the game logic can run faster than real time with fixed and reproducible time steps.
+// The time source must be selected before the first GameClock object is created.
+class GameClock
+{
+public:
+	GameClock();
+
+	sf::Time getElapsedTime() const;
+	sf::Time restart();
+
+	static void set_simulated(bool enable);
+	static bool is_simulated();
+	static void advance_simulated_time(sf::Time delta);
+	static sf::Time now();
+
+private:
+	sf::Time start_time;	// time of the time source when the clock was started
+
+	static std::atomic<bool> simulated;					// true if the simulated time is used as time source
+	static std::atomic<sf::Int64> simulated_time_us;	// current simulated time. in microseconds
+};
+
+#endif // _GAMECLOCK_HPP_
@@ -1,108 +1,216 @@
-#ifndef _GAMESETTINGS_HPP_
-#define _GAMESETTINGS_HPP_
-
-#include <fstream>
-#include "Entity.h"
-
-
-// reads and writes the game settings in a .bin file. Options and Hi-Score are saved in the file. uses a checksum to validate the integrity of the data.
-// its also possible to play without a settings file (because it can't be created for some reason). But then no settings or Hi-Scores are saved.
-class SettingsFileParser
-{
-public:
-	typedef enum f_state
-	{
-		GOOD,
-		CREATE_NEW,
-		CREATE_NEW_FAIL
-	} f_state_t;
-	f_state_t file_state;
-
-	enum p_bound	// enum to select the playfield boundary
-	{
-		RECT = 0,
-		CIRC,
-		NUM_BOUNDS
-	};
-
-	enum fonts		// enum to select the available fonts
-	{
-		ARIAL = 0,
-		TIMES,
-		CONSOLAS,
-		OLDENGL,
-		NUM_FONTS
-	};
-
-	enum num_words_range	// minimum and maximum amount of words on the playfield
-	{
-		MIN_NUM_WORDS = 1,
-		MAX_NUM_WORDS = 10
-	};
-
-	SettingsFileParser(const std::string& settings_filename);
-
-	int calculate_checksum();
-	void init_file_content();
-	void updateChecksum();
-	int check_settings_file();
-	void create_settings_file();
-	unsigned int getHiScore();
-	void setSaveHiScore(unsigned int score);
-	void setBoundaryID(int boundary);
-	void saveBoundaryID();
-	int getBoundaryID(std::string* bound_descr = NULL);
-	void setFontID(int font_identifier);
-	void saveFontID();
-	int getFontID(std::string* font_name = NULL);
-	void setNumWordsSpawn(unsigned int max_n_words);
-	void saveNumWordsSpawn();
-	unsigned int getNumWordsSpawn();
-
-private:
-	std::fstream fp;			// File pointer. Open file for reading and writing
-	std::string filename;	// path of the opened file
-
-	struct filecontent	// every information that is saved in the file (the Order of the Elements of the struct is the same as they are written in the file)
-	{
-		unsigned int hi_score;
-		char boundary_id;
-		char font_id;
-		unsigned int num_words_spawn;
-		int checksum;
-	} file_content;
-
-	unsigned int expected_file_length;	// size of the file (and the sum of the Elements in struct filecontent). in bytes
-};
-
-
-// contains different information used by other classes. inherits from SettingsFileParser.
-// most of the members can be set and get.
-// every class that needs access to the members should store a pointer to the same GameSettings object, so the same information is shared across every class.
-class GameSettings : public SettingsFileParser
-{
-public:
-	typedef enum g_state	// current state of the game. The game state gives information about which objects shall be created and displayed on the screen.
-	{
-		START_SCREEN,
-		OPTIONS_SCREEN,
-		PLAY_SCREEN,
-		EXIT
-	} game_state_t;
-	game_state_t game_state;
-
-	std::string wordlist_csv_filename;	// path to the .csv file that contains the word list. used to supply the information to the CSVParser class
-	char csv_delimiter;				// delimiter for the csv file
-
-	GameSettings();
-
-	const sf::Font& getFont();
-	void setFont(int font_identifier);
-	sf::Vector2f& get_window_size();
-
-private:
-	sf::Font font;					// font which is used by every text object of this program
-	sf::Vector2f window_size;		// window size of the game
-};
-
-#endif // _GAMESETTINGS_HPP_
+#ifndef _GAMESETTINGS_HPP_
+#define _GAMESETTINGS_HPP_
+
+#include <atomic>
+#include <fstream>
+#include <vector>
+#include "Entity.h"
+#include "PersistenceWorker.h"
+#include "ScoreHistory.h"
+#include "KeystrokeRecorder.h"
+#include "WordListWatcher.h"
+#include "ResourceManager.h"
+#include "FontManager.h"
+#include "AssetLoader.h"
+#include "FramePacer.h"
+
+
+// reads and writes the game settings in a .bin file. Options and Hi-Score are saved in the file. uses a CRC32 checksum to validate the integrity of the data.
+// File format (all numbers little endian):
+//   magic "TGSF" (4 bytes) | format version (2 bytes) | records ... | CRC32 of everything before (4 bytes)
+//   record: tag (2 bytes) | length of the value (2 bytes) | value (length bytes)
+// Every setting is one record (see settings_tag). Records with an unknown tag (written by a newer version) are skipped when reading and written back unchanged,
+// so a new setting can be added without invalidating the files of older versions. A record with an invalid value only resets this setting to its default.
+// Files of older versions (fixed layout without tags, see check_legacy_settings_file()) are converted to the current format when they are loaded.
+// The whole file is read with one read and written with one write. A save writes a temporary file first and replaces the settings file by renaming the temporary file,
+// so a crash during a save leaves either the old or the new settings file, but never a torn file.
+// The saves are written by a PersistenceWorker in the background, so the game thread doesn't wait for the disk. Pending saves are written when the object is destroyed.
+// its also possible to play without a settings file (because it can't be created for some reason). But then no settings or Hi-Scores are saved.
+class SettingsFileParser
+{
+public:
+	typedef enum f_state
+	{
+		GOOD,
+		CREATE_NEW,
+		CREATE_NEW_FAIL,
+		MIGRATED		// the file had the format of an older version and was converted
+	} f_state_t;
+	f_state_t file_state;
+
+	enum p_bound	// enum to select the playfield boundary
+	{
+		RECT = 0,
+		CIRC,
+		NUM_BOUNDS
+	};
+
+	enum fonts		// enum to select the available fonts
+	{
+		ARIAL = 0,
+		TIMES,
+		CONSOLAS,
+		OLDENGL,
+		NUM_FONTS
+	};
+
+	enum num_words_range	// minimum and maximum amount of words on the playfield
+	{
+		MIN_NUM_WORDS = 1,
+		MAX_NUM_WORDS = 10
+	};
+
+	enum word_modes		// enum to select how the words on the playfield are chosen from the word list
+	{
+		RANDOM_WORDS = 0,	// every word has the same probability
+		ADAPTIVE_WORDS,		// words with the letters that the player often types wrong are chosen more often. the word length follows the skill of the player (see WordSampler)
+		RAMP_WORDS,			// short and easy words at the start of a playthrough, long and hard words at the end (see WordIndex)
+		NUM_WORD_MODES
+	};
+
+	enum physics_tick_rate_range	// minimum, maximum and default rate of the physics thread. in ticks per second
+	{
+		MIN_PHYSICS_TICK_RATE = 25,
+		MAX_PHYSICS_TICK_RATE = 500,
+		DEFAULT_PHYSICS_TICK_RATE = 100
+	};
+
+	SettingsFileParser(const std::string& settings_filename);
+
+	void set_read_only(bool enable);
+	void set_max_num_words(unsigned int max_n_words);
+	static sf::Uint32 calculate_crc32(const char* data, size_t size);
+	void init_file_content();
+	int check_settings_file();
+	int check_legacy_settings_file(const std::vector<char>& buffer);
+	void create_settings_file();
+	void save_settings_file();
+	void flush_saves();
+	bool has_save_failed();
+	unsigned int getHiScore();
+	void setSaveHiScore(unsigned int score);
+	void setBoundaryID(int boundary);
+	void saveBoundaryID();
+	int getBoundaryID(std::string* bound_descr = NULL);
+	void setFontID(int font_identifier);
+	void saveFontID();
+	int getFontID(std::string* font_name = NULL);
+	static std::string get_font_name(int font_identifier);
+	void setNumWordsSpawn(unsigned int max_n_words);
+	void saveNumWordsSpawn();
+	unsigned int getNumWordsSpawn();
+	void setPhysicsTickRate(unsigned int tick_rate);
+	void savePhysicsTickRate();
+	unsigned int getPhysicsTickRate();
+	void setWordMode(int mode);
+	void saveWordMode();
+	int getWordMode(std::string* mode_descr = NULL);
+	void setFramePacing(int pacing_mode, unsigned int fps_cap);
+	void saveFramePacing();
+	int getFramePacing(std::string* pacing_descr = NULL);
+	unsigned int getFpsCap();
+
+protected:
+	PersistenceWorker persistence;	// writes the settings file (and the score history of GameSettings) in the background
+
+private:
+	std::string filename;	// path of the settings file
+	bool read_only;			// if true, changed settings are not saved to the file
+	unsigned int max_num_words;	// upper limit for setNumWordsSpawn(). MAX_NUM_WORDS unless raised by the stress test
+
+	struct filecontent	// every setting that is saved in the file. every Element is saved in its own record
+	{
+		unsigned int hi_score;
+		char boundary_id;
+		char font_id;
+		unsigned int num_words_spawn;
+		std::atomic<unsigned short> physics_tick_rate;	// in ticks per second. atomic, because the physics thread reads it on every tick while the Option Screen can change it
+		char word_mode;
+		char frame_pacing;			// see FramePacer::pacing_modes
+		unsigned short fps_cap;		// frame rate of the FPS_CAP mode. in frames per second
+	} file_content;
+
+	std::vector<char> unknown_records;	// records of the file with a tag that this version doesn't know. they are written back unchanged
+
+	enum settings_tag	// tag of every record in the file. the numbers must never change, new tags must get a new number
+	{
+		TAG_HI_SCORE = 1,
+		TAG_BOUNDARY_ID = 2,
+		TAG_FONT_ID = 3,
+		TAG_NUM_WORDS_SPAWN = 4,
+		TAG_PHYSICS_TICK_RATE = 5,
+		TAG_WORD_MODE = 6,
+		TAG_FRAME_PACING = 7,
+		TAG_FPS_CAP = 8
+	};
+
+	enum file_format	// version and sizes (in bytes) of the file format
+	{
+		FORMAT_VERSION = 2,			// version 1 is the fixed layout of older versions
+		HEADER_LENGTH = 6,			// magic and format version
+		RECORD_HEADER_LENGTH = 4,	// tag and length
+		CHECKSUM_LENGTH = 4,
+		LEGACY_FILE_LENGTH = 14,	// size of a version 1 file
+		MAX_FILE_LENGTH = 65536		// bigger files are not read
+	};
+
+	void read_record(unsigned int tag, const char* value, unsigned int length);
+	void serialize_file_content(std::vector<char>& buffer);
+};
+
+
+// contains different information used by other classes. inherits from SettingsFileParser.
+// most of the members can be set and get.
+// every class that needs access to the members should store a pointer to the same GameSettings object, so the same information is shared across every class.
+class GameSettings : public SettingsFileParser
+{
+public:
+	typedef enum g_state	// current state of the game. The game state gives information about which objects shall be created and displayed on the screen.
+	{
+		SPLASH_SCREEN,		// shown while the first font is loaded
+		START_SCREEN,
+		OPTIONS_SCREEN,
+		STATS_SCREEN,
+		PLAY_SCREEN,
+		EXIT
+	} game_state_t;
+	game_state_t game_state;
+
+	enum load_phases	// phases of the AssetLoader in the order they are loaded
+	{
+		FONT_PHASE = 0,		// the font of the settings. needed by every screen except the Splash Screen
+		TEXTURE_PHASE,		// textures of the Playfield
+		WORD_LIST_PHASE,	// word list of the Playfield
+		ALL_FONTS_PHASE,	// the other fonts. only needed when the font is changed
+		NUM_LOAD_PHASES
+	};
+
+	std::string wordlist_csv_filename;	// path to the .csv file that contains the word list. used to supply the information to the CSVParser class
+	char csv_delimiter;				// delimiter for the csv file
+	int csv_column;					// column of the csv file with the words (first column: 0). -1 (CSVTokenizer::ALL_COLUMNS): every value of the file is a word
+
+	GameSettings();
+
+	void set_read_only(bool enable);
+	ScoreHistory& get_score_history();
+	KeystrokeRecorder& get_keystroke_recorder();
+	WordListWatcher& get_word_list_watcher();
+	ResourceManager& get_resources();
+	AssetLoader& get_asset_loader();
+	bool is_playable();
+	void wait_until_playable();
+	const sf::Font& getFont();
+	void setFont(int font_identifier);
+	sf::Vector2f& get_window_size();
+
+private:
+	ResourceManager resources;		// textures and fonts of the game. must be declared before the font_manager, which uses it
+	FontManager font_manager;		// all fonts of the game. the font of the settings is used by every text object of this program
+	sf::Vector2f window_size;		// window size of the game
+	ScoreHistory score_history;		// result of every finished round. uses the PersistenceWorker of the parent class, so it must be destroyed before it
+	KeystrokeRecorder keystroke_recorder;	// every keystroke of the rounds. also uses the PersistenceWorker of the parent class
+	WordListWatcher word_list_watcher;		// the word list of the Playfield. reloaded when the file is changed
+	AssetLoader asset_loader;		// loads the fonts, the textures and the word list in the background. must be the last member, because its thread uses the other members
+};
+
+#endif // _GAMESETTINGS_HPP_
@@ -0,0 +1,50 @@
+#ifndef _HEADLESSSIM_HPP_
+#define _HEADLESSSIM_HPP_
+
+#include <list>
+#include <string>
+#include "Entity.h"
+#include "GameSettings.h"
+#include "Word.h"
+
+
+// Simulates a player that types the words on the Playfield. Used to generate load for the game logic in the headless simulation.
+// The bot always continues the word that is currently being typed (the word with the highest writing index).
+// If no word is being typed, the word with the lowest health is chosen as the next target.
+class TypistBot
+{
+public:
+	unsigned int keys_pressed;	// number of emitted key events
+	unsigned int wrong_keys;	// number of key events that were intentionally wrong
+
+	TypistBot(float words_per_minute = 60, float error_probability = 0);
+
+	bool next_key(const std::list<Word*>& word_list, sf::Time now, sf::Event::KeyEvent& key_evnt);
+
+	static bool char_to_key_event(sf::Uint32 character, sf::Event::KeyEvent& key_evnt);
+	static bool is_typeable(const sf::String& string);
+
+private:
+	sf::Time key_interval;	// time between two key presses. derived from the words per minute (one word is 5 keystrokes)
+	sf::Time next_key_time;	// time of the next key press
+	float error_rate;		// probability (0...1) that a wrong key is pressed
+};
+
+
+// configuration of the headless simulation. Can be set with command line arguments (see parse_headless_args())
+typedef struct headless_config
+{
+	unsigned int rounds;			// number of rounds to play. one round lasts as long as the playtime of the Playfield
+	float words_per_minute;			// typing speed of the TypistBot
+	float error_rate;				// probability (0...1) that the TypistBot presses a wrong key
+	float tick_ms;					// simulated time step of one tick (one update() and update_physics() call). in milliseconds
+	int boundary_id;				// playfield boundary (see SettingsFileParser::p_bound)
+	unsigned int num_words;			// number of words on the playfield
+	unsigned int seed;				// seed for rand(). the same seed gives the same simulation
+	std::string report_filename;	// if not empty, the results are also written to this file in JSON format
+} headless_config_t;
+
+int parse_headless_args(int argc, char* argv[], headless_config_t& config);
+int run_headless_simulation(GameSettings& settings, const headless_config_t& config);
+
+#endif // _HEADLESSSIM_HPP_
@@ -0,0 +1,119 @@
+#ifndef _KEYSTROKERECORDER_HPP_
+#define _KEYSTROKERECORDER_HPP_
+
+#include <string>
+#include <vector>
+#include "Entity.h"
+#include "MappedFile.h"
+#include "PersistenceWorker.h"
+
+
+// error statistics of one expected character
+typedef struct letter_stat
+{
+	char letter;				// expected character
+	unsigned int num_keys;		// number of keystrokes where this character was expected
+	unsigned int num_errors;	// number of keystrokes where another character was typed
+} letter_stat_t;
+
+// latency statistics of two characters that were typed correctly one after another in the same word
+typedef struct bigram_stat
+{
+	char first;
+	char second;
+	unsigned int num_keys;
+	float mean_latency_ms;		// average time between the two keystrokes. in milliseconds
+} bigram_stat_t;
+
+// typing speed of one round
+typedef struct wpm_point
+{
+	sf::Int64 timestamp;		// start of the round. in seconds since January 1, 1970
+	unsigned int num_keys;
+	float wpm;					// correct keystrokes / 5 per minute of typing
+} wpm_point_t;
+
+
+// Records every keystroke of a playthrough: the expected character, the typed character, the time since the last keystroke and the length of the word.
+// The keystrokes are stored column by column ("columnar"): every column is a fixed-width array of one value of all keystrokes of a chunk.
+// A query reads only the columns it needs (e.g. the error rate only needs the expected and the typed character) and each column is compressed on its own.
+// File format (all numbers little endian):
+//   magic "TGKS" (4 bytes) | format version (2 bytes) | chunks ...
+//   chunk: number of keystrokes (2 bytes) | start time (8 bytes) | columns ...
+//   column: encoding (1 byte) | length of the data (4 bytes) | CRC32 of the data (4 bytes) | data
+// One chunk contains the keystrokes of one round (or CHUNK_KEYS keystrokes, if a round has more). A chunk is appended by the PersistenceWorker when the round ends.
+// Every column has its own checksum, so a query only has to read the columns it uses. An incomplete chunk at the end of the file (after a crash) is cut off before the first chunk is appended.
+// Encodings: the typed character is stored as XOR with the expected character, so correct keystrokes are 0. The byte columns are run-length encoded if that is smaller.
+// The intervals are stored as variable length numbers (7 bits per byte), because most of them are shorter than 16 seconds (2 bytes).
+class KeystrokeRecorder
+{
+public:
+	KeystrokeRecorder(const std::string& filename, PersistenceWorker& persistence_worker);
+	~KeystrokeRecorder();
+
+	void set_read_only(bool enable);
+	void start_round();
+	void record_keystroke(char expected, char typed, unsigned int word_length);
+	void end_round();
+	unsigned int get_letter_stats(std::vector<letter_stat_t>& stats_out);
+	unsigned int get_bigram_stats(std::vector<bigram_stat_t>& stats_out);
+	unsigned int get_wpm_over_time(std::vector<wpm_point_t>& points_out);
+
+private:
+	enum chunk_size
+	{
+		CHUNK_KEYS = 4096	// maximum number of keystrokes in a chunk
+	};
+
+	enum column_id		// the columns of a chunk. in the order they are stored
+	{
+		COL_EXPECTED = 0,	// expected character. 0 if the keystroke didn't match any word
+		COL_TYPED,			// typed character XOR expected character
+		COL_INTERVAL,		// time since the last keystroke (the start of the round for the first keystroke). in milliseconds
+		COL_WORD_LENGTH,	// length of the word that was typed. 0 if the keystroke didn't match any word
+		NUM_COLUMNS
+	};
+
+	enum column_encoding
+	{
+		ENC_RAW = 0,		// one byte per keystroke
+		ENC_RLE,			// pairs of value (1 byte) and run length (variable length number)
+		ENC_VARINT			// one variable length number per keystroke
+	};
+
+	enum file_format	// version and sizes (in bytes) of the file format
+	{
+		FORMAT_VERSION = 1,
+		HEADER_LENGTH = 6,			// magic and format version
+		CHUNK_HEADER_LENGTH = 10,	// number of keystrokes and start time
+		COLUMN_HEADER_LENGTH = 9,	// encoding, length and CRC32
+		MAX_INTERVAL_MS = 3600000	// longer intervals are stored as this value
+	};
+
+	std::string filename;				// path of the keystroke file
+	PersistenceWorker* persistence;		// appends the chunks in the background
+	bool read_only;						// if true, no keystrokes are recorded
+	bool file_checked;					// true after init_file() was called. called before the first chunk is appended, so a read-only recorder never changes the file
+	sf::Clock key_clock;				// measures the time between keystrokes
+	sf::Int64 chunk_start_time;			// time of the first keystroke of the current chunk. in seconds since January 1, 1970
+
+	// keystrokes of the current chunk. one vector per column
+	std::vector<sf::Uint8> expected_col;
+	std::vector<sf::Uint8> typed_col;
+	std::vector<sf::Uint32> interval_col;
+	std::vector<sf::Uint8> word_length_col;
+
+	void init_file();
+	void write_chunk();
+	int map_file(MappedFile& file);
+	static const char* next_chunk(const char* chunk, const char* file_end);
+	static int read_column(const char* chunk, unsigned int column, std::vector<sf::Uint8>& values_out);
+	static int read_column(const char* chunk, unsigned int column, std::vector<sf::Uint32>& values_out);
+	static const char* find_column(const char* chunk, unsigned int column);
+	static int decode_bytes(const char* data, unsigned int length, unsigned int encoding, unsigned int num_keys, std::vector<sf::Uint8>& values_out);
+	static int decode_varints(const char* data, unsigned int length, unsigned int num_keys, std::vector<sf::Uint32>& values_out);
+	static void encode_bytes(const std::vector<sf::Uint8>& values, std::vector<char>& buffer);
+	static void encode_varints(const std::vector<sf::Uint32>& values, std::vector<char>& buffer);
+};
+
+#endif // _KEYSTROKERECORDER_HPP_
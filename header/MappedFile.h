@@ -0,0 +1,34 @@
+#ifndef _MAPPEDFILE_HPP_
+#define _MAPPEDFILE_HPP_
+
+#include <string>
+
+
+// maps a file read-only into memory. The content can then be read like an array without copying it and without a read call per access.
+// only the pages that are accessed are loaded from the disk, so also big files can be opened quickly.
+// the mapping shows the file as it was when it was opened. To see data that was appended later, the file must be opened again.
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	int open(const std::string& file_name);
+	void close();
+	const char* data();
+	size_t size();
+
+private:
+	const char* mapped_data;	// first byte of the mapped file. NULL if no file is mapped
+	size_t mapped_size;			// size of the mapped file. in bytes
+#ifdef _WIN32
+	void* file_handle;			// HANDLE of the file
+	void* mapping_handle;		// HANDLE of the file mapping object
+#endif
+
+	// the mapping can't be copied, because it would be unmapped twice
+	MappedFile(const MappedFile&);
+	MappedFile& operator = (const MappedFile&);
+};
+
+#endif // _MAPPEDFILE_HPP_
@@ -1,52 +1,67 @@
-#ifndef _OPTIONSCREEN_HPP_
-#define _OPTIONSCREEN_HPP_
-
-#include "Entity.h"
-#include "Button.h"
-#include "GameSettings.h"
-
-
-// The OptionScreen inherits from Entity
-// The Option Screen displays all Settings and the Hi-Score
-class OptionScreen : public Entity
-{
-public:
-	OptionScreen(GameSettings& game_settings);
-	virtual ~OptionScreen();
-
-	void update_positions();
-
-	virtual void update();
-	virtual void update_physics();
-	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
-	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
-	virtual void draw_on_window(sf::RenderWindow& window);
-
-private:
-	enum Text_id	// defines an ID for every Text on the Screen
-	{
-		HI_SCORE_TXT = 0,
-		BOUNDARY_TXT,
-		FONT_TXT,
-		NUM_WORDS_TEXT,
-		NUM_TEXTS
-	};
-
-	enum Button_id	// defines an ID for every Button on the Screen
-	{
-		BOUNDARY_BTN = 0,
-		FONT_BTN,
-		NUM_WORDS_BTN,
-		NUM_BUTTONS
-	};
-
-	// Buttons and text thats displayed on the Option Screen
-	sf::Text options_text_descr[NUM_TEXTS];
-	sf::Text options_text_val[NUM_TEXTS];
-	Button back_btn;
-	Button options_btn_left[NUM_BUTTONS];
-	Button options_btn_right[NUM_BUTTONS];
-	GameSettings* settings;	// pointer to the game settings
-};
-
-#endif // _OPTIONSCREEN_HPP_
+#ifndef _OPTIONSCREEN_HPP_
+#define _OPTIONSCREEN_HPP_
+
+#include "Entity.h"
+#include "Button.h"
+#include "RenderLayer.h"
+#include "GameSettings.h"
+
+
+// The OptionScreen inherits from Entity
+// The Option Screen displays all Settings, the Hi-Score and the leaderboard of the score history
+class OptionScreen : public Entity
+{
+public:
+	OptionScreen(GameSettings& game_settings);
+	virtual ~OptionScreen();
+
+	void update_positions();
+	void update_leaderboard();
+
+	virtual void update();
+	virtual void update_physics();
+	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
+	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
+	virtual void draw_on_window(DrawCommandBuffer& target);
+	virtual bool is_animating();
+	virtual const char* get_entity_name();
+
+private:
+	enum Text_id	// defines an ID for every Text on the Screen
+	{
+		HI_SCORE_TXT = 0,
+		BOUNDARY_TXT,
+		FONT_TXT,
+		NUM_WORDS_TEXT,
+		TICK_RATE_TXT,
+		WORD_MODE_TXT,
+		FRAME_PACING_TXT,
+		NUM_TEXTS
+	};
+
+	enum Button_id	// defines an ID for every Button on the Screen
+	{
+		BOUNDARY_BTN = 0,
+		FONT_BTN,
+		NUM_WORDS_BTN,
+		TICK_RATE_BTN,
+		WORD_MODE_BTN,
+		FRAME_PACING_BTN,
+		NUM_BUTTONS
+	};
+
+	// Buttons and text thats displayed on the Option Screen
+	sf::Text options_text_descr[NUM_TEXTS];
+	sf::Text options_text_val[NUM_TEXTS];
+	Button back_btn;
+	Button options_btn_left[NUM_BUTTONS];
+	Button options_btn_right[NUM_BUTTONS];
+	sf::Text save_status_msg;	// warning that is shown if the settings can't be saved
+	sf::Text leaderboard_text;	// best rounds of the score history, the rounds of today and the best round with the current settings
+	RenderLayer screen_layer;	// cached content of the screen. invalidated on every mouse click (it may change an option) and when the save status or the hover state of a Button changes
+	GameSettings* settings;	// pointer to the game settings
+
+	sf::String get_save_status();
+};
+
+#endif // _OPTIONSCREEN_HPP_
@@ -0,0 +1,80 @@
+#ifndef _PARTICLESYSTEM_HPP_
+#define _PARTICLESYSTEM_HPP_
+
+#include <vector>
+#include "Entity.h"
+#include "GameClock.h"
+
+
+// The ParticleSystem inherits from Entity
+// effects of the words that leave the Playfield: typed words shatter into a burst of shards, missed words fade away in a slowly drifting cloud.
+// the particles are stored in a pool with a fixed capacity in a structure of arrays (one array per property), so the update loops run over contiguous memory and can be vectorized.
+// the live particles are always the first num_particles Elements of the arrays. a dead particle is replaced by the last live particle, so the order of the particles is not kept.
+// all memory (also the vertices) is allocated in the constructor. if the pool is full, new particles are dropped.
+// all particles are drawn as quads of one vertex array with a single draw call.
+// the particles are moved in update_physics() (physics thread) and spawned and drawn by the main thread, so the Playfield calls every method while holding mutex_glob.
+class ParticleSystem : public Entity
+{
+public:
+	enum pool_size
+	{
+		MAX_PARTICLES = 131072		// capacity of the pool
+	};
+
+	ParticleSystem(unsigned int capacity = MAX_PARTICLES);
+	virtual ~ParticleSystem();
+
+	void spawn_shatter(const sf::Text& text, const sf::Vector2f& velocity);
+	void spawn_fade(const sf::Text& text, const sf::Vector2f& velocity);
+	void step(float dt);
+	void clear();
+	unsigned int get_num_particles();
+	unsigned int get_capacity();
+	unsigned long long get_dropped_particles();
+
+	virtual void update();
+	virtual void update_physics();
+	virtual void draw_on_window(DrawCommandBuffer& target);
+	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
+	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
+	virtual bool is_animating();
+	virtual const char* get_entity_name();
+
+private:
+	typedef struct effect_params	// look of the particles of an effect
+	{
+		unsigned int particles_per_glyph;
+		float min_speed, max_speed;		// speed away from the center of the word. in pixels per second
+		float drift;					// part of the word velocity that the particles keep
+		float gravity;					// in pixels per second^2. negative values let the particles rise
+		float min_lifetime, max_lifetime;	// in seconds
+		float min_size, max_size;		// edge length of the quads. in pixels
+		sf::Color color;
+	} effect_params_t;
+
+	static const effect_params_t shatter_params;	// typed words. red like the typed letters of a Word
+	static const effect_params_t fade_params;		// missed words
+
+	unsigned int capacity;				// size of the arrays
+	unsigned int num_particles;			// number of live particles
+	unsigned long long dropped_particles;	// particles that were not spawned, because the pool was full
+	unsigned int random_state;			// state of the random number generator. rand() is not used, so the random numbers of the game (e.g. the chosen words) are the same with and without particles
+	GameClock physics_clock;			// measures the time step of update_physics()
+
+	// properties of the particles (structure of arrays)
+	std::vector<float> pos_x, pos_y;	// position of the center. in pixels
+	std::vector<float> vel_x, vel_y;	// velocity. in pixels per second
+	std::vector<float> gravity;			// acceleration in y-direction. in pixels per second^2
+	std::vector<float> life;			// remaining lifetime. in seconds
+	std::vector<float> inv_lifetime;	// 1 / lifetime at the spawn. used to fade out the alpha
+	std::vector<float> size;			// edge length. in pixels
+	std::vector<sf::Color> color;		// color at the spawn
+
+	sf::VertexArray vertices;			// quads of the live particles. allocated for the full capacity
+
+	void spawn_effect(const sf::Text& text, const sf::Vector2f& velocity, const effect_params_t& params);
+	float random_range(float min, float max);
+	void remove_particle(unsigned int index);
+};
+
+#endif // _PARTICLESYSTEM_HPP_
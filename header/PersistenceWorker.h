@@ -0,0 +1,59 @@
+#ifndef _PERSISTENCEWORKER_HPP_
+#define _PERSISTENCEWORKER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Writes files in a background thread, so the game thread doesn't wait for the disk.
+// A write request contains the complete new content of a file. The requests are put in a queue and the worker thread replaces the files atomically (see write_file_atomic()).
+// Repeated requests for the same file are coalesced: a new request replaces the queued request of the same file, so only the latest content is written.
+// Data can also be appended to a file (e.g. a log). Queued appends to the same file are joined and written with one write, nothing is dropped.
+// The worker also waits a short time after the first request, so a burst of requests (e.g. clicking an option button many times) results in only one write.
+// On destruction all queued requests are written before the worker thread terminates.
+class PersistenceWorker
+{
+public:
+	PersistenceWorker();
+	~PersistenceWorker();
+
+	void request_write(const std::string& file_name, const char* data, size_t size);
+	void request_append(const std::string& file_name, const char* data, size_t size);
+	void flush();
+	bool has_write_failed();
+
+	static int write_file_atomic(const std::string& file_name, const char* data, size_t size);
+	static int append_file(const std::string& file_name, const char* data, size_t size);
+
+private:
+	enum coalesce_delay
+	{
+		COALESCE_DELAY_MS = 250		// time the worker waits after the first request for more requests. in milliseconds
+	};
+
+	typedef struct write_request
+	{
+		std::string file_name;
+		bool append;				// true: append the data to the file. false: replace the content of the file
+		std::vector<char> data;		// complete new content of the file or the data to append
+	} write_request_t;
+
+	std::mutex queue_mutex;						// protects all members below (except write_failed)
+	std::condition_variable queue_cv;			// signals the worker thread that there is a new request, a flush or the termination
+	std::condition_variable idle_cv;			// signals the waiting flush() that all requests are written
+	std::list<write_request_t> queue;			// requests that are not written yet. at most one request of each kind (append/ replace) per file
+	bool busy;									// if the worker thread is currently writing
+	bool flush_requested;						// if the worker shall write immediately without waiting for more requests
+	bool stop;									// signals the worker thread to terminate after writing all requests
+	std::atomic<bool> write_failed;				// if the last write of any file failed. reset by the next successful write
+	std::thread worker_thread;					// must be the last member, because the thread uses the other members
+
+	void worker_task();
+};
+
+#endif // _PERSISTENCEWORKER_HPP_
@@ -1,79 +1,117 @@
-#ifndef _PLAYFIELD_HPP_
-#define _PLAYFIELD_HPP_
-
-#include <list>
-#include "Entity.h"
-#include "GameSettings.h"
-#include "CSVParser.h"
-#include "Word.h"
-#include "Button.h"
-
-
-// The class Playfield inherits from Entity
-// displays all the game statistics, a list of the Words on the field and the boundary. Has a restart and back button
-// Template class. The type specifies the boundary of the playfield. Default type: sf::RectangleShape / supported types: sf::RectangleShape, sf::CircleShape
-// because the supported types can't be handled in the same way and have different methods,
-// there must be multiple methods defined of the same name that handle every supported type
-// note: non-virtual methods of e.g. sf::CircleShape can't be called by objects of the Template type T or of the parent type sf::Shape
-template <typename T = sf::RectangleShape> class Playfield : public Entity
-{
-public:
-	Playfield(GameSettings& game_settings);
-	virtual ~Playfield();
-	Playfield& operator = (const Playfield& playfield_orig);
-	Playfield(const Playfield& playfield_orig);
-
-	virtual void update();
-	virtual void update_physics();
-	virtual void draw_on_window(sf::RenderWindow& window);
-	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
-	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
-
-private:
-	enum Text_id	// defines an ID for every Text on the Screen
-	{
-		PLAYTIME = 0,
-		TYPED_WORDS,
-		SCORE,
-		MISSED_WORDS,
-		NEW_HI_SCORE,
-		NUM_TEXTS
-	};
-
-	enum score_points		// defines the score points to get
-	{
-		POINTS_PER_MISS = -50,
-		POINTS_PER_LETTER = 10,
-	};
-
-	GameSettings* settings;				// pointer to the game settings
-	float playtime;						// in seconds. gets counted backwards from max_playtime as the game progresses
-	float max_playtime;					// in seconds. defines the length of a game
-	unsigned int typed_words;			// number of words typed in the playthrough. gets displayed on the screen
-	unsigned int missed_words;			// number of missed words in the playthrough. gets displayed on the screen
-	int score;							// current score points
-	float boundary_size;				// in pixels. size of the boundary (diameter of circle or edge length of rectangle) where the Words are inside
-	bool game_running;					// flag if the game is currently running (playtime not at zero)
-	sf::Clock clock;					// The clock starts automatically after being constructed. used to count down playtime
-	CSVParser word_list_csv;			// CSVParser object to get random words from a file
-	Button back_btn, restart_btn;		// back and restart Button. the back button leads to the Start Screen. the restart Button resets the game statistics and restarts the game clock
-	sf::Texture side_panel_texture;		// Texture on the left of the screen to hold the game statistics
-	T boundary;							// boundary shape with template type
-	sf::Text playfield_text[NUM_TEXTS];	// Game statistics on the left of the screen in Text form
-	std::list<Word*> word_list;				// list to store pointer to Word objects that are registred on the Playfield. Typeparameter for the Template is a pointer on class Word
-	std::list<unsigned int> collision_cnt;	// store the number of continuous collisions for every word to detect if its out of bounds. This list shall follow the word list exactly
-
-	void init_boundary(sf::RectangleShape& bound);
-	void init_boundary(sf::CircleShape& bound);
-	void init_stats();
-	void spawn_word(Word& word, const sf::RectangleShape& bound);
-	void spawn_word(Word& word, const sf::CircleShape& bound);
-	bool word_reflection(Word& word, const sf::RectangleShape& bound);
-	bool word_reflection(Word& word, const sf::CircleShape& bound);
-};
-
-// Define the supported types for the template
-typedef Playfield<sf::RectangleShape> PlayfieldRect;
-typedef Playfield<sf::CircleShape> PlayfieldCirlce;
-
-#endif // _PLAYFIELD_HPP_
+#ifndef _PLAYFIELD_HPP_
+#define _PLAYFIELD_HPP_
+
+#include <list>
+#include <memory>
+#include "Entity.h"
+#include "GameSettings.h"
+#include "CSVParser.h"
+#include "WordSampler.h"
+#include "Word.h"
+#include "Button.h"
+#include "RenderLayer.h"
+#include "ParticleSystem.h"
+
+
+// The class Playfield inherits from Entity
+// displays all the game statistics, a list of the Words on the field and the boundary. Has a restart and back button
+// Template class. The type specifies the boundary of the playfield. Default type: sf::RectangleShape / supported types: sf::RectangleShape, sf::CircleShape
+// because the supported types can't be handled in the same way and have different methods,
+// there must be multiple methods defined of the same name that handle every supported type
+// note: non-virtual methods of e.g. sf::CircleShape can't be called by objects of the Template type T or of the parent type sf::Shape
+template <typename T = sf::RectangleShape> class Playfield : public Entity
+{
+public:
+	Playfield(GameSettings& game_settings);
+	virtual ~Playfield();
+	Playfield& operator = (const Playfield& playfield_orig);
+	Playfield(const Playfield& playfield_orig);
+
+	void restart();
+	bool is_game_running();
+	unsigned int get_typed_words();
+	unsigned int get_missed_words();
+	int get_score();
+	const std::list<Word*>& get_word_list();
+	unsigned long long get_spawned_words();
+	unsigned long long get_deleted_words();
+
+	virtual void update();
+	virtual void update_physics();
+	virtual void draw_on_window(DrawCommandBuffer& target);
+	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
+	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
+	virtual bool is_animating();
+	virtual const char* get_entity_name();
+
+private:
+	// the benchmark needs direct access to the private methods and the word list (see benchmark/Benchmark.cpp)
+	template <typename U> friend class PlayfieldBenchmark;
+
+	enum Text_id	// defines an ID for every Text on the Screen
+	{
+		PLAYTIME = 0,
+		TYPED_WORDS,
+		SCORE,
+		MISSED_WORDS,
+		NEW_HI_SCORE,
+		NUM_TEXTS
+	};
+
+	enum ramp_lengths		// defines the word lengths in the ramp word mode
+	{
+		RAMP_START_LENGTH = 3,		// shortest word length at the start of a playthrough
+		RAMP_END_LENGTH = 10,		// shortest word length at the end of a playthrough
+		RAMP_LENGTH_RANGE = 2		// the words are up to this number of letters longer than the shortest word length
+	};
+
+	enum score_points		// defines the score points to get
+	{
+		POINTS_PER_MISS = -50,
+		POINTS_PER_LETTER = 10,
+	};
+
+	GameSettings* settings;				// pointer to the game settings
+	float playtime;						// in seconds. gets counted backwards from max_playtime as the game progresses
+	float max_playtime;					// in seconds. defines the length of a game
+	unsigned int typed_words;			// number of words typed in the playthrough. gets displayed on the screen
+	unsigned int missed_words;			// number of missed words in the playthrough. gets displayed on the screen
+	int score;							// current score points
+	float boundary_size;				// in pixels. size of the boundary (diameter of circle or edge length of rectangle) where the Words are inside
+	bool game_running;					// flag if the game is currently running (playtime not at zero)
+	bool words_moving;					// same as game_running, but protected by mutex_glob, so the physics thread can read it
+	bool particles_alive;				// true if a particle was alive at the last update(). only used by the main thread, so is_animating() doesn't need mutex_glob
+	bool new_hi_score;					// flag if a new Hi-Score was reached in the playthrough
+	unsigned int correct_keys;			// number of keystrokes in the playthrough that were the next letter of a word. used for the typing speed and accuracy
+	unsigned int total_keys;			// number of all keystrokes in the playthrough (without keys that can't be typed)
+	unsigned long long spawned_words;	// number of words that were created since the construction of the Playfield. not reset by restart()
+	unsigned long long deleted_words;	// number of words that were deleted since the construction (typed, missed, restart() and destructor). not reset by restart()
+	GameClock clock;					// The clock starts automatically after being constructed. used to count down playtime
+	std::shared_ptr<const CSVParser> word_list_csv;	// the word list to get random words from. points into the snapshot of the WordListWatcher and is replaced when the file is reloaded
+	WordSampler word_sampler;			// chooses the words from word_list_csv in the adaptive word mode
+	Button back_btn, restart_btn;		// back and restart Button. the back button leads to the Start Screen. the restart Button resets the game statistics and restarts the game clock
+	std::shared_ptr<const sf::Texture> side_panel_texture;	// Texture on the left of the screen to hold the game statistics. shared by all Playfields (see ResourceManager)
+	T boundary;							// boundary shape with template type
+	sf::Text playfield_text[NUM_TEXTS];	// Game statistics on the left of the screen in Text form
+	int shown_playtime;					// playtime in seconds that is shown in playfield_text[PLAYTIME]. the text is only changed when the shown value changes
+	RenderLayer side_panel_layer;		// cached side panel with the game statistics and the Buttons. invalidated when a text or the hover state of a Button changes
+	std::list<Word*> word_list;				// list to store pointer to Word objects that are registred on the Playfield. Typeparameter for the Template is a pointer on class Word
+	std::list<unsigned int> collision_cnt;	// store the number of continuous collisions for every word to detect if its out of bounds. This list shall follow the word list exactly
+	ParticleSystem particles;				// shards of the typed words and clouds of the missed words. protected by mutex_glob like the word list
+
+	void init_boundary(sf::RectangleShape& bound);
+	void init_boundary(sf::CircleShape& bound);
+	void init_stats();
+	void save_round();
+	std::string get_ramp_word();
+	void spawn_word(Word& word, const sf::RectangleShape& bound);
+	void spawn_word(Word& word, const sf::CircleShape& bound);
+	bool word_reflection(Word& word, const sf::RectangleShape& bound);
+	bool word_reflection(Word& word, const sf::CircleShape& bound);
+};
+
+// Define the supported types for the template
+typedef Playfield<sf::RectangleShape> PlayfieldRect;
+typedef Playfield<sf::CircleShape> PlayfieldCirlce;
+
+#endif // _PLAYFIELD_HPP_
@@ -0,0 +1,148 @@
+#ifndef _RENDERBACKEND_HPP_
+#define _RENDERBACKEND_HPP_
+
+#include <map>
+#include <string>
+#include "SFML/Graphics.hpp"
+
+class RenderLayer;
+
+
+// target of the replay of a DrawCommandBuffer (see DrawCommandBuffer::replay()). every recorded command calls one method of the backend.
+// implementations:
+//   WindowRenderBackend:   draws on the game window (used by the RenderThread)
+//   TextureRenderBackend:  draws into an offscreen render texture, e.g. for benchmarks on machines without a display
+//   CountingRenderBackend: doesn't draw anything, but counts the draw calls, vertices, texture binds and state changes of every frame and of every Entity
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+	virtual void clear(const sf::Color& color) = 0;
+	virtual void draw(const sf::Text& text, const sf::RenderStates& states) = 0;
+	virtual void draw(const sf::Shape& shape, const sf::RenderStates& states) = 0;
+	virtual void draw(const sf::Sprite& sprite, const sf::RenderStates& states) = 0;
+	virtual void draw(const sf::Vertex* vertices, size_t num_vertices, sf::PrimitiveType type, const sf::RenderStates& states) = 0;
+	virtual void begin_layer(RenderLayer& layer) = 0;		// the following draws go into the render texture of the layer
+	virtual void end_layer(RenderLayer& layer) = 0;			// the following draws go into the target again
+	virtual void draw_layer(RenderLayer& layer) = 0;		// draw the cached content of the layer
+	virtual void display() = 0;								// end of the frame
+	// virtual function with a default implementation (only overridden by backends that need it):
+	// the Entity that recorded the following commands (see DrawCommandBuffer::draw_entity()). NULL for commands outside of an Entity
+	virtual void set_owner(const char* owner_name) {}
+};
+
+
+// draws the commands on an SFML render target. base class of the window and the texture backend
+class TargetRenderBackend : public RenderBackend
+{
+public:
+	TargetRenderBackend(sf::RenderTarget& render_target);
+	virtual ~TargetRenderBackend();
+
+	virtual void clear(const sf::Color& color);
+	virtual void draw(const sf::Text& text, const sf::RenderStates& states);
+	virtual void draw(const sf::Shape& shape, const sf::RenderStates& states);
+	virtual void draw(const sf::Sprite& sprite, const sf::RenderStates& states);
+	virtual void draw(const sf::Vertex* vertices, size_t num_vertices, sf::PrimitiveType type, const sf::RenderStates& states);
+	virtual void begin_layer(RenderLayer& layer);
+	virtual void end_layer(RenderLayer& layer);
+	virtual void draw_layer(RenderLayer& layer);
+
+private:
+	sf::RenderTarget* target;			// the target of the frame
+	sf::RenderTarget* current_target;	// the render texture of a layer between begin_layer() and end_layer(). otherwise target
+};
+
+
+// draws the commands on a window. display() shows the frame
+class WindowRenderBackend : public TargetRenderBackend
+{
+public:
+	WindowRenderBackend(sf::RenderWindow& render_window);
+	virtual ~WindowRenderBackend();
+
+	virtual void display();
+
+private:
+	sf::RenderWindow* window;
+};
+
+
+// draws the commands into an offscreen render texture, which has to be created with create() first.
+// it needs no display, but an OpenGL implementation (e.g. a software renderer like Mesa llvmpipe)
+class TextureRenderBackend : public TargetRenderBackend
+{
+public:
+	TextureRenderBackend();
+	virtual ~TextureRenderBackend();
+
+	bool create(unsigned int width, unsigned int height);
+	sf::Vector2u get_size();
+	sf::RenderTexture& get_render_texture();
+	virtual void display();
+
+private:
+	sf::RenderTexture texture;
+};
+
+
+// counts the cost of the frames without drawing anything, so the render cost can be measured and compared on machines without a display or OpenGL.
+// the counts are derived from the geometry that SFML builds for every drawable:
+//   text:      6 vertices per glyph (whitespace has no glyph). one more draw call of the same size for the outline
+//   shape:     a triangle fan with point count + 2 vertices. one more draw call with (point count + 1) * 2 vertices and no texture for the outline
+//   sprite:    4 vertices. not drawn without a texture
+//   layer:     4 vertices of the layer texture with the premultiplied blend mode. begin_layer() and end_layer() switch the render target
+// a texture bind is counted for every draw call that uses another texture (or no texture) than the draw call before. the first draw call of a frame and after a switch of the render target always counts.
+// a state change is counted for every draw call with another blend mode or shader than the draw call before (the first draw call of a frame is compared to the default states), and for every switch of the render target.
+// the counts of every frame are added to the counts of the Entity that recorded the commands (see set_owner()), so the draw calls of every Entity type can be compared.
+class CountingRenderBackend : public RenderBackend
+{
+public:
+	typedef struct render_stats
+	{
+		unsigned long long draw_calls;
+		unsigned long long vertices;
+		unsigned long long texture_binds;
+		unsigned long long state_changes;
+	} render_stats_t;
+
+	CountingRenderBackend();
+	virtual ~CountingRenderBackend();
+
+	void reset_stats();
+	const render_stats_t& get_frame_stats();
+	const render_stats_t& get_total_stats();
+	unsigned long long get_num_frames();
+	std::string get_report();
+
+	virtual void clear(const sf::Color& color);
+	virtual void draw(const sf::Text& text, const sf::RenderStates& states);
+	virtual void draw(const sf::Shape& shape, const sf::RenderStates& states);
+	virtual void draw(const sf::Sprite& sprite, const sf::RenderStates& states);
+	virtual void draw(const sf::Vertex* vertices, size_t num_vertices, sf::PrimitiveType type, const sf::RenderStates& states);
+	virtual void begin_layer(RenderLayer& layer);
+	virtual void end_layer(RenderLayer& layer);
+	virtual void draw_layer(RenderLayer& layer);
+	virtual void display();
+	virtual void set_owner(const char* owner_name);
+
+private:
+	render_stats_t frame_stats;				// counts of the current frame
+	render_stats_t last_frame_stats;		// counts of the last displayed frame
+	render_stats_t total_stats;				// counts of all displayed frames
+	unsigned long long num_frames;			// number of displayed frames since the last reset_stats()
+	std::map<std::string, render_stats_t> owner_stats;	// counts of all frames of every Entity type. "other" for commands outside of an Entity
+	render_stats_t* current_owner_stats;	// element of owner_stats of the current owner
+
+	// states of the last draw call on the current target
+	bool has_last_draw;						// false at the start of every frame and after a switch of the render target
+	const sf::Texture* last_texture;
+	sf::BlendMode last_blend_mode;
+	const sf::Shader* last_shader;
+
+	void count_draw_call(size_t num_vertices, const sf::RenderStates& states);
+	void switch_target();
+	static void add_stats(render_stats_t& sum, const render_stats_t& stats);
+};
+
+#endif // _RENDERBACKEND_HPP_
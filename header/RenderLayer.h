@@ -0,0 +1,49 @@
+#ifndef _RENDERLAYER_HPP_
+#define _RENDERLAYER_HPP_
+
+#include "Entity.h"
+#include "DrawCommandBuffer.h"
+
+
+// caches static or rarely changing content of a screen (e.g. the side panel of the Playfield with its texts and Buttons) in an offscreen render texture.
+// the content is only drawn again when the layer was invalidated. otherwise the frame only draws the cached texture as one sprite.
+// usage in draw_on_window() of a screen:
+//		if (layer.needs_redraw())
+//		{
+//			DrawCommandBuffer& layer_target = layer.begin(target);
+//			... draw the content on layer_target ...
+//			layer.end();
+//		}
+//		layer.draw_on_window(target);
+// the content is drawn on a transparent texture, so the cached colors are premultiplied with their alpha and the layer is blended with a premultiplied blend mode.
+// this gives the same result as drawing the content directly on the window.
+// if the render texture can't be created (e.g. no support of offscreen rendering), the content is drawn directly on the target in every frame.
+// begin(), end() and draw_on_window() only record commands in a DrawCommandBuffer. the render texture is only drawn by the replay of the commands on a RenderBackend
+// (the replay_ methods), so it is only used by the render thread. the layer must exist until the commands are replayed.
+class RenderLayer
+{
+public:
+	RenderLayer();
+	RenderLayer(const RenderLayer& layer_orig);
+	RenderLayer& operator = (const RenderLayer& layer_orig);
+
+	bool create(unsigned int width, unsigned int height);
+	void invalidate();
+	bool needs_redraw();
+	DrawCommandBuffer& begin(DrawCommandBuffer& target);
+	void end();
+	void draw_on_window(DrawCommandBuffer& target);
+	const sf::Texture& get_texture();
+	static sf::BlendMode get_blend_mode();
+	sf::RenderTarget& replay_begin(sf::RenderTarget& target);
+	void replay_end();
+	void replay_draw(sf::RenderTarget& target);
+
+private:
+	sf::RenderTexture texture;		// the cached content
+	bool cached;					// true if the render texture was created. otherwise the content is drawn directly on the target
+	bool dirty;						// true if the content must be drawn again before the layer is drawn
+	DrawCommandBuffer* recording_target;	// command buffer of the last begin(). end() records in it
+};
+
+#endif // _RENDERLAYER_HPP_
@@ -0,0 +1,58 @@
+#ifndef _RENDERTHREAD_HPP_
+#define _RENDERTHREAD_HPP_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Entity.h"
+#include "DrawCommandBuffer.h"
+#include "RenderBackend.h"
+#include "FramePacer.h"
+#include "FrameCapture.h"
+
+
+// draws and displays the frames in its own thread, so the main thread (events and update() of the entities) doesn't wait for the drawing and for display() (V-Sync).
+// the main thread records the draw commands of a frame in a DrawCommandBuffer and submits it. the render thread replays the commands on the window, displays the frame and paces the frames (see FramePacer).
+// there are two command buffers: while the render thread draws frame N from one buffer, the main thread records frame N + 1 in the other one.
+// submit() waits until frame N is displayed, so the main thread is at most one frame ahead of the screen.
+// while the render thread runs, the OpenGL context of the window is active in the render thread, so the main thread must not draw on the window or change its V-Sync.
+// the render thread holds FontManager::glyph_mutex while it replays a frame, so the main thread can't change a glyph texture that is drawn (see FontManager.h).
+// the frame pacing is changed with set_frame_pacing(), which passes the change to the render thread.
+// with set_frame_capture() the render thread also captures the frames (see FrameCapture.h).
+class RenderThread
+{
+public:
+	RenderThread(sf::RenderWindow& render_window, FramePacer& pacer);
+	~RenderThread();
+
+	void start();
+	void stop();
+	DrawCommandBuffer& get_command_buffer();
+	void submit();
+	void flush();
+	void set_frame_pacing(int pacing_mode, unsigned int cap);
+	void skip_frame();
+	void set_frame_capture(FrameCapture* capture);
+
+private:
+	sf::RenderWindow* window;				// the window the frames are drawn on
+	WindowRenderBackend window_backend;		// replays the commands on the window
+	FramePacer* frame_pacer;				// paces the frames after display()
+	FrameCapture* frame_capture;			// captures the frames before display(). NULL if the frames are not captured
+	DrawCommandBuffer command_buffers[2];	// the buffer that is recorded and the buffer that is drawn
+	unsigned int record_index;				// index of the buffer that the main thread records. only used by the main thread
+
+	std::mutex render_mutex;				// protects all members below
+	std::condition_variable render_cv;		// signals the render thread that a frame was submitted or that it shall terminate. signals submit() and flush() that a frame was displayed
+	const DrawCommandBuffer* submitted_buffer;	// frame that the render thread draws. NULL after it was displayed
+	bool running;							// false signals the render thread to terminate
+	bool pacing_changed;					// the render thread sets the pacing mode before the next frame
+	int new_pacing_mode;
+	unsigned int new_fps_cap;
+	bool skip_pacing;						// the time until the next frame is not measured by the pacer (see FramePacer::skip_frame())
+	std::thread render_thread;				// started by start()
+
+	void render_task();
+};
+
+#endif // _RENDERTHREAD_HPP_
@@ -0,0 +1,43 @@
+#ifndef _RESOURCEMANAGER_HPP_
+#define _RESOURCEMANAGER_HPP_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Entity.h"
+
+
+// exception that is thrown if a texture or a font file can't be loaded
+class ResourceLoadError : public std::runtime_error
+{
+public:
+	ResourceLoadError(const std::string& resource_path, const std::string& resource_kind);
+
+	const std::string& get_path() const;
+	const std::string& get_kind() const;
+
+private:
+	std::string path;	// path of the file that can't be loaded
+	std::string kind;	// "texture" or "font"
+};
+
+// loads textures and fonts and keeps them in memory for the whole game, so a screen switch or a restart doesn't load and decode the files again.
+// every file is loaded only once. the resources are handed out as shared_ptr, so a resource is deleted when the ResourceManager and all users released it.
+// the methods can be called from different threads. the file is loaded without holding the lock, so a slow load doesn't block the other threads
+class ResourceManager
+{
+public:
+	void preload(const std::vector<std::string>& texture_paths, const std::vector<std::string>& font_paths);
+	std::shared_ptr<const sf::Texture> get_texture(const std::string& path);
+	std::shared_ptr<const sf::Font> get_font(const std::string& path);
+
+private:
+	std::mutex cache_mutex;												// protects the maps
+	std::map<std::string, std::shared_ptr<const sf::Texture> > textures;	// loaded textures by path
+	std::map<std::string, std::shared_ptr<const sf::Font> > fonts;		// loaded fonts by path
+};
+
+#endif // _RESOURCEMANAGER_HPP_
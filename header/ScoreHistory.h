@@ -0,0 +1,114 @@
+#ifndef _SCOREHISTORY_HPP_
+#define _SCOREHISTORY_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Entity.h"
+#include "MappedFile.h"
+#include "PersistenceWorker.h"
+
+
+// result of one finished round
+typedef struct round_record
+{
+	sf::Int64 timestamp;			// end of the round. in seconds since January 1, 1970
+	int score;
+	unsigned int typed_words;
+	unsigned int missed_words;
+	float wpm;						// typing speed in words per minute (one word is 5 correct keystrokes)
+	float accuracy;					// correct keystrokes / all keystrokes. 0...1
+	char boundary_id;				// settings of the round (see SettingsFileParser)
+	char font_id;
+	unsigned int num_words_spawn;
+} round_record_t;
+
+// statistics of all rounds of one day
+typedef struct day_summary
+{
+	unsigned int day;				// local date as number yyyymmdd
+	unsigned int num_rounds;
+	int best_score;
+	sf::Int64 total_score;			// sum of all scores. the average is total_score / num_rounds
+	unsigned int first_record;		// index of the first and the last round of the day in the log. the rounds in between can be from other days,
+	unsigned int last_record;		// if the clock of the computer was changed
+} day_summary_t;
+
+// statistics of all rounds that were played with the same settings
+typedef struct setting_summary
+{
+	char boundary_id;
+	unsigned int num_words_spawn;
+	unsigned int num_rounds;
+	int best_score;
+	sf::Int64 total_score;			// sum of all scores. the average is total_score / num_rounds
+	float best_wpm;
+} setting_summary_t;
+
+
+// Stores the result of every finished round in an append-only log file ("score log"). Every round is a record of fixed size with its own checksum.
+// A sidecar index file contains the leaderboard (the TOP_K best rounds), a summary of every day and a summary of every combination of settings.
+// So the queries don't need to read the log. The index is updated in memory with every new round and written by the PersistenceWorker.
+// The store is opened on first use (not in the constructor), so a store that is set to read-only before (see set_read_only()) never creates or changes the files.
+// When the store is opened, the index is loaded and only the rounds that were appended after the index was written are read from the log (with a memory mapping).
+// If the index is missing or broken, it is rebuilt from the log. Records of the log that are broken (e.g. an incomplete record after a crash) are removed by compact().
+// The appends are done by the PersistenceWorker in the background, so the game thread doesn't wait for the disk.
+class ScoreHistory
+{
+public:
+	enum top_k
+	{
+		TOP_K = 100		// number of rounds in the leaderboard of the index
+	};
+
+	ScoreHistory(const std::string& log_filename, PersistenceWorker& persistence_worker);
+	~ScoreHistory();
+
+	void set_read_only(bool enable);
+	void append_round(const round_record_t& record);
+	unsigned int get_num_rounds();
+	unsigned int get_top_rounds(unsigned int k, std::vector<round_record_t>& rounds_out);
+	bool get_day_summary(unsigned int day, day_summary_t& summary_out);
+	bool get_setting_summary(char boundary_id, unsigned int num_words_spawn, setting_summary_t& summary_out);
+	unsigned int get_rounds_of_day(unsigned int day, std::vector<round_record_t>& rounds_out);
+	int compact();
+
+	static unsigned int get_day(sf::Int64 timestamp);
+
+private:
+	enum file_format	// version and sizes (in bytes) of the file formats
+	{
+		FORMAT_VERSION = 1,
+		LOG_HEADER_LENGTH = 8,		// magic, format version and record length
+		RECORD_LENGTH = 32,			// one round in the log. the last 4 bytes are the CRC32 of the record
+		CHECKSUM_LENGTH = 4
+	};
+
+	std::string log_filename;			// path of the score log
+	std::string index_filename;			// path of the sidecar index
+	PersistenceWorker* persistence;		// writes the log and the index in the background
+	bool read_only;						// if true, no rounds are stored and the files are not changed
+	bool log_opened;					// true after the log was opened by open_log()
+	MappedFile log_mapping;				// the log mapped into memory. opened again when records are read that were appended after the mapping
+
+	// content of the index. always up to date with the log (including the rounds that are queued in the PersistenceWorker)
+	unsigned int num_records;							// number of records in the log
+	std::vector<round_record_t> top_rounds;				// leaderboard. the best rounds sorted by score (descending). at most TOP_K
+	std::map<unsigned int, day_summary_t> days;			// summary of every day. key: day
+	std::map<unsigned int, setting_summary_t> settings;	// summary of every combination of settings. key: see get_setting_key()
+
+	void open_log();
+	void init_log();
+	void clear_index();
+	void add_to_index(const round_record_t& record, unsigned int record_index);
+	int load_index();
+	void save_index();
+	int read_log(unsigned int first_record, bool& log_broken);
+	const char* map_records(unsigned int first_record, unsigned int num);
+
+	static unsigned int get_setting_key(char boundary_id, unsigned int num_words_spawn);
+	static void serialize_record(const round_record_t& record, char* buffer);
+	static bool deserialize_record(const char* buffer, round_record_t& record);
+};
+
+#endif // _SCOREHISTORY_HPP_
@@ -0,0 +1,31 @@
+#ifndef _SPLASHSCREEN_HPP_
+#define _SPLASHSCREEN_HPP_
+
+#include "Entity.h"
+#include "GameSettings.h"
+
+
+// The Splash Screen is shown at the start of the Program while the first font is loaded (see AssetLoader). it only shows a progress bar, because no text can be drawn without a font.
+// when the font is loaded, the Start Screen is shown. the other assets are loaded in the background while the Start Screen is shown
+// The class SplashScreen inherits from Entity
+class SplashScreen : public Entity
+{
+public:
+	SplashScreen(GameSettings& game_settings);
+	virtual ~SplashScreen();
+
+	virtual void update();
+	virtual void update_physics();
+	virtual void draw_on_window(DrawCommandBuffer& target);
+	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
+	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
+	virtual bool is_animating();
+	virtual const char* get_entity_name();
+
+private:
+	sf::RectangleShape progress_outline;	// outline of the progress bar
+	sf::RectangleShape progress_bar;		// filled part of the progress bar. the width is the share of the load phases that are done
+	GameSettings* settings;					// pointer to the game settings
+};
+
+#endif // _SPLASHSCREEN_HPP_
@@ -0,0 +1,64 @@
+#ifndef _STATSSCREEN_HPP_
+#define _STATSSCREEN_HPP_
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Entity.h"
+#include "Button.h"
+#include "GameSettings.h"
+
+
+// The StatsScreen inherits from Entity
+// The Stats Screen displays the typing analytics of all recorded keystrokes (see KeystrokeRecorder): the letters with the most errors,
+// the slowest pairs of letters and the typing speed of the last days. The statistics are calculated once when the screen is opened.
+// the queries decode the whole keystroke file, so they run in a background thread and the screen shows "loading..." until the results are there (see update())
+class StatsScreen : public Entity
+{
+public:
+	StatsScreen(GameSettings& game_settings);
+	virtual ~StatsScreen();
+
+	virtual void update();
+	virtual void update_physics();
+	virtual void key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt);
+	virtual void mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt);
+	virtual void draw_on_window(DrawCommandBuffer& target);
+	virtual bool is_animating();
+	virtual const char* get_entity_name();
+
+private:
+	enum Text_id	// defines an ID for every Text on the Screen
+	{
+		LETTER_TXT = 0,
+		BIGRAM_TXT,
+		WPM_TXT,
+		NUM_TEXTS
+	};
+
+	enum list_size
+	{
+		NUM_LIST_ENTRIES = 10,	// maximum number of lines of every list
+		MIN_BIGRAM_KEYS = 5		// pairs of letters that were typed less often are not shown, because their average is not meaningful
+	};
+
+	Button back_btn;
+	sf::Text title;
+	sf::Text stats_text[NUM_TEXTS];
+	GameSettings* settings;	// pointer to the game settings
+
+	// results of the queries. written by the query thread until query_done is set, afterwards only used by the main thread
+	std::vector<letter_stat_t> letter_stats;
+	std::vector<bigram_stat_t> bigram_stats;
+	std::vector<wpm_point_t> wpm_points;
+	std::atomic<bool> query_done;	// set by the query thread when all results are stored
+	bool stats_shown;				// true if the texts show the results. only used by the main thread
+	std::thread query_thread;		// runs query_task(). must be the last member, because the thread uses the other members
+
+	void query_task();
+	void init_letter_text();
+	void init_bigram_text();
+	void init_wpm_text();
+};
+
+#endif // _STATSSCREEN_HPP_
@@ -0,0 +1,30 @@
+#ifndef _STRESSTEST_HPP_
+#define _STRESSTEST_HPP_
+
+#include <string>
+#include "GameSettings.h"
+#include "FrameCapture.h"
+
+
+// configuration of the stress test. Can be set with command line arguments (see parse_stress_args())
+// The stress test ramps the number of words on the Playfield in steps (1-3-10 sequence) from min_words to max_words
+// and measures the cost of every subsystem at every step. The result is a scaling curve that shows where a subsystem stops scaling linearly.
+typedef struct stress_config
+{
+	unsigned int min_words;			// number of words of the first step
+	unsigned int max_words;			// number of words of the last step
+	float step_seconds;				// simulated time every step is held. in seconds
+	float tick_ms;					// simulated time step of one tick (one update() and update_physics() call). in milliseconds
+	float words_per_minute;			// typing speed of the TypistBot that generates the key events
+	int boundary_id;				// playfield boundary (see SettingsFileParser::p_bound)
+	unsigned int seed;				// seed for rand(). the same seed gives the same word positions
+	bool draw;						// if the Playfield is drawn into a RenderTexture to measure the rendering
+	std::string csv_filename;		// if not empty, the scaling curve is written to this file in CSV format
+	std::string report_filename;	// if not empty, the scaling curve and the scaling analysis are written to this file in JSON format
+	FrameCapture::capture_config_t capture;	// if the path is not empty, the drawn frames are captured (see FrameCapture.h)
+} stress_config_t;
+
+int parse_stress_args(int argc, char* argv[], stress_config_t& config);
+int run_stress_test(GameSettings& settings, const stress_config_t& config);
+
+#endif // _STRESSTEST_HPP_
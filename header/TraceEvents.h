@@ -0,0 +1,44 @@
+#ifndef _TRACEEVENTS_HPP_
+#define _TRACEEVENTS_HPP_
+
+#include <string>
+#include "SFML/System.hpp"
+
+
+// Records scoped zones (name, start time, duration) of every thread and writes them to a file in the Chrome trace event format.
+// The file can be opened with chrome://tracing or https://ui.perfetto.dev
+// The zones are only recorded if the game is compiled with TYPING_GAME_TRACE defined (CMake option TYPING_GAME_TRACE).
+// Otherwise all TRACE_ macros are empty and cost nothing.
+// Every thread records into its own buffer, so recording a zone doesn't need a lock. The buffers grow in chunks and are kept until the program exits.
+
+#ifdef TYPING_GAME_TRACE
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_ZONE(zone_name) TraceZone TRACE_CONCAT(trace_zone_, __LINE__)(zone_name)	// records a zone from here to the end of the current scope. zone_name must be a string literal
+#define TRACE_THREAD_NAME(thread_name) trace_set_thread_name(thread_name)				// name of the current thread in the trace. thread_name must be a string literal
+#define TRACE_WRITE_FILE(filename) trace_write_file(filename)							// write all zones recorded so far to a file
+#else
+#define TRACE_ZONE(zone_name) ((void)0)
+#define TRACE_THREAD_NAME(thread_name) ((void)0)
+#define TRACE_WRITE_FILE(filename) ((void)0)
+#endif
+
+#define TRACE_FILENAME "typing_game_trace.json"	// file that is written on exit and with the F4 key
+
+
+// records the time from its construction to its destruction as a zone in the buffer of the current thread. use it with TRACE_ZONE()
+class TraceZone
+{
+public:
+	TraceZone(const char* zone_name);
+	~TraceZone();
+
+private:
+	const char* name;		// name of the zone. must be a string literal, because only the pointer is stored
+	sf::Int64 start_us;		// start time of the zone. in microseconds since the start of the trace
+};
+
+void trace_set_thread_name(const char* thread_name);
+int trace_write_file(const std::string& filename);
+
+#endif // _TRACEEVENTS_HPP_
@@ -0,0 +1,63 @@
+#ifndef _WORDINDEX_HPP_
+#define _WORDINDEX_HPP_
+
+#include <vector>
+
+
+// sorts the words of a word list into buckets by word length, letter set and difficulty tier, so a word with given properties can be chosen in constant time.
+// the buckets are stored one after another in one array. the order is tier, letter set, length (innermost),
+// so all words of one tier and letter set with a range of lengths are next to each other and a random word of the range is chosen with one random number.
+// the index is built while the word list is read: add_word() for every word and finish() at the end.
+// difficulty: every character has a cost (common lowercase letters are cheap, rare letters, uppercase letters, digits and other characters are expensive).
+// the tier is taken from the average cost of the characters of the word (see get_tier()). the length is not part of the tier.
+class WordIndex
+{
+public:
+	enum index_size
+	{
+		MAX_LENGTH = 16,	// longer words are put in the bucket of this length
+		NUM_TIERS = 5		// tier 0: easiest words. tier NUM_TIERS - 1: hardest words
+	};
+
+	enum letter_set		// the kind of characters of a word
+	{
+		LOWER_CASE = 0,		// only lowercase letters a-z
+		MIXED_CASE,			// at least one uppercase letter, otherwise only letters
+		SYMBOLS,			// at least one digit or other character
+		NUM_LETTER_SETS
+	};
+
+	enum letter_set_mask	// bit masks to select letter sets in get_word(). (1 << letter_set)
+	{
+		LOWER_CASE_MASK = 1,
+		MIXED_CASE_MASK = 2,
+		SYMBOLS_MASK = 4,
+		ALL_LETTER_SETS = 7
+	};
+
+	WordIndex();
+
+	void clear();
+	void add_word(unsigned int word, const char* letters, unsigned int length);
+	void finish();
+	int get_word(unsigned int min_length, unsigned int max_length, unsigned int tier, unsigned int letter_sets = ALL_LETTER_SETS) const;
+	unsigned int get_num_words(unsigned int min_length, unsigned int max_length, unsigned int tier, unsigned int letter_sets = ALL_LETTER_SETS) const;
+
+	static unsigned int get_tier(const char* letters, unsigned int length);
+	static unsigned int get_letter_set(const char* letters, unsigned int length);
+
+private:
+	enum bucket_count
+	{
+		NUM_BUCKETS = NUM_TIERS * NUM_LETTER_SETS * MAX_LENGTH
+	};
+
+	std::vector<unsigned int> bucket_start;					// start of every bucket in words. NUM_BUCKETS + 1 entries
+	std::vector<unsigned int> words;						// index of every word in the word list, sorted by bucket
+	std::vector<std::vector<unsigned int> > new_words;		// words of every bucket while the index is built. empty after finish()
+
+	static unsigned int get_bucket(unsigned int tier, unsigned int letter_set, unsigned int length);
+	unsigned int get_range(unsigned int min_length, unsigned int max_length, unsigned int tier, unsigned int letter_set, unsigned int& first) const;
+};
+
+#endif // _WORDINDEX_HPP_
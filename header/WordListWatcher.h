@@ -0,0 +1,65 @@
+#ifndef _WORDLISTWATCHER_HPP_
+#define _WORDLISTWATCHER_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "SFML/System.hpp"
+#include "CSVParser.h"
+#include "WordSampler.h"
+
+
+// loads the word list once for the whole game and reloads it in a background thread when the file is changed (e.g. while the word list is edited during a playtest).
+// the file is watched with inotify on linux (the directory is watched, because editors often replace the file instead of writing it). on other systems the modification time is polled.
+// the current word list is published as a shared_ptr with std::atomic_store and read with std::atomic_load, so a reader always gets a complete word list.
+// the word list is published together with the words of its letters for the WordSampler, which are built in the watch thread too. so the game thread only swaps the pointer after a reload.
+// the characters outside of the printable ASCII range (which the FontManager doesn't warm) are collected in the watch thread as well, so the game thread only renders these few glyphs
+// a reader keeps its copy of the shared_ptr as long as it uses the word list. the old word list is deleted when the last reader releases it.
+// if the changed file can't be read or is malformed, the previous word list stays active. the result of every reload is reported with get_status_msg()
+class WordListWatcher
+{
+public:
+	// a loaded word list with everything that only depends on the words. published as a whole, so the indexes always fit to the words
+	typedef struct word_list_snapshot
+	{
+		CSVParser words;
+		WordSampler::letter_index_t letter_index;	// see WordSampler::build_index()
+		sf::String glyphs;			// every character of the words that is not printable ASCII, once. rendered by the game thread before the words are shown (see FontManager::warm_string())
+	} word_list_snapshot_t;
+
+	WordListWatcher();
+	~WordListWatcher();
+
+	void load(const std::string& file_name, char delimiter, int column);
+	std::shared_ptr<const word_list_snapshot_t> get_snapshot() const;
+	std::shared_ptr<const CSVParser> get_word_list() const;
+	bool get_status_msg(std::string& msg);
+	bool has_status_msg();
+
+private:
+	enum watch_timing
+	{
+		POLL_INTERVAL_MS = 100,		// how often the watch thread checks for file changes and the termination. in milliseconds
+		SETTLE_DELAY_MS = 200		// the file is reloaded when no more changes occurred in this time (editors often write a file in several steps). in milliseconds
+	};
+
+	std::string csv_filename;						// path of the word list
+	char csv_delimiter;
+	int csv_column;
+	std::shared_ptr<const word_list_snapshot_t> snapshot;	// current word list. only accessed with std::atomic_load and std::atomic_store
+	std::mutex status_mutex;						// protects status_msg and new_status
+	std::string status_msg;							// result of the last reload
+	bool new_status;								// true if status_msg was not queried yet
+	std::atomic<bool> stop;							// signals the watch thread to terminate
+	std::thread watch_thread;
+
+	void watch_task();
+	void reload();
+	void set_status_msg(const std::string& msg);
+	std::shared_ptr<word_list_snapshot_t> read_snapshot();
+	static void collect_glyphs(const CSVParser& words, sf::String& glyphs);
+};
+
+#endif // _WORDLISTWATCHER_HPP_
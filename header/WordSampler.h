@@ -0,0 +1,70 @@
+#ifndef _WORDSAMPLER_HPP_
+#define _WORDSAMPLER_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "CSVParser.h"
+
+
+// chooses the words of the Playfield from a word list depending on the skill of the player (adaptive difficulty).
+// Every letter has an error rate that is updated with every keystroke (recent keystrokes count more). A word is chosen in two steps:
+// 1. choose a letter with a probability proportional to its error rate (or with ADAPTIVE_SHARE percent probability any word, so all words still appear)
+// 2. choose a random word that contains this letter from the list of words of this letter
+// The letters are stored in a Fenwick tree (binary indexed tree), so a letter can be chosen and its weight changed in log2(256) = 8 steps.
+// The words of every letter are stored in one array (like an offset table), so step 2 doesn't depend on the size of the word list.
+// The word length is controlled by a target length that grows with every typed word and shrinks with every missed word.
+// A chosen word is accepted with a probability that decreases with its distance to the target length (rejection sampling with at most MAX_TRIES tries).
+// So choosing a word takes constant time, also for word lists with millions of words. Only build_index() depends on the size of the word list.
+// The words of the letters only depend on the word list, so they are built once per word list (the WordListWatcher builds them in its background thread) and shared by every WordSampler that uses the word list.
+class WordSampler
+{
+public:
+	// the words of every letter and the lengths of the words of a word list. built by build_index() and not changed afterwards
+	typedef struct letter_index
+	{
+		unsigned int num_words;							// number of words in the word list
+		std::vector<unsigned int> letter_word_start;	// start of the words of every letter in letter_words. NUM_LETTERS + 1 entries
+		std::vector<unsigned int> letter_words;			// index of every word that contains a letter, sorted by letter. a word is stored once per different letter
+		std::vector<unsigned char> word_lengths;		// length of every word (at most 255)
+		float min_length;								// length of the shortest word
+		float max_length;								// length of the longest word
+		float average_length;							// average length of the words
+	} letter_index_t;
+
+	WordSampler();
+
+	void init(const CSVParser& word_list);
+	void init(const std::shared_ptr<const letter_index_t>& word_index);
+	void set_word_list(const std::shared_ptr<const letter_index_t>& word_index);
+	unsigned int get_word_index();
+	void record_keystroke(char expected, bool correct);
+	void record_typed_word(unsigned int length);
+	void record_missed_word(const std::string& word);
+	float get_error_rate(char letter);
+	float get_target_length();
+	static void build_index(const CSVParser& word_list, letter_index_t& word_index);
+
+private:
+	enum sampler_config
+	{
+		NUM_LETTERS = 256,		// one entry for every possible byte
+		MAX_TRIES = 8,			// maximum number of words that are tried for the word length
+		ADAPTIVE_SHARE = 70		// in percent. probability that a word is chosen by the error rate of a letter instead of uniformly
+	};
+
+	std::shared_ptr<const letter_index_t> index;	// the words of the letters of the current word list. never NULL
+	float letter_keys[NUM_LETTERS];					// number of recent keystrokes for every letter (older keystrokes count less)
+	float letter_errors[NUM_LETTERS];				// number of recent wrong keystrokes for every letter
+	double letter_weights[NUM_LETTERS];				// current weight of every letter in the Fenwick tree
+	double letter_tree[NUM_LETTERS + 1];			// Fenwick tree of the letter weights. index 0 is unused
+	float target_length;							// preferred word length
+
+	void update_letter(unsigned char letter, float keys, float errors);
+	void set_letter_weight(unsigned char letter, double weight);
+	int find_letter(double value);
+	float length_acceptance(unsigned int length);
+	static double random_unit();
+};
+
+#endif // _WORDSAMPLER_HPP_
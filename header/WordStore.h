@@ -0,0 +1,74 @@
+#ifndef _WORDSTORE_HPP_
+#define _WORDSTORE_HPP_
+
+#include <string>
+#include <vector>
+
+
+// interface of the memory representation of a word list. the CSVParser stores the values of the file in a WordStore and gets its words from it.
+// every word has an ordinal (index) between 0 and get_num_words() - 1. a WordStore is not changed after it is built, so it can be shared between copies of the CSVParser
+class WordStore
+{
+public:
+	virtual ~WordStore() {}
+
+	virtual unsigned int get_num_words() const = 0;
+	virtual void get_word(unsigned int index, std::string& word) const = 0;
+	virtual int find_word(const char* letters, unsigned int length) const = 0;
+	virtual size_t get_memory_size() const = 0;
+};
+
+// the words one after another in one buffer and an offset table with the start of every word. the words keep the order of the file.
+// random access is one lookup in the offset table. find_word() has to compare every word, because the words are not sorted
+class OffsetTableStore : public WordStore
+{
+public:
+	OffsetTableStore();
+
+	void add_word(const char* letters, unsigned int length);
+	void finish();
+
+	unsigned int get_num_words() const;
+	void get_word(unsigned int index, std::string& word) const;
+	int find_word(const char* letters, unsigned int length) const;
+	size_t get_memory_size() const;
+
+private:
+	std::vector<char> word_data;				// all words one after another
+	std::vector<unsigned int> word_offsets;		// start of every word in word_data. the last entry is the size of word_data, so word i ends at word_offsets[i + 1]
+};
+
+// compressed word list for huge dictionaries. the words are sorted and every word is stored only once.
+// the sorted words are split into blocks of BLOCK_SIZE words. the first word of a block is stored completely,
+// every other word only stores the number of letters that it shares with the previous word (front coding) and the remaining letters.
+// lengths are stored as variable length numbers (see append_varint() in ByteOrder.h). the sparse block index contains the start of every block.
+// random access decodes at most BLOCK_SIZE words of one block. find_word() uses a binary search over the first words of the blocks
+class FrontCodedStore : public WordStore
+{
+public:
+	enum block_size
+	{
+		BLOCK_SIZE = 16		// words per block. bigger blocks need less memory, but the random access gets slower
+	};
+
+	FrontCodedStore();
+
+	void add_word(const char* letters, unsigned int length);
+	void finish();
+
+	unsigned int get_num_words() const;
+	void get_word(unsigned int index, std::string& word) const;
+	int find_word(const char* letters, unsigned int length) const;
+	size_t get_memory_size() const;
+
+private:
+	unsigned int num_words;
+	std::vector<char> block_data;				// all blocks one after another
+	std::vector<unsigned int> block_offsets;	// start of every block in block_data. the last entry is the size of block_data
+	std::string last_word;						// the last added word. only used while the store is built
+
+	const char* get_first_word(unsigned int block, unsigned int& length) const;
+	static const char* read_next_word(const char* data, const char* data_end, std::string& word);
+};
+
+#endif // _WORDSTORE_HPP_
@@ -0,0 +1,148 @@
+#include <sstream>
+#include <iomanip>
+#include "AssetLoader.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// default Constructor. nothing is loaded until start() is called
+AssetLoader::AssetLoader()
+{
+	num_done = 0;
+	stop = false;
+}
+
+// Destructor. the running phase is finished, the remaining phases are skipped
+AssetLoader::~AssetLoader()
+{
+	{
+		lock_guard<mutex> lock(state_mutex);
+		stop = true;
+	}
+	if (load_thread.joinable())
+		load_thread.join();
+}
+
+// add a phase. must be called before start()
+// name: input. name of the phase in the report (e.g. "textures")
+// task: input. function that loads the assets of the phase. is called in the load thread
+// return: id of the phase. the ids are assigned in the order the phases are added, starting with 0
+unsigned int AssetLoader::add_phase(const string& name, const function<void()>& task)
+{
+	load_phase_t phase;
+	phase.name = name;
+	phase.task = task;
+	phases.push_back(phase);
+	return (unsigned int)phases.size() - 1;
+}
+
+// set the function that is called in the load thread when the remaining phases are skipped (after a failed phase or when the AssetLoader is destroyed).
+// it must release every thread that waits for an asset of a skipped phase without using wait_for(). must be called before start()
+// handler: input. the function
+void AssetLoader::set_skip_handler(const function<void()>& handler)
+{
+	skip_handler = handler;
+}
+
+// start the load thread, which runs all phases in the order they were added
+void AssetLoader::start()
+{
+	if (!load_thread.joinable())
+		load_thread = thread(&AssetLoader::load_task, this);
+}
+
+// returns true if the phase is done (or was skipped because an earlier phase failed). doesn't wait
+bool AssetLoader::is_done(unsigned int phase)
+{
+	lock_guard<mutex> lock(state_mutex);
+	return phase < num_done;
+}
+
+// returns true if all phases are done. doesn't wait
+bool AssetLoader::is_finished()
+{
+	lock_guard<mutex> lock(state_mutex);
+	return num_done >= phases.size();
+}
+
+// wait until the phase is done. rethrows the exception of a failed phase
+void AssetLoader::wait_for(unsigned int phase)
+{
+	unique_lock<mutex> lock(state_mutex);
+	state_cv.wait(lock, [&]() { return phase < num_done || num_done >= phases.size(); });
+	if (error)
+		rethrow_exception(error);
+}
+
+// rethrows the exception of a failed phase. does nothing if no phase failed (yet). doesn't wait
+void AssetLoader::rethrow_error()
+{
+	lock_guard<mutex> lock(state_mutex);
+	if (error)
+		rethrow_exception(error);
+}
+
+// returns the share of the phases that are done. 0...1
+float AssetLoader::get_progress()
+{
+	lock_guard<mutex> lock(state_mutex);
+	return phases.empty() ? 1.f : (float)num_done / phases.size();
+}
+
+// returns the duration of every phase that is done and the time from start() until the end of the last done phase, e.g.:
+// "Startup: font 31.2 ms, textures 2.1 ms, word list 4.0 ms, all fonts 70.3 ms, done after 107.6 ms"
+string AssetLoader::get_report()
+{
+	lock_guard<mutex> lock(state_mutex);
+	ostringstream report;
+	report << fixed << setprecision(1) << "Startup:";
+	for (unsigned int i = 0; i < num_done && i < phases.size(); i++)
+		report << (i > 0 ? ", " : " ") << phases[i].name << " " << phases[i].duration.asMicroseconds() / 1000.0 << " ms";
+	if (num_done > 0)
+		report << ", done after " << phases[num_done - 1].end_time.asMicroseconds() / 1000.0 << " ms";
+	return report.str();
+}
+
+// In this task all phases are run one after another. after a failed phase the remaining phases are marked as done without running them and the skip handler is called
+void AssetLoader::load_task()
+{
+	TRACE_THREAD_NAME("asset loader");
+	sf::Clock start_clock;
+	unsigned int i;
+	for (i = 0; i < phases.size(); i++)
+	{
+		{
+			lock_guard<mutex> lock(state_mutex);
+			if (stop)
+				break;
+		}
+
+		exception_ptr phase_error;
+		sf::Clock phase_clock;
+		try
+		{
+			TRACE_ZONE("load phase");	// the name of the phase can't be used, because the trace only stores the pointer of a string literal
+			phases[i].task();
+		}
+		catch (...)
+		{
+			phase_error = current_exception();
+		}
+		phases[i].duration = phase_clock.getElapsedTime();
+		phases[i].end_time = start_clock.getElapsedTime();
+
+		lock_guard<mutex> lock(state_mutex);
+		num_done = i + 1;
+		if (phase_error)
+		{
+			error = phase_error;
+			num_done = (unsigned int)phases.size();		// the remaining phases are skipped, so no thread waits for them forever
+		}
+		state_cv.notify_all();
+		if (error)
+			break;
+	}
+
+	if (i < phases.size() && skip_handler)	// the loop was left early: phase i failed or the AssetLoader is destroyed
+		skip_handler();
+}
@@ -1,94 +1,165 @@
-#include <sstream>
-#include "CSVParser.h"
-
-using namespace std;
-
-// default Constructor. opens the file and calculates the number of Elements in the file
-CSVParser::CSVParser(const string& csv_filename, char csv_delimiter)
-	// member initializer list. fin: open file for input. in the destructor of fin the file gets closed. the destructor is called automatically when this class is destroyed
-	: fin(csv_filename)
-{
-	filename = csv_filename;
-	delimiter = csv_delimiter;
-	num_elem = 0;
-
-	if (!fin.good())	// check error state
-		return;
-
-	string row, value;
-
-	// get number of values (that are not empty) in the file
-	// getline: Extracts characters from fin and stores them into row until the newline character is found. returns fin, which is in an error state when eof is reached
-	while (getline(fin, row))
-	{
-		stringstream ss(row);	// convert row into a stream object
-		while (getline(ss, value, delimiter))		// getline: Extracts characters from ss and stores them into value until the delimiter is found
-		{
-			if (value.size() != 0)	// if the value is not empty
-				num_elem++;
-		}
-	}
-}
-
-// copy assignment operator. is called when an already initialized object is assigned a new value from another existing object
-// csvparser_orig: input. right of the '='. Class object which shall be copied to the new object
-// return: the new CSVParser object left of the '='
-CSVParser& CSVParser::operator = (const CSVParser& csvparser_orig)
-{
-	filename = csvparser_orig.filename;
-	delimiter = csvparser_orig.delimiter;
-	num_elem = csvparser_orig.num_elem;
-	// don't copy the filestream object, because its not trivial. manually open the file again instead
-	if (!fin.is_open())
-		fin.open(filename);
-
-	return *this;	// after assigning every member of the object left from the operator, return this object
-}
-
-// copy constructor. is called when a new object is created from an existing object, as a copy of the existing object
-// csvparser_orig: input. right of the '='. Class object which shall be copied to the new object
-CSVParser::CSVParser(const CSVParser& csvparser_orig)
-{
-	*this = csvparser_orig;		// use the already defined copy assignment operator
-}
-
-// return a random value in the file as a string or "_default_" if failed
-string CSVParser::get_random_elem()
-{
-	unsigned int rand_val;	// use a random number as the index of the returned value
-	string row, value;
-
-	if (num_elem == 0 || num_elem > RAND_MAX)	// if file does not exist (or no content) or too big
-	{
-		return "_default_";
-	}
-
-	rand_val = rand() % num_elem;		// note that the distribution of the output number isn't equal anymore when using modulo
-
-	fin.clear();			// reset the error bits of the streamobject (to reset the eofbit which is set when EOF was reached)
-	fin.seekg(0, fin.beg);	// set filepointer to the beginning of the file
-
-	if (!fin.good())		// check error state
-		return "_default_";
-
-	// traverse the file until rand_val (in the same way as when counting the number of values in the file)
-	for (unsigned int i = 0; i <= rand_val; )
-	{
-		getline(fin, row);		// Extracts characters from fin and stores them into row until the newline character is found
-		stringstream ss(row);	// convert row into a stream object
-		while (getline(ss, value, delimiter))		// getline: Extracts characters from ss and stores them into value until the delimiter is found
-		{
-			if (value.size() != 0)	// if the value is not empty
-			{
-				if (i == rand_val)
-				{
-					i++;
-					break;	// leave the while (and also the for loop, because i is now out of range)
-				}
-				i++;
-			}
-		}
-	}
-
-	return value;
-}
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>
+#include <string_view>
+#include "CSVParser.h"
+#include "CSVTokenizer.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// default Constructor. reads the whole file and stores all values (that are not empty) in a WordStore
+// csv_filename: input. path of the file
+// csv_delimiter: input. delimiter which separates the values in the file
+// csv_column: input. index of the column with the words (first column: 0). CSVTokenizer::ALL_COLUMNS to use every value of the file
+// store_type: input. how the values are stored in memory (see word_store_types)
+CSVParser::CSVParser(const string& csv_filename, char csv_delimiter, int csv_column, int store_type)
+{
+	TRACE_ZONE("CSVParser::CSVParser");
+	filename = csv_filename;
+	delimiter = csv_delimiter;
+	column = csv_column;
+	num_elem = 0;
+	word_store = make_shared<OffsetTableStore>();
+
+	ifstream fin(filename, ios::binary);	// open file for reading. the file gets closed in the destructor of fin
+	if (!fin.good())	// check error state
+	{
+		error_msg = filename + " can't be read";
+		return;
+	}
+
+	// read the whole file with one read
+	fin.seekg(0, fin.end);
+	streamoff file_size = fin.tellg();
+	if (file_size <= 0)
+		return;
+	vector<char> content((size_t)file_size);
+	fin.seekg(0, fin.beg);
+	fin.read(content.data(), content.size());
+	content.resize((size_t)fin.gcount());
+
+	if (store_type == AUTO_STORE)
+		store_type = (content.size() < FRONT_CODING_MIN_FILE_SIZE) ? OFFSET_TABLE_STORE : FRONT_CODED_STORE;
+
+	// split the content into fields and keep the values that are not empty
+	CSVTokenizer tokenizer(delimiter, column);
+	vector<string_view> values;
+	// every field ends at a delimiter, a line break or the end of the content, so this is an upper bound of the number of fields. reserving it avoids the copies (and the second array) while the array grows.
+	// the memory of the fields that don't exist is never written, so it doesn't use physical memory
+	char field_delimiter = delimiter;
+	values.reserve((size_t)count_if(content.begin(), content.end(), [field_delimiter](char c) { return c == field_delimiter || c == '\n'; }) + 1);
+	if (tokenizer.tokenize(content.data(), content.size(), values) < 0)
+		error_msg = filename + ": " + tokenizer.get_error_msg();
+	values.erase(remove_if(values.begin(), values.end(), [](const string_view& value) { return value.empty(); }), values.end());
+
+	// the front coded store needs the values sorted and every value only once
+	if (store_type == FRONT_CODED_STORE)
+		sort_values(values);
+
+	// store the values and put them into the buckets of the word index in the same pass
+	shared_ptr<OffsetTableStore> offset_table;
+	shared_ptr<FrontCodedStore> front_coded;
+	if (store_type == FRONT_CODED_STORE)
+		front_coded = make_shared<FrontCodedStore>();
+	else
+		offset_table = make_shared<OffsetTableStore>();
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		if (front_coded)
+			front_coded->add_word(values[i].data(), (unsigned int)values[i].size());
+		else
+			offset_table->add_word(values[i].data(), (unsigned int)values[i].size());
+		word_index.add_word((unsigned int)i, values[i].data(), (unsigned int)values[i].size());
+	}
+	// the values point into the file content, which is copied into the store now. free both before the store and the index are compacted by finish()
+	vector<string_view>().swap(values);
+	vector<char>().swap(content);
+	word_index.finish();
+
+	if (front_coded)
+	{
+		front_coded->finish();
+		word_store = front_coded;
+	}
+	else
+	{
+		offset_table->finish();
+		word_store = offset_table;
+	}
+	num_elem = word_store->get_num_words();
+}
+
+// returns the value with the given index as a string
+// index: input. index of the value. must be smaller than num_elem
+string CSVParser::get_elem(unsigned int index) const
+{
+	string value;
+	word_store->get_word(index, value);
+	return value;
+}
+
+// copy the value with the given index into a string. faster than get_elem(index) if the same string is used for many values
+// index: input. index of the value. must be smaller than num_elem
+// value: output. the value
+void CSVParser::get_elem(unsigned int index, string& value) const
+{
+	word_store->get_word(index, value);
+}
+
+// return a random value in the file as a string or "_default_" if failed
+string CSVParser::get_random_elem() const
+{
+	TRACE_ZONE("CSVParser::get_random_elem");
+	if (num_elem == 0)	// if file does not exist (or no content)
+		return "_default_";
+
+	return get_elem(random_index(num_elem));
+}
+
+// search a value. binary search in the front coded store, linear search in the offset table
+// value: input. the value to search
+// return: index of the value. -1 if the value is not in the file
+int CSVParser::find_elem(const string& value) const
+{
+	return word_store->find_word(value.data(), (unsigned int)value.size());
+}
+
+// returns a description of the first error in the file (including the line) or of a file that can't be read. empty if there was no error.
+// the values of a malformed file are read anyway (see CSVTokenizer)
+const string& CSVParser::get_error_msg() const
+{
+	return error_msg;
+}
+
+// returns the number of bytes that are used to store the values (without the word index)
+size_t CSVParser::get_memory_size() const
+{
+	return word_store->get_memory_size();
+}
+
+// returns the index of all values sorted by length, letter set and difficulty tier. the words are chosen with WordIndex::get_word()
+const WordIndex& CSVParser::get_word_index() const
+{
+	return word_index;
+}
+
+// sort values byte by byte and remove the duplicates.
+// sorted in place, so no second array with the values is allocated (the word list can have millions of values). caching the first bytes of the values as sort keys was faster, but needed 24 more bytes per value
+// values: input/ output. the values to sort
+void CSVParser::sort_values(vector<string_view>& values)
+{
+	sort(values.begin(), values.end());
+	values.erase(unique(values.begin(), values.end()), values.end());
+}
+
+// returns a random number between 0 and num - 1. uses rand(), so the numbers can be reproduced with srand().
+// if num is bigger than RAND_MAX (only 32767 on some compilers), two random numbers are combined
+// num: input. number of possible values. must be bigger than 0
+unsigned int CSVParser::random_index(unsigned int num)
+{
+	unsigned long long rand_val = (unsigned long long)rand();
+	if (num > (unsigned int)RAND_MAX)
+		rand_val = rand_val * ((unsigned long long)RAND_MAX + 1) + (unsigned long long)rand();
+	return (unsigned int)(rand_val % num);		// note that the distribution of the output number isn't equal anymore when using modulo
+}
@@ -0,0 +1,233 @@
+#include "CSVTokenizer.h"
+#include "TraceEvents.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CSV_TOKENIZER_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+enum tokenizer_block
+{
+	BLOCK_SIZE = 64		// number of bytes that are scanned at once. one bit of the special character mask per byte
+};
+
+// returns the index of the lowest set bit
+// mask: input. must not be 0
+static inline unsigned int lowest_bit(unsigned long long mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)mask))
+		return (unsigned int)index;
+	_BitScanForward(&index, (unsigned long)(mask >> 32));
+	return (unsigned int)index + 32;
+#else
+	return (unsigned int)__builtin_ctzll(mask);
+#endif
+}
+
+// Constructor
+// csv_delimiter: input. delimiter which separates the fields of a record
+// csv_column: input. index of the column whose fields are returned by tokenize() (first column: 0). ALL_COLUMNS to return every field
+CSVTokenizer::CSVTokenizer(char csv_delimiter, int csv_column)
+{
+	delimiter = csv_delimiter;
+	column = csv_column;
+}
+
+// split the content into fields. the fields of the selected column (or all fields) are returned in the order of the content. empty fields are returned too
+// data: input/ output. the content. quoted fields are unescaped in place
+// size: input. number of bytes of the content
+// fields: output. the fields. they point into data
+// return: 0 if the content is well-formed. -1 if the content is malformed (see get_error_msg()). the fields are returned in both cases
+int CSVTokenizer::tokenize(char* data, size_t size, vector<string_view>& fields)
+{
+	TRACE_ZONE("CSVTokenizer::tokenize");
+	fields.clear();
+	error_msg.clear();
+
+	size_t field_start = 0;		// first byte of the current field
+	if (size >= 3 && (unsigned char)data[0] == 0xEF && (unsigned char)data[1] == 0xBB && (unsigned char)data[2] == 0xBF)
+		field_start = 3;		// skip the UTF-8 byte order mark
+
+	bool in_quotes = false;		// true between the opening and the closing quotation mark of a field
+	bool field_quoted = false;	// true if the current field starts with a quotation mark
+	size_t skip_until = field_start;	// special characters before this position are already processed (second quotation mark of "", "\n" of "\r\n")
+	int cur_column = 0;
+	size_t line = 1;			// line of the current position. used for the error messages
+
+	for (size_t block_start = 0; block_start < size; block_start += BLOCK_SIZE)
+	{
+		unsigned long long mask = get_special_chars(data + block_start, (size - block_start < BLOCK_SIZE) ? size - block_start : (size_t)BLOCK_SIZE, delimiter);
+		while (mask != 0)
+		{
+			size_t pos = block_start + lowest_bit(mask);
+			mask &= mask - 1;	// clear the lowest set bit
+			if (pos < skip_until)
+				continue;
+
+			char special_char = data[pos];
+			if (special_char == '\n')
+				line++;
+
+			if (in_quotes)		// only a quotation mark can end a quoted field
+			{
+				if (special_char != '"')
+					continue;
+				if (pos + 1 < size && data[pos + 1] == '"')		// escaped quotation mark
+					skip_until = pos + 2;
+				else
+					in_quotes = false;
+				continue;
+			}
+
+			if (special_char == '"')
+			{
+				if (pos == field_start)
+				{
+					in_quotes = true;
+					field_quoted = true;
+				}
+				else if (!field_quoted)
+					set_error("quotation mark in an unquoted field", line);
+				else
+					in_quotes = true;	// quotation mark after the closing quotation mark. the error is detected in unescape_field()
+				continue;
+			}
+
+			// end of the field (delimiter or line end)
+			if (column == ALL_COLUMNS || cur_column == column)
+			{
+				size_t length = pos - field_start;
+				if (field_quoted)
+					length = unescape_field(data + field_start, length, line);
+				fields.push_back(string_view(data + field_start, length));
+			}
+			field_quoted = false;
+
+			if (special_char == delimiter)
+			{
+				cur_column++;
+			}
+			else	// line end
+			{
+				cur_column = 0;
+				if (special_char == '\r' && pos + 1 < size && data[pos + 1] == '\n')
+				{
+					skip_until = pos + 2;
+					line++;
+					field_start = pos + 2;
+					continue;
+				}
+			}
+			field_start = pos + 1;
+		}
+	}
+
+	if (in_quotes)
+		set_error("missing closing quotation mark", line);
+	// the last field if the content doesn't end with a line end
+	if (field_start < size || field_quoted)
+	{
+		if (column == ALL_COLUMNS || cur_column == column)
+		{
+			size_t length = size - field_start;
+			if (field_quoted)
+				length = unescape_field(data + field_start, length, line);
+			fields.push_back(string_view(data + field_start, length));
+		}
+	}
+
+	return error_msg.empty() ? 0 : -1;
+}
+
+// returns the description of the first error in the content of the last tokenize(), including the line. empty if there was no error
+const string& CSVTokenizer::get_error_msg() const
+{
+	return error_msg;
+}
+
+// create a bit mask with the positions of the delimiters, quotation marks, "\n" and "\r" in a block
+// data: input. first byte of the block
+// size: input. number of bytes of the block. at most BLOCK_SIZE
+// delimiter: input. delimiter of the fields
+// return: bit i is set if byte i is a special character
+unsigned long long CSVTokenizer::get_special_chars(const char* data, size_t size, char delimiter)
+{
+	unsigned long long mask = 0;
+	size_t i = 0;
+#ifdef CSV_TOKENIZER_SSE2
+	if (size == BLOCK_SIZE)
+	{
+		const __m128i delimiters = _mm_set1_epi8(delimiter);
+		const __m128i quotes = _mm_set1_epi8('"');
+		const __m128i line_feeds = _mm_set1_epi8('\n');
+		const __m128i carriage_returns = _mm_set1_epi8('\r');
+		for (; i < BLOCK_SIZE; i += 16)
+		{
+			__m128i bytes = _mm_loadu_si128((const __m128i*)(data + i));
+			__m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, delimiters), _mm_cmpeq_epi8(bytes, quotes)),
+				_mm_or_si128(_mm_cmpeq_epi8(bytes, line_feeds), _mm_cmpeq_epi8(bytes, carriage_returns)));
+			mask |= (unsigned long long)(unsigned int)_mm_movemask_epi8(special) << i;
+		}
+		return mask;
+	}
+#endif
+	// last block of the content (or no SSE2)
+	for (; i < size; i++)
+	{
+		char byte = data[i];
+		if (byte == delimiter || byte == '"' || byte == '\n' || byte == '\r')
+			mask |= 1ULL << i;
+	}
+	return mask;
+}
+
+// remove the quotation marks of a quoted field in place. two quotation marks in the field are one quotation mark of the value
+// field: input/ output. first byte of the field (the opening quotation mark). the value is written to the start of the field
+// length: input. number of bytes of the field
+// line: input. line of the field end. used for the error message
+// return: number of bytes of the value
+size_t CSVTokenizer::unescape_field(char* field, size_t length, size_t line)
+{
+	size_t value_length = 0;
+	bool in_quotes = false;
+	for (size_t i = 0; i < length; i++)
+	{
+		if (field[i] == '"')
+		{
+			if (in_quotes && i + 1 < length && field[i + 1] == '"')
+			{
+				field[value_length++] = '"';
+				i++;
+			}
+			else
+			{
+				if (!in_quotes && i > 0)
+					set_error("quotation mark after a quoted value", line);
+				in_quotes = !in_quotes;
+			}
+		}
+		else
+		{
+			if (!in_quotes)
+				set_error("characters after a quoted value", line);
+			field[value_length++] = field[i];
+		}
+	}
+	return value_length;
+}
+
+// store an error message if no error was found before in the content
+// msg: input. description of the error
+// line: input. line of the error
+void CSVTokenizer::set_error(const string& msg, size_t line)
+{
+	if (error_msg.empty())
+		error_msg = msg + " in line " + to_string(line);
+}
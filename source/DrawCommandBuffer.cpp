@@ -0,0 +1,223 @@
+#include "DrawCommandBuffer.h"
+#include "RenderLayer.h"
+#include "RenderBackend.h"
+#include "Entity.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor. the buffer is empty
+// target_size: input. size of the target that the buffer is replayed on. returned by getSize()
+// mouse_window: input. the window that the buffer is replayed on. NULL for offscreen targets (the Buttons keep their hover state then)
+DrawCommandBuffer::DrawCommandBuffer(const sf::Vector2u& target_size, const sf::Window* mouse_window)
+{
+	size = target_size;
+	window = mouse_window;
+	owner = NULL;
+	num_texts = 0;
+	num_rectangles = 0;
+	num_circles = 0;
+	num_sprites = 0;
+}
+
+// remove all commands to record a new frame. the memory of the commands and the copied drawables is kept
+void DrawCommandBuffer::reset()
+{
+	commands.clear();
+	vertices.clear();
+	owner = NULL;
+	num_texts = 0;
+	num_rectangles = 0;
+	num_circles = 0;
+	num_sprites = 0;
+}
+
+// record clearing the target
+// color: input. fill color of the target
+void DrawCommandBuffer::clear(const sf::Color& color)
+{
+	add_command(CLEAR, 0, sf::RenderStates::Default).color = color;
+}
+
+// record drawing a text. the glyph geometry of the copy is built here, so the replay doesn't load glyphs
+// text: input. text to draw (e.g. a Word)
+// states: input. render states of the draw call
+void DrawCommandBuffer::draw(const sf::Text& text, const sf::RenderStates& states)
+{
+	unsigned int index = add_to_pool(texts, num_texts, text);
+	texts[index].getLocalBounds();		// builds the geometry, if the text was changed after its last draw
+	add_command(TEXT, index, states);
+}
+
+// record drawing a rectangle
+// shape: input. rectangle to draw
+// states: input. render states of the draw call
+void DrawCommandBuffer::draw(const sf::RectangleShape& shape, const sf::RenderStates& states)
+{
+	add_command(RECTANGLE, add_to_pool(rectangles, num_rectangles, shape), states);
+}
+
+// record drawing a circle
+// shape: input. circle to draw
+// states: input. render states of the draw call
+void DrawCommandBuffer::draw(const sf::CircleShape& shape, const sf::RenderStates& states)
+{
+	add_command(CIRCLE, add_to_pool(circles, num_circles, shape), states);
+}
+
+// record drawing a sprite
+// sprite: input. sprite to draw. its texture must exist until the buffer is replayed
+// states: input. render states of the draw call
+void DrawCommandBuffer::draw(const sf::Sprite& sprite, const sf::RenderStates& states)
+{
+	add_command(SPRITE, add_to_pool(sprites, num_sprites, sprite), states);
+}
+
+// record drawing an array of vertices. the vertices are copied
+// vertices_in: input. first vertex
+// num_vertices: input. number of vertices
+// type: input. type of the primitives
+// states: input. render states of the draw call. the texture must exist until the buffer is replayed
+void DrawCommandBuffer::draw(const sf::Vertex* vertices_in, size_t num_vertices, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+	if (vertices_in == NULL || num_vertices == 0)
+		return;
+
+	draw_command_t& command = add_command(VERTICES, (unsigned int)vertices.size(), states);
+	command.num_vertices = (unsigned int)num_vertices;
+	command.primitive = type;
+	vertices.insert(vertices.end(), vertices_in, vertices_in + num_vertices);
+}
+
+// record the start of the content of a RenderLayer. every command until end_layer() is drawn on the render texture of the layer (see RenderLayer::begin())
+// layer: input. layer with a render texture
+void DrawCommandBuffer::begin_layer(RenderLayer& layer)
+{
+	add_command(LAYER_BEGIN, 0, sf::RenderStates::Default).layer = &layer;
+}
+
+// record the end of the content of a RenderLayer
+// layer: input. the layer of the last begin_layer()
+void DrawCommandBuffer::end_layer(RenderLayer& layer)
+{
+	add_command(LAYER_END, 0, sf::RenderStates::Default).layer = &layer;
+}
+
+// record drawing the cached content of a RenderLayer
+// layer: input. layer with a render texture
+void DrawCommandBuffer::draw_layer(RenderLayer& layer)
+{
+	add_command(LAYER_DRAW, 0, sf::RenderStates::Default).layer = &layer;
+}
+
+// record the draw calls of an Entity (calls its draw_on_window()). the commands are counted for the type of the Entity, also if it is drawn by another Entity (e.g. the Words of the Playfield)
+// entity: input. the Entity to draw
+void DrawCommandBuffer::draw_entity(Entity& entity)
+{
+	const char* parent_owner = owner;
+	owner = entity.get_entity_name();
+	entity.draw_on_window(*this);
+	owner = parent_owner;
+}
+
+// returns the size of the target that the buffer is replayed on
+sf::Vector2u DrawCommandBuffer::getSize() const
+{
+	return size;
+}
+
+// returns the window that the buffer is replayed on. NULL for offscreen targets
+const sf::Window* DrawCommandBuffer::get_window() const
+{
+	return window;
+}
+
+// returns the number of recorded commands
+unsigned int DrawCommandBuffer::get_num_commands() const
+{
+	return (unsigned int)commands.size();
+}
+
+// draw every recorded command on a render backend in the order they were recorded. display() of the backend is not called
+// backend: input. the window, an offscreen texture or a counting backend. must have the size given to the constructor
+void DrawCommandBuffer::replay(RenderBackend& backend) const
+{
+	TRACE_ZONE("DrawCommandBuffer::replay");
+	const char* current_owner = NULL;
+	backend.set_owner(NULL);
+
+	for (vector<draw_command_t>::const_iterator command_it = commands.begin(); command_it != commands.end(); command_it++)
+	{
+		if (command_it->owner != current_owner)
+		{
+			current_owner = command_it->owner;
+			backend.set_owner(current_owner);
+		}
+
+		switch (command_it->type)
+		{
+		case CLEAR:
+			backend.clear(command_it->color);
+			break;
+		case TEXT:
+			backend.draw(texts[command_it->index], command_it->states);
+			break;
+		case RECTANGLE:
+			backend.draw(rectangles[command_it->index], command_it->states);
+			break;
+		case CIRCLE:
+			backend.draw(circles[command_it->index], command_it->states);
+			break;
+		case SPRITE:
+			backend.draw(sprites[command_it->index], command_it->states);
+			break;
+		case VERTICES:
+			backend.draw(&vertices[command_it->index], command_it->num_vertices, command_it->primitive, command_it->states);
+			break;
+		case LAYER_BEGIN:
+			backend.begin_layer(*command_it->layer);
+			break;
+		case LAYER_END:
+			backend.end_layer(*command_it->layer);
+			break;
+		case LAYER_DRAW:
+			backend.draw_layer(*command_it->layer);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+// append a command to the frame
+// type: input. type of the command
+// index: input. index of the drawable in its pool
+// states: input. render states of the command
+// return: the new command. the members that only some types use can be set by the caller
+DrawCommandBuffer::draw_command_t& DrawCommandBuffer::add_command(command_type type, unsigned int index, const sf::RenderStates& states)
+{
+	commands.push_back(draw_command_t());
+	draw_command_t& command = commands.back();
+	command.type = type;
+	command.index = index;
+	command.num_vertices = 0;
+	command.primitive = sf::Points;
+	command.layer = NULL;
+	command.owner = owner;
+	command.states = states;
+	return command;
+}
+
+// copy a drawable into the next free Element of its pool. the Elements of older frames are overwritten, so their memory is reused
+// pool: input/ output. pool of the type of the drawable
+// num_used: input/ output. number of used Elements of the pool in this frame
+// drawable: input. drawable to copy
+// return: index of the copy in the pool
+template <typename T> unsigned int DrawCommandBuffer::add_to_pool(vector<T>& pool, unsigned int& num_used, const T& drawable)
+{
+	if (num_used < pool.size())
+		pool[num_used] = drawable;
+	else
+		pool.push_back(drawable);
+	return num_used++;
+}
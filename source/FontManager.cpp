@@ -0,0 +1,156 @@
+#include "FontManager.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// character sizes and styles of the texts of the game. the glyphs of these sizes are rendered when a font is loaded
+typedef struct warm_size
+{
+	unsigned int char_size;
+	bool bold;
+} warm_size_t;
+
+static const warm_size_t warm_sizes[] =
+{
+	{ 20, false },		// leaderboard of the Option Screen
+	{ 24, false },		// statistics of the Stats Screen
+	{ 25, false },		// Words on the Playfield
+	{ 30, true },		// option texts, status messages and game statistics
+	{ 40, true },		// titles and Buttons
+	{ 47, true }		// back Button of the Playfield
+};
+
+mutex FontManager::glyph_mutex;
+
+// default Constructor. no font is loaded until init() and load_font() are called
+FontManager::FontManager()
+{
+	resources = NULL;
+}
+
+// set the files of all fonts. the fonts are not loaded yet (see load_font() and load_remaining()). must be called before the fonts are loaded or requested
+// resource_manager: input. loads the font files. must exist as long as the FontManager
+// font_filenames: input. path of every font. the index is the font id
+void FontManager::init(ResourceManager& resource_manager, const vector<string>& font_filenames)
+{
+	resources = &resource_manager;
+	fonts.assign(font_filenames.size(), shared_ptr<const sf::Font>());
+	filenames = font_filenames;
+	states.assign(font_filenames.size(), FONT_PENDING);
+}
+
+// returns the font with the given id. waits if the font is not loaded yet
+// font_id: input. index of the font in the filenames of init()
+// return: the font. an empty font if the font can't be loaded (see is_loaded())
+const sf::Font& FontManager::get_font(unsigned int font_id)
+{
+	static const sf::Font empty_font;
+	if (wait_for_font(font_id) != FONT_LOADED)
+		return empty_font;
+	return *fonts[font_id];
+}
+
+// returns true if the font with the given id was loaded successfully. waits if the font is not loaded yet
+bool FontManager::is_loaded(unsigned int font_id)
+{
+	return wait_for_font(font_id) == FONT_LOADED;
+}
+
+// returns the path of the font with the given id. used for error messages
+const string& FontManager::get_filename(unsigned int font_id)
+{
+	static const string no_filename;
+	return (font_id < filenames.size()) ? filenames[font_id] : no_filename;
+}
+
+// load all fonts that are not loaded yet
+void FontManager::load_remaining()
+{
+	for (unsigned int font_id = 0; font_id < fonts.size(); font_id++)
+		load_font(font_id);
+}
+
+// mark all fonts that are not loaded yet as failed and wake up every waiting thread. called when the loading is aborted (see AssetLoader::set_skip_handler())
+void FontManager::cancel_pending()
+{
+	lock_guard<mutex> lock(state_mutex);
+	for (unsigned int font_id = 0; font_id < states.size(); font_id++)
+	{
+		if (states[font_id] == FONT_PENDING)
+			states[font_id] = FONT_FAILED;
+	}
+	state_cv.notify_all();
+}
+
+// load a font from its file, render the glyphs and mark it as loaded. does nothing if the font is already loaded (or failed to load)
+// font_id: input. index of the font in the filenames of init()
+void FontManager::load_font(unsigned int font_id)
+{
+	{
+		lock_guard<mutex> lock(state_mutex);
+		if (font_id >= states.size() || states[font_id] != FONT_PENDING)
+			return;
+	}
+
+	TRACE_ZONE("FontManager::load_font");
+	int state = FONT_FAILED;
+	try
+	{
+		fonts[font_id] = resources->get_font(filenames[font_id]);
+		warm_glyphs(*fonts[font_id]);
+		state = FONT_LOADED;
+	}
+	catch (const ResourceLoadError&)
+	{
+		state = FONT_FAILED;	// reported when the font is requested (see is_loaded())
+	}
+
+	lock_guard<mutex> lock(state_mutex);
+	states[font_id] = state;
+	state_cv.notify_all();
+}
+
+// wait until a font is loaded (or failed to load)
+// return: state of the font (see font_states). FONT_FAILED if the font id is invalid
+int FontManager::wait_for_font(unsigned int font_id)
+{
+	if (font_id >= states.size())
+		return FONT_FAILED;
+	unique_lock<mutex> lock(state_mutex);
+	state_cv.wait(lock, [&]() { return states[font_id] != FONT_PENDING; });
+	return states[font_id];
+}
+
+// render the glyphs of a string into the glyph texture of a font that may be drawn by the render thread at the same time. characters that are already rendered are skipped by SFML
+// font: input. the font of the text
+// string: input. the characters to render. the order and duplicates don't matter
+// char_size: input. character size of the text. in pixels
+// bold: input. true if the text has the style sf::Text::Bold
+void FontManager::warm_string(const sf::Font& font, const sf::String& string, unsigned int char_size, bool bold)
+{
+	if (string.isEmpty())
+		return;
+
+	lock_guard<mutex> lock(glyph_mutex);
+	for (size_t i = 0; i < string.getSize(); i++)
+		font.getGlyph(string[i], char_size, bold);
+}
+
+// render the glyphs of a text before its bounds or geometry are used. call after the string, the font, the character size or the style of the text was changed
+// text: input. the text. nothing is rendered if it has no font
+void FontManager::warm_text(const sf::Text& text)
+{
+	if (text.getFont() != NULL)
+		warm_string(*text.getFont(), text.getString(), text.getCharacterSize(), (text.getStyle() & sf::Text::Bold) != 0);
+}
+
+// render the glyphs of all printable ASCII characters at the character sizes of the game into the glyph texture of the font (getGlyph() is const, but fills the glyph texture).
+// glyph_mutex is not needed, because the font is only handed out after it is loaded (see get_font())
+void FontManager::warm_glyphs(const sf::Font& font)
+{
+	for (unsigned int i = 0; i < sizeof(warm_sizes) / sizeof(warm_sizes[0]); i++)
+	{
+		for (sf::Uint32 c = ' '; c <= '~'; c++)
+			font.getGlyph(c, warm_sizes[i].char_size, warm_sizes[i].bold);
+	}
+}
@@ -0,0 +1,411 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "SFML/OpenGL.hpp"
+#include "FrameCapture.h"
+#include "GameClock.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor. nothing is captured until start() is called
+FrameCapture::FrameCapture()
+{
+	config.path = "";
+	config.format = PNG_SEQUENCE;
+	config.fps = DEFAULT_CAPTURE_FPS;
+	frame_width = 0;
+	frame_height = 0;
+	num_encoders = 0;
+	running = false;
+	has_capture_start = false;
+	next_frame_number = 0;
+	stop_requested = false;
+	captured_frames = 0;
+	dropped_frames = 0;
+	encoded_frames = 0;
+	failed_frames = 0;
+	repeated_frames = 0;
+	readback_time = sf::Time::Zero;
+	max_queue_length = 0;
+}
+
+// Destructor. writes all captured frames and terminates the encoder threads
+FrameCapture::~FrameCapture()
+{
+	stop();
+}
+
+// allocate the frame buffers and start the encoder threads. the Y4M file is created and its header is written
+// capture_config: input. path, format and frame rate of the capture (see parse_args())
+// width, height: input. size of the captured frames in pixels. frames of another size are not captured
+// return: -1 if the capture is already running, the configuration is invalid or the Y4M file can't be created. 0 if no error
+int FrameCapture::start(const capture_config_t& capture_config, unsigned int width, unsigned int height)
+{
+	if (running || capture_config.path.empty() || capture_config.fps == 0 || width == 0 || height == 0)
+		return -1;
+
+	config = capture_config;
+	frame_width = width;
+	frame_height = height;
+	if (config.format == Y4M)
+	{
+		y4m_file.open(config.path, ios::binary | ios::trunc);
+		if (!y4m_file.good())	// check error state
+			return -1;
+		// progressive frames with square pixels and 4:2:0 chroma subsampling in full range (JPEG) colors
+		y4m_file << "YUV4MPEG2 W" << frame_width << " H" << frame_height << " F" << config.fps << ":1 Ip A1:1 C420jpeg\n";
+	}
+
+	// all memory for the frames is allocated here, so the capture doesn't allocate while the game runs
+	ring.assign(RING_SIZE, frame_slot_t());
+	for (size_t i = 0; i < ring.size(); i++)
+	{
+		ring[i].pixels.resize((size_t)frame_width * frame_height * 4);
+		ring[i].frame_number = 0;
+		ring[i].state = FREE;
+	}
+	queue.clear();
+	stop_requested = false;
+	captured_frames = 0;
+	dropped_frames = 0;
+	encoded_frames = 0;
+	failed_frames = 0;
+	repeated_frames = 0;
+	readback_time = sf::Time::Zero;
+	max_queue_length = 0;
+	has_capture_start = false;
+	next_frame_number = 0;
+
+	// the PNG compression is the slowest part, so the PNG files are written by several threads. the frames of the Y4M video must be written in order
+	num_encoders = 1;
+	if (config.format == PNG_SEQUENCE)
+		num_encoders = min(max(thread::hardware_concurrency() / 2, 1u), (unsigned int)MAX_PNG_ENCODERS);
+	for (unsigned int i = 0; i < num_encoders; i++)
+		encoder_threads.push_back(thread(&FrameCapture::encoder_task, this));
+
+	running = true;
+	return 0;
+}
+
+// write all captured frames and terminate the encoder threads. must not be called while another thread captures a frame
+void FrameCapture::stop()
+{
+	if (!running)
+		return;
+
+	{
+		lock_guard<mutex> lock(ring_mutex);
+		stop_requested = true;
+	}
+	ring_cv.notify_all();
+	for (size_t i = 0; i < encoder_threads.size(); i++)
+		encoder_threads[i].join();
+	encoder_threads.clear();
+	if (y4m_file.is_open())
+		y4m_file.close();
+	running = false;
+}
+
+// returns true between start() and stop()
+bool FrameCapture::is_running()
+{
+	return running;
+}
+
+// capture the content of a window, if a frame is due. must be called by the thread with the OpenGL context of the window, after the frame is drawn and before display()
+// window: input. the window with the drawn frame
+void FrameCapture::capture_window(sf::RenderWindow& window)
+{
+	capture_target(window);
+}
+
+// capture the content of a render texture (e.g. of the TextureRenderBackend), if a frame is due. must be called after display() of the render texture
+// texture: input. render texture with the drawn frame
+void FrameCapture::capture_texture(sf::RenderTexture& texture)
+{
+	capture_target(texture);
+}
+
+// returns the statistics of the capture, e.g.:
+// "Frame capture (Y4M, 30 FPS, 1 encoders): 300 frames captured, 12 dropped (3.8 %), 300 written, 0 failed, 14 repeated, readback 1.21 ms per frame, ring 8 x 3.7 MB, max queue 8"
+string FrameCapture::get_report()
+{
+	lock_guard<mutex> lock(ring_mutex);
+	unsigned long long due_frames = captured_frames + dropped_frames;
+	ostringstream report;
+	report << fixed << setprecision(1) << "Frame capture (" << (config.format == Y4M ? "Y4M" : "PNG sequence") << ", " << config.fps << " FPS, "
+		<< num_encoders << " encoders): " << captured_frames << " frames captured, " << dropped_frames << " dropped ("
+		<< (due_frames > 0 ? dropped_frames * 100.0 / due_frames : 0.0) << " %), " << encoded_frames << " written, " << failed_frames << " failed";
+	if (config.format == Y4M)
+		report << ", " << repeated_frames << " repeated";
+	report << setprecision(2) << ", readback " << (captured_frames > 0 ? readback_time.asMicroseconds() / 1000.0 / captured_frames : 0.0) << " ms per frame";	// the cost of the capture in the drawing thread
+	report << setprecision(1) << ", ring " << ring.size() << " x " << frame_width * frame_height * 4 / (1024.0 * 1024.0) << " MB, max queue " << max_queue_length;
+	return report.str();
+}
+
+// parse the command line arguments of the capture: "--capture <path>" selects the capture and "--capture-fps <n>" sets the frame rate.
+// a path that ends with ".y4m" selects the Y4M format, every other path is the prefix of the PNG files
+// argc, argv: input. command line arguments of main()
+// capture_config: output. configuration of the capture. the path is empty if the capture is not selected
+// return: 1 if the capture was selected. 0 if not. -1 if an argument is invalid
+int FrameCapture::parse_args(int argc, char* argv[], capture_config_t& capture_config)
+{
+	capture_config.path = "";
+	capture_config.format = PNG_SEQUENCE;
+	capture_config.fps = DEFAULT_CAPTURE_FPS;
+
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if (!is_capture_arg(arg))
+			continue;
+
+		string value = (i + 1 < argc) ? argv[++i] : "";
+		int fps = atoi(value.c_str());
+		if (arg == "--capture" && !value.empty())
+			capture_config.path = value;
+		else if (arg == "--capture-fps" && fps >= MIN_CAPTURE_FPS && fps <= MAX_CAPTURE_FPS)
+			capture_config.fps = (unsigned int)fps;
+		else
+		{
+			cout << "usage: typing_game --capture <file.y4m | png prefix> [--capture-fps <" << MIN_CAPTURE_FPS << "..." << MAX_CAPTURE_FPS << ">]" << endl;
+			return -1;
+		}
+	}
+
+	if (capture_config.path.empty())
+		return 0;
+
+	string extension = capture_config.path.size() >= 4 ? capture_config.path.substr(capture_config.path.size() - 4) : "";
+	transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+	if (extension == ".y4m")
+		capture_config.format = Y4M;
+	return 1;
+}
+
+// returns true if the argument is parsed by parse_args(). every capture argument has a value
+bool FrameCapture::is_capture_arg(const string& arg)
+{
+	return arg == "--capture" || arg == "--capture-fps";
+}
+
+// check if the current time slot is not captured yet. the time is taken from the GameClock, so the simulated time is used in the stress test
+// frame_number: output. the current time slot since the start of the capture
+// return: true if a frame shall be captured
+bool FrameCapture::is_capture_due(unsigned long long& frame_number)
+{
+	sf::Time now = GameClock::now();
+	if (!has_capture_start)
+	{
+		capture_start = now;
+		has_capture_start = true;
+	}
+
+	frame_number = (unsigned long long)(now - capture_start).asMicroseconds() * config.fps / 1000000;
+	if (frame_number < next_frame_number)	// this time slot was already captured
+		return false;
+	next_frame_number = frame_number + 1;
+	return true;
+}
+
+// reserve a free frame buffer. if all buffers are in use, the frame is dropped
+// return: index of the reserved slot. -1 if the frame is dropped
+int FrameCapture::acquire_slot()
+{
+	lock_guard<mutex> lock(ring_mutex);
+	for (size_t i = 0; i < ring.size(); i++)
+	{
+		if (ring[i].state == FREE)
+		{
+			ring[i].state = FILLING;
+			return (int)i;
+		}
+	}
+	dropped_frames++;
+	return -1;
+}
+
+// capture the content of a render target, if a frame is due
+// target: input. render target with the drawn frame. its OpenGL context is activated
+void FrameCapture::capture_target(sf::RenderTarget& target)
+{
+	unsigned long long frame_number;
+	if (!running || !is_capture_due(frame_number))
+		return;
+
+	int slot = acquire_slot();	// the pixels are only read if there is a free buffer
+	if (slot < 0)
+		return;
+
+	fill_slot(slot, frame_number, target);
+}
+
+// read the pixels of a render target directly into a reserved buffer and queue it for the encoders. nothing is allocated
+// slot: input. index of the slot reserved by acquire_slot()
+// frame_number: input. time slot of the frame
+// target: input. render target with the frame
+void FrameCapture::fill_slot(int slot, unsigned long long frame_number, sf::RenderTarget& target)
+{
+	sf::Clock readback_clock;
+	bool valid = (target.getSize() == sf::Vector2u(frame_width, frame_height) && target.setActive(true));
+	if (valid)
+	{
+		TRACE_ZONE("capture frame");
+		while (glGetError() != GL_NO_ERROR) {}		// clear older errors, so only the errors of the readback are checked
+		glReadPixels(0, 0, (GLsizei)frame_width, (GLsizei)frame_height, GL_RGBA, GL_UNSIGNED_BYTE, ring[slot].pixels.data());	// waits until the frame is drawn
+		valid = (glGetError() == GL_NO_ERROR);
+		ring[slot].frame_number = frame_number;
+	}
+	sf::Time readback_duration = readback_clock.getElapsedTime();
+
+	{
+		lock_guard<mutex> lock(ring_mutex);
+		if (valid)
+		{
+			ring[slot].state = QUEUED;
+			queue.push_back((unsigned int)slot);
+			max_queue_length = max(max_queue_length, queue.size());
+			captured_frames++;
+			readback_time += readback_duration;
+		}
+		else
+		{
+			ring[slot].state = FREE;
+			failed_frames++;
+		}
+	}
+	if (valid)
+		ring_cv.notify_one();
+}
+
+// runs in every encoder thread. writes the queued frames until stop() is called and the queue is empty
+void FrameCapture::encoder_task()
+{
+	TRACE_THREAD_NAME("capture encoder");
+	sf::Image image;					// reused for every PNG file
+	vector<sf::Uint8> yuv;				// last frame of the Y4M video. empty until the first frame is written
+	unsigned long long last_frame_number = 0;
+	unique_lock<mutex> lock(ring_mutex);
+
+	while (true)
+	{
+		ring_cv.wait(lock, [this] { return stop_requested || !queue.empty(); });
+		if (queue.empty())		// stop() was called and all frames are written
+			break;
+
+		unsigned int slot = queue.front();
+		queue.pop_front();
+		ring[slot].state = ENCODING;
+		lock.unlock();		// the frame is encoded without holding the lock, so new frames can be captured in the meantime
+
+		bool ok;
+		unsigned long long num_repeated = 0;
+		{
+			TRACE_ZONE("encode frame");
+			if (config.format == Y4M)
+				ok = encode_y4m(ring[slot], yuv, last_frame_number, num_repeated);
+			else
+				ok = encode_png(ring[slot], image);
+		}
+
+		lock.lock();
+		ring[slot].state = FREE;
+		repeated_frames += num_repeated;
+		if (ok)
+			encoded_frames++;
+		else
+			failed_frames++;
+	}
+}
+
+// write a frame as PNG file. the file name contains the time slot of the frame, e.g. "capture_000042.png"
+// slot: input. the frame
+// image: input/ output. image to compress the frame. its memory is reused
+// return: true if the file was written
+bool FrameCapture::encode_png(const frame_slot_t& slot, sf::Image& image)
+{
+	ostringstream file_name;
+	file_name << config.path << "_" << setw(6) << setfill('0') << slot.frame_number << ".png";
+	image.create(frame_width, frame_height, slot.pixels.data());
+	image.flipVertically();		// the rows of the buffer are bottom-up
+	return image.saveToFile(file_name.str());
+}
+
+// append a frame to the Y4M video. the time slots between the last frame and this frame are filled with the last frame, so the video keeps the timing of the game
+// slot: input. the frame
+// yuv: input/ output. the last written frame in the Y4M format. empty before the first frame
+// last_frame_number: input/ output. time slot of the last written frame
+// num_repeated: output. number of repeated frames
+// return: true if the frames were written
+bool FrameCapture::encode_y4m(const frame_slot_t& slot, vector<sf::Uint8>& yuv, unsigned long long& last_frame_number, unsigned long long& num_repeated)
+{
+	if (!yuv.empty())
+	{
+		for (unsigned long long i = last_frame_number + 1; i < slot.frame_number; i++)
+		{
+			y4m_file << "FRAME\n";
+			y4m_file.write((const char*)yuv.data(), yuv.size());
+			num_repeated++;
+		}
+	}
+
+	convert_to_yuv(slot.pixels, yuv);
+	y4m_file << "FRAME\n";
+	y4m_file.write((const char*)yuv.data(), yuv.size());
+	last_frame_number = slot.frame_number;
+	return y4m_file.good();
+}
+
+// convert RGBA pixels into the planes of a Y4M frame (Y, then Cb and Cr with half the width and height) with the full range BT.601 coefficients of JPEG.
+// the chroma of every 2x2 block is the average of its pixels. the rows are flipped, because the Y4M frame starts with the top row
+// pixels: input. RGBA pixels of the frame. the rows are bottom-up
+// yuv: output. the Y, Cb and Cr planes
+void FrameCapture::convert_to_yuv(const vector<sf::Uint8>& pixels, vector<sf::Uint8>& yuv)
+{
+	unsigned int chroma_width = (frame_width + 1) / 2;
+	unsigned int chroma_height = (frame_height + 1) / 2;
+	yuv.resize((size_t)frame_width * frame_height + 2 * (size_t)chroma_width * chroma_height);
+	sf::Uint8* y_plane = yuv.data();
+	sf::Uint8* cb_plane = y_plane + (size_t)frame_width * frame_height;
+	sf::Uint8* cr_plane = cb_plane + (size_t)chroma_width * chroma_height;
+
+	for (unsigned int y = 0; y < frame_height; y++)
+	{
+		const sf::Uint8* row = &pixels[(size_t)(frame_height - 1 - y) * frame_width * 4];
+		for (unsigned int x = 0; x < frame_width; x++)
+		{
+			const sf::Uint8* rgba = &row[(size_t)x * 4];
+			y_plane[(size_t)y * frame_width + x] = (sf::Uint8)((77 * rgba[0] + 150 * rgba[1] + 29 * rgba[2] + 128) >> 8);
+		}
+	}
+
+	for (unsigned int cy = 0; cy < chroma_height; cy++)
+	{
+		for (unsigned int cx = 0; cx < chroma_width; cx++)
+		{
+			int r = 0, g = 0, b = 0, n = 0;
+			for (unsigned int y = 2 * cy; y < min(2 * cy + 2, frame_height); y++)
+			{
+				for (unsigned int x = 2 * cx; x < min(2 * cx + 2, frame_width); x++)
+				{
+					const sf::Uint8* rgba = &pixels[((size_t)(frame_height - 1 - y) * frame_width + x) * 4];
+					r += rgba[0];
+					g += rgba[1];
+					b += rgba[2];
+					n++;
+				}
+			}
+			r /= n;
+			g /= n;
+			b /= n;
+			// the offset of 128 is added before the shift, so the shifted value is never negative
+			cb_plane[(size_t)cy * chroma_width + cx] = (sf::Uint8)min((-43 * r - 85 * g + 128 * b + 32896) >> 8, 255);
+			cr_plane[(size_t)cy * chroma_width + cx] = (sf::Uint8)min((128 * r - 107 * g - 21 * b + 32896) >> 8, 255);
+		}
+	}
+}
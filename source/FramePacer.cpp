@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include "FramePacer.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor. starts in VSYNC mode
+// pacing_window: input. the window whose V-Sync is set by the pacer. NULL if there is no window (the VSYNC mode doesn't wait then)
+FramePacer::FramePacer(sf::Window* pacing_window)
+{
+	window = pacing_window;
+	mode = VSYNC;
+	fps_cap = DEFAULT_FPS_CAP;
+	set_mode(VSYNC, DEFAULT_FPS_CAP);
+}
+
+// set the pacing mode and reset the statistics
+// pacing_mode: input. see pacing_modes. an invalid mode selects VSYNC
+// cap: input. frame rate of the FPS_CAP mode. limited to the fps_cap_range
+void FramePacer::set_mode(int pacing_mode, unsigned int cap)
+{
+	mode = (pacing_mode >= 0 && pacing_mode < NUM_PACING_MODES) ? pacing_mode : (int)VSYNC;
+	fps_cap = (cap < MIN_FPS_CAP) ? (unsigned int)MIN_FPS_CAP : (cap > MAX_FPS_CAP) ? (unsigned int)MAX_FPS_CAP : cap;
+	if (window != NULL)
+	{
+		window->setFramerateLimit(0);	// the frame limit of SFML only sleeps, which is not accurate enough
+		window->setVerticalSyncEnabled(mode == VSYNC);
+	}
+
+	has_last_frame = false;
+	interval_stats = frame_stats_t();
+	total_stats = frame_stats_t();
+	interval_start = pacing_clock::now();
+	next_frame = interval_start;
+	frame_rate = 0;
+	pacing_error = 0;
+}
+
+// returns the current mode (see pacing_modes). may change from VSYNC to FPS_CAP if V-Sync has no effect
+int FramePacer::get_mode()
+{
+	return mode;
+}
+
+// returns the frame rate of the FPS_CAP mode
+unsigned int FramePacer::get_fps_cap()
+{
+	return fps_cap;
+}
+
+// call once per frame after display(). waits until the next frame shall start (only in FPS_CAP mode) and measures the frame time
+void FramePacer::wait_frame()
+{
+	if (mode == FPS_CAP)
+	{
+		TRACE_ZONE("frame pacing");
+		next_frame += chrono::microseconds(1000000 / fps_cap);
+		pacing_clock::time_point now = pacing_clock::now();
+		if (now >= next_frame)
+			next_frame = now;	// the frame took too long. start the next frame now, the missed time is not caught up
+		else
+		{
+			// sf::sleep() raises the timer resolution on windows, so it is more accurate than std::this_thread::sleep_for()
+			chrono::microseconds sleep_time = chrono::duration_cast<chrono::microseconds>(next_frame - now) - chrono::microseconds(SPIN_TIME_US);
+			if (sleep_time.count() > 0)
+				sf::sleep(sf::microseconds(sleep_time.count()));
+			while (pacing_clock::now() < next_frame)
+				this_thread::yield();
+		}
+	}
+
+	pacing_clock::time_point frame_end = pacing_clock::now();
+	if (has_last_frame)
+		add_frame_time(chrono::duration<double>(frame_end - last_frame).count());
+	last_frame = frame_end;
+	has_last_frame = true;
+}
+
+// the time until the next wait_frame() is not measured. used if the main loop waited for an event (see idle mode in main.cpp)
+void FramePacer::skip_frame()
+{
+	has_last_frame = false;
+	next_frame = pacing_clock::now();
+}
+
+// returns the frame rate of the last second. in frames per second. 0 if no second is measured yet
+float FramePacer::get_frame_rate()
+{
+	return frame_rate;
+}
+
+// returns the pacing error of the last second. in milliseconds
+float FramePacer::get_pacing_error()
+{
+	return pacing_error;
+}
+
+// returns the mode and the frame rate and the pacing error of all frames since the mode was set, e.g.:
+// "Frame pacing (60 FPS cap): 59.98 FPS, pacing error 0.05 ms (1234 frames)"
+string FramePacer::get_report()
+{
+	ostringstream report;
+	report << fixed << setprecision(2) << "Frame pacing (" << get_mode_name(mode, fps_cap) << "): ";
+	if (total_stats.frames == 0 || total_stats.sum <= 0)
+		report << "no frames measured";
+	else
+		report << total_stats.frames / total_stats.sum << " FPS, pacing error " << get_pacing_error(total_stats) * 1000 << " ms (" << total_stats.frames << " frames)";
+	return report.str();
+}
+
+// returns a description of a mode, e.g. "V-Sync", "60 FPS cap" or "uncapped"
+string FramePacer::get_mode_name(int pacing_mode, unsigned int cap)
+{
+	if (pacing_mode == FPS_CAP)
+		return to_string(cap) + " FPS cap";
+	else if (pacing_mode == UNCAPPED)
+		return "uncapped";
+	return "V-Sync";
+}
+
+// parse the command line argument "--fps vsync|uncapped|<frames per second>"
+// argc, argv: input. command line arguments of main()
+// pacing_mode: output. the selected mode. only set if the argument is given
+// cap: output. the frame rate of the FPS_CAP mode. only set if the argument selects FPS_CAP
+// return: 1 if the argument is given. 0 if not. -1 if the value is invalid
+int FramePacer::parse_args(int argc, char* argv[], int& pacing_mode, unsigned int& cap)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (string(argv[i]) != "--fps")
+			continue;
+
+		string value = (i + 1 < argc) ? argv[i + 1] : "";
+		int fps = atoi(value.c_str());
+		if (value == "vsync")
+			pacing_mode = VSYNC;
+		else if (value == "uncapped")
+			pacing_mode = UNCAPPED;
+		else if (fps >= MIN_FPS_CAP && fps <= MAX_FPS_CAP)
+		{
+			pacing_mode = FPS_CAP;
+			cap = (unsigned int)fps;
+		}
+		else
+		{
+			cout << "usage: typing_game --fps vsync|uncapped|<" << MIN_FPS_CAP << "..." << MAX_FPS_CAP << ">" << endl;
+			return -1;
+		}
+		return 1;
+	}
+	return 0;
+}
+
+// returns the frame time that the frames should have. in seconds
+double FramePacer::get_target_frame_time(const frame_stats_t& stats)
+{
+	if (mode == FPS_CAP)
+		return 1.0 / fps_cap;
+	return (stats.frames > 0) ? stats.sum / stats.frames : 0;
+}
+
+// returns the root mean square deviation of the frame times from the target frame time. in seconds
+// sum((t - target)^2) = sum(t^2) - 2 * target * sum(t) + n * target^2
+double FramePacer::get_pacing_error(const frame_stats_t& stats)
+{
+	if (stats.frames == 0)
+		return 0;
+	double target = get_target_frame_time(stats);
+	double sum_squared_errors = stats.sum_squares - 2 * target * stats.sum + stats.frames * target * target;
+	return sqrt(max(sum_squared_errors, 0.0) / stats.frames);
+}
+
+// add the time of one frame to the statistics. updates the frame rate and the pacing error at the end of every interval
+// frame_time: input. time from the end of the last frame to the end of this frame. in seconds
+void FramePacer::add_frame_time(double frame_time)
+{
+	interval_stats.frames++;
+	interval_stats.sum += frame_time;
+	interval_stats.sum_squares += frame_time * frame_time;
+	total_stats.frames++;
+	total_stats.sum += frame_time;
+	total_stats.sum_squares += frame_time * frame_time;
+
+	pacing_clock::time_point now = pacing_clock::now();
+	if (now - interval_start < chrono::milliseconds(STATS_INTERVAL_MS))
+		return;
+
+	frame_rate = (interval_stats.sum > 0) ? (float)(interval_stats.frames / interval_stats.sum) : 0;
+	pacing_error = (float)(get_pacing_error(interval_stats) * 1000);
+	interval_stats = frame_stats_t();
+	interval_start = now;
+
+	// if V-Sync has no effect, limit the frame rate instead, so the game doesn't use a whole CPU core for frames that are never shown
+	if (mode == VSYNC && window != NULL && frame_rate > VSYNC_MAX_FPS)
+	{
+		cout << "V-Sync has no effect (" << (int)frame_rate << " FPS). The frame rate is limited to " << (int)DEFAULT_FPS_CAP << " FPS." << endl;
+		set_mode(FPS_CAP, DEFAULT_FPS_CAP);
+	}
+}
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cstdio>
+#include "FrameProfiler.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+FrameProfiler frame_profiler;
+
+// Constructor. all ring buffers are empty
+FrameProfiler::FrameProfiler()
+{
+	for (unsigned int i = 0; i < NUM_METRICS; i++)
+	{
+		for (unsigned int j = 0; j < NUM_SAMPLES; j++)
+			rings[i].samples[j].store(0, memory_order_relaxed);
+		rings[i].num_written.store(0, memory_order_relaxed);
+		rings[i].accumulator = 0;
+	}
+}
+
+// write a new sample into the ring buffer of a metric. overwrites the oldest sample if the buffer is full
+// must only be called by the thread that owns the metric (see metric_id)
+// metric: input. metric to add the sample to
+// duration: input. measured duration
+void FrameProfiler::add_sample(metric_id metric, sf::Time duration)
+{
+	unsigned int index = rings[metric].num_written.load(memory_order_relaxed);
+	rings[metric].samples[index % NUM_SAMPLES].store(duration.asMicroseconds() / 1000.f, memory_order_relaxed);
+	rings[metric].num_written.store(index + 1, memory_order_release);	// publish the sample to the reading thread
+}
+
+// add a duration to the accumulator of a metric. used for metrics that are measured multiple times in a frame or tick
+// metric: input. metric to accumulate the duration for
+// duration: input. measured duration
+void FrameProfiler::accumulate(metric_id metric, sf::Time duration)
+{
+	rings[metric].accumulator += duration.asMicroseconds() / 1000.f;
+}
+
+// write the accumulated duration as a new sample and reset the accumulator. should be called once every frame / tick
+// metric: input. metric of the accumulator
+void FrameProfiler::flush_accumulator(metric_id metric)
+{
+	add_sample(metric, sf::microseconds((sf::Int64)(rings[metric].accumulator * 1000)));
+	rings[metric].accumulator = 0;
+}
+
+// lock a mutex and add the time waiting for the mutex to the accumulator of a metric
+// mtx: input. mutex to lock. must be unlocked by the caller
+// wait_metric: input. metric to accumulate the waiting time for
+void FrameProfiler::lock(mutex& mtx, metric_id wait_metric)
+{
+	if (mtx.try_lock())		// don't measure the time if the mutex is free
+		return;
+
+	TRACE_ZONE("wait mutex_glob");
+	sf::Clock wait_clock;
+	mtx.lock();		// wait here and lock the mutex when its free
+	accumulate(wait_metric, wait_clock.getElapsedTime());
+}
+
+// copy the samples of a metric. can be called from any thread
+// metric: input. metric to copy
+// samples_out: output. array with at least NUM_SAMPLES Elements. the oldest sample is copied first. in milliseconds
+// return: number of copied samples
+unsigned int FrameProfiler::copy_samples(metric_id metric, float* samples_out)
+{
+	unsigned int num_written = rings[metric].num_written.load(memory_order_acquire);
+	unsigned int num_samples = min(num_written, (unsigned int)NUM_SAMPLES);
+	unsigned int first_index = num_written - num_samples;
+
+	for (unsigned int i = 0; i < num_samples; i++)
+		samples_out[i] = rings[metric].samples[(first_index + i) % NUM_SAMPLES].load(memory_order_relaxed);
+
+	return num_samples;
+}
+
+// returns the name of a metric
+const char* FrameProfiler::get_metric_name(metric_id metric)
+{
+	switch (metric)
+	{
+	case EVENT_POLL:			return "event poll";
+	case UPDATE:				return "update";
+	case DRAW:					return "draw";
+	case PARTICLE_DRAW:			return "particle draw";
+	case RENDER_WAIT:			return "render wait";
+	case MUTEX_WAIT_MAIN:		return "mutex wait";
+	case FRAME:					return "frame";
+	case RENDER:				return "render";
+	case DISPLAY:				return "display";
+	case PHYSICS_TICK:			return "physics tick";
+	case PARTICLE_UPDATE:		return "particle update";
+	case MUTEX_WAIT_PHYSICS:	return "phys mutex wait";
+	default:					return "";
+	}
+}
+
+
+// Constructor. The overlay is hidden at the beginning. load_font() must be called before it can be shown
+ProfilerOverlay::ProfilerOverlay()
+	// member initializer list. allocate the memory for all vertices once
+	: vertices(MAX_VERTICES)
+{
+	visible = false;
+	font_loaded = false;
+	frame_pacer = NULL;
+	num_frame_samples = 0;
+	num_vertices = 0;
+	text_buffer[0] = '\0';
+	for (unsigned int i = 0; i < FrameProfiler::NUM_METRICS; i++)
+		stats[i].last = stats[i].min = stats[i].avg = stats[i].p99 = 0;
+}
+
+inline ProfilerOverlay::~ProfilerOverlay() {}	// virtual destructor
+
+// load the font of the overlay and load the glyphs of all printable ASCII characters, so there are no glyph uploads while the overlay is shown
+// font_filename: input. path of a monospace font
+// return: true if the font was loaded
+bool ProfilerOverlay::load_font(const string& font_filename)
+{
+	font_loaded = font.loadFromFile(font_filename);
+	if (!font_loaded)
+		return false;
+
+	for (sf::Uint32 c = ' '; c <= '~'; c++)
+		font.getGlyph(c, CHAR_SIZE, false);
+
+	return true;
+}
+
+// returns true if the overlay is shown
+bool ProfilerOverlay::is_visible()
+{
+	return visible;
+}
+
+// show the frame rate and the pacing error of a FramePacer below the table
+// pacer: input. must exist as long as the overlay. NULL: nothing is shown
+void ProfilerOverlay::set_frame_pacer(FramePacer* pacer)
+{
+	frame_pacer = pacer;
+}
+
+// calculate the statistics of every metric (only if the overlay is shown)
+inline void ProfilerOverlay::update()
+{
+	if (!visible)
+		return;
+
+	for (unsigned int i = 0; i < FrameProfiler::NUM_METRICS; i++)
+	{
+		FrameProfiler::metric_id metric = (FrameProfiler::metric_id)i;
+		unsigned int num_samples = frame_profiler.copy_samples(metric, samples);
+		if (num_samples == 0)
+			continue;
+
+		float sum = 0;
+		stats[i].min = samples[0];
+		for (unsigned int j = 0; j < num_samples; j++)
+		{
+			sum += samples[j];
+			stats[i].min = min(stats[i].min, samples[j]);
+			sorted_samples[j] = samples[j];
+		}
+		stats[i].avg = sum / num_samples;
+		stats[i].last = samples[num_samples - 1];
+
+		// the 99th percentile is the smallest sample that is bigger or equal to 99% of the samples
+		unsigned int p99_index = (num_samples * 99 + 99) / 100 - 1;
+		nth_element(sorted_samples, sorted_samples + p99_index, sorted_samples + num_samples);
+		stats[i].p99 = sorted_samples[p99_index];
+
+		if (metric == FrameProfiler::FRAME)		// keep the frame times for the graph
+		{
+			num_frame_samples = num_samples;
+			copy(samples, samples + num_samples, frame_samples);
+		}
+	}
+}
+
+inline void ProfilerOverlay::update_physics() {}
+
+// add a quad to the vertex array
+// rect: input. position and size of the quad
+// tex_rect: input. area of the font texture that is shown on the quad
+// color: input. color of the quad (gets multiplied with the texture color)
+void ProfilerOverlay::add_quad(const sf::FloatRect& rect, const sf::FloatRect& tex_rect, const sf::Color& color)
+{
+	if (num_vertices + 4 > MAX_VERTICES)
+		return;
+
+	vertices[num_vertices++] = sf::Vertex(sf::Vector2f(rect.left, rect.top), color, sf::Vector2f(tex_rect.left, tex_rect.top));
+	vertices[num_vertices++] = sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top), color, sf::Vector2f(tex_rect.left + tex_rect.width, tex_rect.top));
+	vertices[num_vertices++] = sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color, sf::Vector2f(tex_rect.left + tex_rect.width, tex_rect.top + tex_rect.height));
+	vertices[num_vertices++] = sf::Vertex(sf::Vector2f(rect.left, rect.top + rect.height), color, sf::Vector2f(tex_rect.left, tex_rect.top + tex_rect.height));
+}
+
+// add a quad for every character of a text to the vertex array. the texture of the quads are the glyphs of the font
+// text: input. text to add. can contain multiple lines
+// position: input. top left position of the text
+// color: input. color of the text
+void ProfilerOverlay::add_text(const char* text, sf::Vector2f position, const sf::Color& color)
+{
+	sf::Vector2f pen(position.x, position.y + CHAR_SIZE);	// the glyph bounds are relative to the baseline of the text
+
+	for (const char* c = text; *c != '\0'; c++)
+	{
+		if (*c == '\n')
+		{
+			pen.x = position.x;
+			pen.y += font.getLineSpacing(CHAR_SIZE);
+			continue;
+		}
+
+		const sf::Glyph& glyph = font.getGlyph((sf::Uint8)*c, CHAR_SIZE, false);
+		sf::FloatRect rect(pen.x + glyph.bounds.left, pen.y + glyph.bounds.top, glyph.bounds.width, glyph.bounds.height);
+		add_quad(rect, sf::FloatRect(glyph.textureRect), color);
+		pen.x += glyph.advance;
+	}
+}
+
+// draw the overlay in the top right corner of the render target. All text and shapes are drawn with a single draw call.
+inline void ProfilerOverlay::draw_on_window(DrawCommandBuffer& target)
+{
+	if (!visible || !font_loaded)
+		return;
+
+	// the font texture has a white square of 2x2 pixels in its top left corner (reserved by SFML for underlines).
+	// this area is used for all quads that are not text, so everything can be drawn with the same texture
+	const sf::FloatRect white_tex_rect(0.5f, 0.5f, 1.f, 1.f);
+	const float line_spacing = font.getLineSpacing(CHAR_SIZE);
+	const float char_width = font.getGlyph('0', CHAR_SIZE, false).advance;
+	const unsigned int num_columns = 46;	// maximum number of characters in one line
+	const float frame_time_60fps = 1000.f / 60;
+	const float graph_max_ms = 2 * frame_time_60fps;	// frame time at the top of the graph
+
+	// format the table of all metrics
+	int length = snprintf(text_buffer, sizeof(text_buffer), "%-16s%7s%7s%7s%7s\n", "stage [ms]", "last", "min", "avg", "p99");
+	for (unsigned int i = 0; i < FrameProfiler::NUM_METRICS && length > 0 && length < (int)sizeof(text_buffer); i++)
+	{
+		length += snprintf(text_buffer + length, sizeof(text_buffer) - length, "%-16s%7.2f%7.2f%7.2f%7.2f\n",
+			FrameProfiler::get_metric_name((FrameProfiler::metric_id)i), stats[i].last, stats[i].min, stats[i].avg, stats[i].p99);
+	}
+	unsigned int num_lines = FrameProfiler::NUM_METRICS + 1;
+	if (frame_pacer != NULL && length > 0 && length < (int)sizeof(text_buffer))
+	{
+		length += snprintf(text_buffer + length, sizeof(text_buffer) - length, "%s: %.1f fps, error %.2f ms\n",
+			FramePacer::get_mode_name(frame_pacer->get_mode(), frame_pacer->get_fps_cap()).c_str(), frame_pacer->get_frame_rate(), frame_pacer->get_pacing_error());
+		num_lines++;
+	}
+
+	float panel_width = num_columns * char_width + 2 * MARGIN;
+	float panel_height = num_lines * line_spacing + GRAPH_HEIGHT + 3 * MARGIN;
+	sf::Vector2f panel_pos(target.getSize().x - panel_width - MARGIN, (float)MARGIN);
+	sf::FloatRect graph_rect(panel_pos.x + MARGIN, panel_pos.y + panel_height - MARGIN - GRAPH_HEIGHT, panel_width - 2 * MARGIN, (float)GRAPH_HEIGHT);
+
+	num_vertices = 0;
+
+	// background of the panel and of the graph
+	add_quad(sf::FloatRect(panel_pos.x, panel_pos.y, panel_width, panel_height), white_tex_rect, sf::Color(0, 0, 0, 180));
+	add_quad(graph_rect, white_tex_rect, sf::Color(40, 40, 40, 200));
+
+	// graph of the frame times. one bar per sample, the newest sample on the right
+	float bar_width = graph_rect.width / FrameProfiler::NUM_SAMPLES;
+	for (unsigned int i = 0; i < num_frame_samples; i++)
+	{
+		float frame_time = min(frame_samples[i], graph_max_ms);
+		float bar_height = frame_time / graph_max_ms * GRAPH_HEIGHT;
+		sf::Color bar_color = sf::Color::Green;
+		if (frame_samples[i] > graph_max_ms)
+			bar_color = sf::Color::Red;
+		else if (frame_samples[i] > frame_time_60fps * 1.1f)
+			bar_color = sf::Color::Yellow;
+
+		float bar_left = graph_rect.left + graph_rect.width - (num_frame_samples - i) * bar_width;
+		add_quad(sf::FloatRect(bar_left, graph_rect.top + GRAPH_HEIGHT - bar_height, bar_width, bar_height), white_tex_rect, bar_color);
+	}
+	// line at the frame time of 60 fps
+	add_quad(sf::FloatRect(graph_rect.left, graph_rect.top + GRAPH_HEIGHT / 2, graph_rect.width, 1), white_tex_rect, sf::Color(255, 255, 255, 120));
+
+	add_text(text_buffer, sf::Vector2f(panel_pos.x + MARGIN, panel_pos.y + MARGIN), sf::Color::White);
+
+	target.draw(&vertices[0], num_vertices, sf::Quads, sf::RenderStates(&font.getTexture(CHAR_SIZE)));
+}
+
+// toggle the overlay with the F3 key
+inline void ProfilerOverlay::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt)
+{
+	if (pressed_key_evnt.code == sf::Keyboard::F3)
+		visible = !visible;
+}
+
+inline void ProfilerOverlay::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt) {}
+
+// the frame timings change in every frame while the overlay is shown
+inline bool ProfilerOverlay::is_animating()
+{
+	return visible;
+}
+
+// name of the Entity type for the CountingRenderBackend
+inline const char* ProfilerOverlay::get_entity_name()
+{
+	return "ProfilerOverlay";
+}
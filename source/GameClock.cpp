@@ -0,0 +1,57 @@
+#include "GameClock.h"
+
+std::atomic<bool> GameClock::simulated(false);
+std::atomic<sf::Int64> GameClock::simulated_time_us(0);
+
+// Constructor. The clock starts automatically after being constructed (like sf::Clock)
+GameClock::GameClock()
+{
+	start_time = now();
+}
+
+// returns the time that has passed since the last restart (or since the construction)
+sf::Time GameClock::getElapsedTime() const
+{
+	return now() - start_time;
+}
+
+// restart the clock
+// return: the time that has passed since the last restart (or since the construction)
+sf::Time GameClock::restart()
+{
+	sf::Time current_time = now();
+	sf::Time elapsed = current_time - start_time;
+	start_time = current_time;
+	return elapsed;
+}
+
+// select the time source of all GameClock objects
+// enable: input. true: use the simulated time. false: use the real time
+void GameClock::set_simulated(bool enable)
+{
+	simulated = enable;
+}
+
+// returns true if the simulated time is used as time source
+bool GameClock::is_simulated()
+{
+	return simulated;
+}
+
+// advance the simulated time. has no effect on the clocks if the real time is used
+// delta: input. time step to add to the simulated time
+void GameClock::advance_simulated_time(sf::Time delta)
+{
+	simulated_time_us += delta.asMicroseconds();
+}
+
+// returns the current time of the selected time source
+sf::Time GameClock::now()
+{
+	// the real time is measured with a clock that is started on the first call of this function
+	static sf::Clock real_clock;
+
+	if (simulated)
+		return sf::microseconds(simulated_time_us);
+	return real_clock.getElapsedTime();
+}
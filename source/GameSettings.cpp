@@ -1,288 +1,623 @@
-#include "GameSettings.h"
-
-using namespace std;
-
-// Constructor. Open the file pointer for reading and writing in binary mode
-// check if file has the correct format and if the checksum is correct. If not create a new default file
-// settings_filename: input. path of the settings file
-SettingsFileParser::SettingsFileParser(const string& settings_filename) : fp(settings_filename, ios::binary | ios::in | ios::out)	// member initializer list: fp
-{
-	filename = settings_filename;
-	file_state = GOOD;
-	// sizeof(struct filecontent) doesn't return the size of the sum of the Elements (because it isn't packed), so the size of every Element must be added individually.
-	expected_file_length = sizeof(file_content.hi_score) + sizeof(file_content.boundary_id) + sizeof(file_content.font_id) +
-		sizeof(file_content.num_words_spawn) + sizeof(file_content.checksum);
-
-	init_file_content();
-
-	if (check_settings_file() < 0)
-	{
-		create_settings_file();
-	}
-}
-
-// read out the file content byte-wise and add all bytes together to calculate the checksum
-// return: calculated check sum
-inline int SettingsFileParser::calculate_checksum()
-{
-	char byte = 0;
-	int check_sum = 0;
-
-	fp.seekg(0, fp.beg);	// set file pointer to the beginning of the file
-	for (unsigned int i = 0; i < expected_file_length - sizeof(file_content.checksum); i++)
-	{
-		fp.read(&byte, sizeof(byte));
-		check_sum += byte;
-	}
-	return check_sum;
-}
-
-// set all the Elements of struct filecontent to their defaults
-inline void SettingsFileParser::init_file_content()
-{
-	file_content.hi_score = 0;
-	file_content.boundary_id = RECT;
-	file_content.font_id = ARIAL;
-	file_content.num_words_spawn = MIN_NUM_WORDS;
-	file_content.checksum = 0;
-}
-
-// calculate the check sum of the file and write it to the end of the file. update also the corresponding struct filecontent Element
-// the checksum should always be updated after writing new content to the file
-inline void SettingsFileParser::updateChecksum()
-{
-	file_content.checksum = calculate_checksum();
-	fp.seekp((-1) * (int)sizeof(file_content.checksum), fp.end);	// use a negative offset from the end of the file to jump to the checksum position
-	fp.write((char*)& file_content.checksum, sizeof(file_content.checksum));
-	fp.flush();		// flush the output buffer, to send the buffer to the file
-}
-
-// check if all contents of the file are like they should
-// read out every information in the file and save it into the struct filecontent
-// return: -1 if file is not ok. 0 if no error
-int SettingsFileParser::check_settings_file()
-{
-	if (!fp.good())	// check error state
-		return -1;
-
-	// check the size of the file
-	fp.seekg(0, fp.end);
-	streamoff file_size = fp.tellg();
-	if (file_size != expected_file_length)
-		return -1;
-
-	// read out the file content
-	fp.seekg(0, fp.beg);
-	fp.read((char*)& file_content.hi_score, sizeof(file_content.hi_score));
-	fp.read((char*)& file_content.boundary_id, sizeof(file_content.boundary_id));
-	fp.read((char*)& file_content.font_id, sizeof(file_content.font_id));
-	fp.read((char*)& file_content.num_words_spawn, sizeof(file_content.num_words_spawn));
-	fp.read((char*)& file_content.checksum, sizeof(file_content.checksum));
-
-	// check if every Element in the file is correct and inside its range
-	if (calculate_checksum() != file_content.checksum)
-		return -1;
-	if (file_content.boundary_id >= NUM_BOUNDS || file_content.boundary_id < 0)
-		return -1;
-	if (file_content.font_id < 0 || file_content.font_id >= NUM_FONTS)
-		return -1;
-	if (file_content.num_words_spawn < MIN_NUM_WORDS || file_content.num_words_spawn > MAX_NUM_WORDS)
-		return -1;
-
-	file_state = GOOD;
-
-	return 0;
-}
-
-// create a new settings file with default values. used when the file doesn't exist yet, or if the current file is corrupted.
-void SettingsFileParser::create_settings_file()
-{
-	file_state = CREATE_NEW;
-
-	fp.close();
-	fp.open(filename, ios::binary | ios::out | ios::in | ios::trunc);	// open the file again in truncate mode to erase everything and create a new file if not already existing
-	if (!fp.good())	// check error state
-	{
-		file_state = CREATE_NEW_FAIL;
-		return;
-	}
-
-	// write the default file content to the file
-	init_file_content();
-	fp.write((char*)& file_content.hi_score, sizeof(file_content.hi_score));
-	fp.write((char*)& file_content.boundary_id, sizeof(file_content.boundary_id));
-	fp.write((char*)& file_content.font_id, sizeof(file_content.font_id));
-	fp.write((char*)& file_content.num_words_spawn, sizeof(file_content.num_words_spawn));
-	file_content.checksum = calculate_checksum();
-	fp.write((char*)& file_content.checksum, sizeof(file_content.checksum));
-	fp.flush();		// flush the output buffer, to send the buffer to the file
-}
-
-// returns the hi-score
-unsigned int SettingsFileParser::getHiScore()
-{
-	return file_content.hi_score;
-}
-
-// set a new hi-score and save it into the file
-// score: input. new hi-score to set
-void SettingsFileParser::setSaveHiScore(unsigned int score)
-{
-	file_content.hi_score = score;
-
-	if (!fp.good())	// check error state
-		return;
-
-	fp.seekp(0, fp.beg);		// set the position of the output stream filepointer. the hi-score is saved at the beginning of the file
-	fp.write((char*)& file_content.hi_score, sizeof(file_content.hi_score));
-
-	updateChecksum();
-}
-
-// set boundary_id in the struct filecontent
-// boundary: input. boundary_id to set
-void SettingsFileParser::setBoundaryID(int boundary)
-{
-	if (boundary < 0 || boundary >= NUM_BOUNDS)
-		return;
-	file_content.boundary_id = boundary;
-}
-
-// save boundary_id to the file
-void SettingsFileParser::saveBoundaryID()
-{
-	if (!fp.good())	// check error state
-		return;
-
-	fp.seekp(sizeof(file_content.hi_score), fp.beg);		// set the position of the output stream filepointer. The first Parameter marks the offset from the second Parameter
-	fp.write((char*)& file_content.boundary_id, sizeof(file_content.boundary_id));
-
-	updateChecksum();
-}
-
-// returns boundary_id
-// bound_descr: output. if not NULL, get a descriptive text to the returned boundary_id
-int SettingsFileParser::getBoundaryID(string* bound_descr)
-{
-	if (bound_descr != NULL)
-	{
-		if (file_content.boundary_id == RECT)
-			*bound_descr = "Rectangle";
-		else if (file_content.boundary_id == CIRC)
-			*bound_descr = "Circle";
-		else
-			*bound_descr = "";
-	}
-
-	return file_content.boundary_id;
-}
-
-// set font_id in the struct filecontent
-// font_identifier: input. font_id to set
-void SettingsFileParser::setFontID(int font_identifier)
-{
-	if (font_identifier < 0 || font_identifier >= NUM_FONTS)
-		return;
-	file_content.font_id = font_identifier;
-}
-
-// save font_id to the file
-void SettingsFileParser::saveFontID()
-{
-	if (!fp.good())	// check error state
-		return;
-
-	// set the position of the output stream filepointer. The first Parameter marks the offset from the second Parameter
-	fp.seekp(sizeof(file_content.hi_score) + sizeof(file_content.boundary_id), fp.beg);
-	fp.write((char*)& file_content.font_id, sizeof(file_content.font_id));
-
-	updateChecksum();
-}
-
-// returns font_id
-// font_name: output. if not NULL, get the name of the current font (which is the font filename)
-int SettingsFileParser::getFontID(string* font_name)
-{
-	if (font_name != NULL)
-	{
-		if (file_content.font_id == ARIAL)
-			*font_name = "arial";
-		else if (file_content.font_id == TIMES)
-			*font_name = "times";
-		else if (file_content.font_id == CONSOLAS)
-			*font_name = "consola";
-		else if (file_content.font_id == OLDENGL)
-			*font_name = "OLDENGL";
-		else
-			*font_name = "";
-	}
-
-	return file_content.font_id;
-}
-
-// set num_words_spawn in the struct filecontent
-// max_n_words: input. num_words_spawn to set
-void SettingsFileParser::setNumWordsSpawn(unsigned int max_n_words)
-{
-	if (max_n_words < MIN_NUM_WORDS || max_n_words > MAX_NUM_WORDS)
-		return;
-	file_content.num_words_spawn = max_n_words;
-}
-
-// save num_words_spawn to the file
-void SettingsFileParser::saveNumWordsSpawn()
-{
-	if (!fp.good())	// check error state
-		return;
-
-	// set the position of the output stream filepointer. The first Parameter marks the offset from the second Parameter
-	fp.seekp(sizeof(file_content.hi_score) + sizeof(file_content.boundary_id) + sizeof(file_content.font_id), fp.beg);
-	fp.write((char*)& file_content.num_words_spawn, sizeof(file_content.num_words_spawn));
-
-	updateChecksum();
-}
-
-// returns num_words_spawn
-unsigned int SettingsFileParser::getNumWordsSpawn()
-{
-	return file_content.num_words_spawn;
-}
-
-
-// Default constructor. Because the constructor of the parent class needs an Argument for its constructor (no default constructor),
-// the constructor with its argument must be called here explicitly
-GameSettings::GameSettings() : SettingsFileParser("resources/settings.bin")
-{
-	window_size.x = 1200;
-	window_size.y = 800;
-	setFont(getFontID());		// get the font id from the settings file and set the font
-	game_state = START_SCREEN;	// set the game to its initial state
-	wordlist_csv_filename = "resources/word_list.csv";
-	csv_delimiter = ';';
-}
-
-// returns a constant reference to the font object of this class. This reference can be supplied to the text objects of this program.
-// As long as a text object uses a reference to this font, the font object shall not be destroyed
-const sf::Font& GameSettings::getFont()
-{
-	return font;
-}
-
-// load a new font according to its ID. set the new font also in the SettingsFileParser class (but not save it)
-// when the font is loaded from the file, the changed font is applied to all objects that use the reference to this font object
-void GameSettings::setFont(int font_identifier)
-{
-	setFontID(font_identifier);
-	string font_path;
-	getFontID(&font_path);
-	font_path = "resources/fonts/" + font_path + ".ttf";	// insert the name of the font into the full path
-
-	if (!font.loadFromFile(font_path))
-		throw - 1;
-}
-
-// returns the window size of the program
-sf::Vector2f& GameSettings::get_window_size()
-{
-	return window_size;
-}
+#include <array>
+#include <cstring>
+#include "GameSettings.h"
+#include "ByteOrder.h"
+#include "CSVTokenizer.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor. read the settings file
+// check if file has the correct format and if the checksum is correct. If not create a new default file
+// settings_filename: input. path of the settings file
+SettingsFileParser::SettingsFileParser(const string& settings_filename)
+{
+	filename = settings_filename;
+	file_state = GOOD;
+	read_only = false;
+	max_num_words = MAX_NUM_WORDS;
+
+	init_file_content();
+
+	if (check_settings_file() < 0)
+	{
+		create_settings_file();
+	}
+}
+
+// prevent any writing to the settings file. The settings can still be changed, but they are not saved.
+// used when the game logic is run by a simulation, so the Hi-Score of the player is not overwritten.
+// enable: input. true: don't write to the file anymore. false: write to the file again
+void SettingsFileParser::set_read_only(bool enable)
+{
+	read_only = enable;
+}
+
+// raise (or lower) the upper limit of the number of words that can be set with setNumWordsSpawn().
+// used by the stress test to put far more words on the playfield than the options allow. The settings should be read only then,
+// because a number of words above MAX_NUM_WORDS is not accepted when the settings file is loaded.
+// max_n_words: input. new upper limit. values below MIN_NUM_WORDS are ignored
+void SettingsFileParser::set_max_num_words(unsigned int max_n_words)
+{
+	if (max_n_words < MIN_NUM_WORDS)
+		return;
+	max_num_words = max_n_words;
+}
+
+// calculate the lookup table of calculate_crc32(): the CRC32 of every byte value
+// return: the table
+static array<sf::Uint32, 256> make_crc_table()
+{
+	array<sf::Uint32, 256> crc_table;
+	for (sf::Uint32 i = 0; i < 256; i++)
+	{
+		sf::Uint32 crc = i;
+		for (unsigned int bit = 0; bit < 8; bit++)
+			crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+		crc_table[i] = crc;
+	}
+	return crc_table;
+}
+
+// calculate the CRC32 (polynomial 0x04C11DB7 in reflected form, same as zlib) of a buffer.
+// The lookup table is calculated once on the first call. it is a static local variable, so the initialization is thread safe if several threads save or load at the same time
+// data: input. bytes to calculate the checksum of
+// size: input. number of bytes
+// return: calculated checksum
+sf::Uint32 SettingsFileParser::calculate_crc32(const char* data, size_t size)
+{
+	static const array<sf::Uint32, 256> crc_table = make_crc_table();
+
+	sf::Uint32 crc = 0xFFFFFFFF;
+	for (size_t i = 0; i < size; i++)
+		crc = crc_table[(crc ^ (sf::Uint8)data[i]) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFF;
+}
+
+static const char file_magic[4] = { 'T', 'G', 'S', 'F' };	// first bytes of every settings file in the current format
+
+// append a record with a number as value to a buffer
+// buffer: input/ output. the record is appended at the end
+// tag: input. tag of the record
+// value: input. value of the record
+// num_bytes: input. size of the value in bytes (at most 4)
+static void append_record(vector<char>& buffer, unsigned int tag, sf::Uint32 value, unsigned int num_bytes)
+{
+	append_uint_le(buffer, tag, 2);
+	append_uint_le(buffer, num_bytes, 2);
+	append_uint_le(buffer, value, num_bytes);
+}
+
+// checksum of the settings files of older versions: all bytes (as signed char) before the checksum added together
+// data: input. file content
+// size: input. number of bytes before the checksum
+// return: calculated checksum
+static int calculate_legacy_checksum(const char* data, size_t size)
+{
+	int check_sum = 0;
+	for (size_t i = 0; i < size; i++)
+		check_sum += data[i];
+	return check_sum;
+}
+
+// set all the Elements of struct filecontent to their defaults
+inline void SettingsFileParser::init_file_content()
+{
+	file_content.hi_score = 0;
+	file_content.boundary_id = RECT;
+	file_content.font_id = ARIAL;
+	file_content.num_words_spawn = MIN_NUM_WORDS;
+	file_content.physics_tick_rate = DEFAULT_PHYSICS_TICK_RATE;
+	file_content.word_mode = ADAPTIVE_WORDS;
+	file_content.frame_pacing = FramePacer::VSYNC;
+	file_content.fps_cap = FramePacer::DEFAULT_FPS_CAP;
+	unknown_records.clear();
+}
+
+// write the header, a record for every Element of struct filecontent, the unknown records and the checksum into a buffer
+// buffer: output. complete content of the file
+void SettingsFileParser::serialize_file_content(vector<char>& buffer)
+{
+	buffer.assign(file_magic, file_magic + sizeof(file_magic));	// replaces the old content. insert() after clear() lets GCC 12 warn about a bogus out of bounds write (-Warray-bounds)
+	append_uint_le(buffer, FORMAT_VERSION, 2);
+
+	append_record(buffer, TAG_HI_SCORE, file_content.hi_score, 4);
+	append_record(buffer, TAG_BOUNDARY_ID, (sf::Uint8)file_content.boundary_id, 1);
+	append_record(buffer, TAG_FONT_ID, (sf::Uint8)file_content.font_id, 1);
+	append_record(buffer, TAG_NUM_WORDS_SPAWN, file_content.num_words_spawn, 4);
+	append_record(buffer, TAG_PHYSICS_TICK_RATE, file_content.physics_tick_rate, 2);
+	append_record(buffer, TAG_WORD_MODE, (sf::Uint8)file_content.word_mode, 1);
+	append_record(buffer, TAG_FRAME_PACING, (sf::Uint8)file_content.frame_pacing, 1);
+	append_record(buffer, TAG_FPS_CAP, file_content.fps_cap, 2);
+	buffer.insert(buffer.end(), unknown_records.begin(), unknown_records.end());
+
+	append_uint_le(buffer, calculate_crc32(buffer.data(), buffer.size()), CHECKSUM_LENGTH);
+}
+
+// take over the value of a record into the struct filecontent. A value that is out of range or has the wrong length is ignored, so the setting keeps its default.
+// tag: input. tag of the record. must be a known tag
+// value: input. value of the record
+// length: input. length of the value in bytes
+void SettingsFileParser::read_record(unsigned int tag, const char* value, unsigned int length)
+{
+	switch (tag)
+	{
+	case TAG_HI_SCORE:
+		if (length == 4)
+			file_content.hi_score = (unsigned int)read_uint_le(value, length);
+		break;
+	case TAG_BOUNDARY_ID:
+		if (length == 1 && read_uint_le(value, length) < NUM_BOUNDS)
+			file_content.boundary_id = (char)read_uint_le(value, length);
+		break;
+	case TAG_FONT_ID:
+		if (length == 1 && read_uint_le(value, length) < NUM_FONTS)
+			file_content.font_id = (char)read_uint_le(value, length);
+		break;
+	case TAG_NUM_WORDS_SPAWN:
+		if (length == 4 && read_uint_le(value, length) >= MIN_NUM_WORDS && read_uint_le(value, length) <= MAX_NUM_WORDS)
+			file_content.num_words_spawn = (unsigned int)read_uint_le(value, length);
+		break;
+	case TAG_PHYSICS_TICK_RATE:
+		if (length == 2 && read_uint_le(value, length) >= MIN_PHYSICS_TICK_RATE && read_uint_le(value, length) <= MAX_PHYSICS_TICK_RATE)
+			file_content.physics_tick_rate = (unsigned short)read_uint_le(value, length);
+		break;
+	case TAG_WORD_MODE:
+		if (length == 1 && read_uint_le(value, length) < NUM_WORD_MODES)
+			file_content.word_mode = (char)read_uint_le(value, length);
+		break;
+	case TAG_FRAME_PACING:
+		if (length == 1 && read_uint_le(value, length) < FramePacer::NUM_PACING_MODES)
+			file_content.frame_pacing = (char)read_uint_le(value, length);
+		break;
+	case TAG_FPS_CAP:
+		if (length == 2 && read_uint_le(value, length) >= FramePacer::MIN_FPS_CAP && read_uint_le(value, length) <= FramePacer::MAX_FPS_CAP)
+			file_content.fps_cap = (unsigned short)read_uint_le(value, length);
+		break;
+	}
+}
+
+// read the settings file with one read and save every setting into the struct filecontent.
+// check the header, the checksum and that the records fill the file exactly. Records with an unknown tag are kept in unknown_records.
+// files in the format of an older version are converted (see check_legacy_settings_file())
+// return: -1 if file is not ok. 0 if no error
+int SettingsFileParser::check_settings_file()
+{
+	ifstream fin(filename, ios::binary);
+	if (!fin.good())	// check error state
+		return -1;
+
+	// read out the whole file content
+	fin.seekg(0, fin.end);
+	streamoff file_size = fin.tellg();
+	if (file_size <= 0 || file_size > MAX_FILE_LENGTH)
+		return -1;
+	vector<char> buffer((size_t)file_size);
+	fin.seekg(0, fin.beg);
+	fin.read(buffer.data(), buffer.size());
+	if (fin.gcount() != file_size)
+		return -1;
+
+	if (buffer.size() < HEADER_LENGTH + CHECKSUM_LENGTH || memcmp(buffer.data(), file_magic, sizeof(file_magic)) != 0)
+		return check_legacy_settings_file(buffer);
+
+	// a newer format version can be read as well, because the records of known tags keep their meaning
+	size_t data_length = buffer.size() - CHECKSUM_LENGTH;
+	if (read_uint_le(buffer.data() + data_length, CHECKSUM_LENGTH) != calculate_crc32(buffer.data(), data_length))
+		return -1;
+
+	// check the structure of all records first, so nothing is taken over from a broken file
+	size_t offset = HEADER_LENGTH;
+	while (offset < data_length)
+	{
+		if (offset + RECORD_HEADER_LENGTH > data_length)
+			return -1;
+		offset += RECORD_HEADER_LENGTH + (unsigned int)read_uint_le(buffer.data() + offset + 2, 2);
+	}
+	if (offset != data_length)	// the last record must end exactly before the checksum
+		return -1;
+
+	for (offset = HEADER_LENGTH; offset < data_length; )
+	{
+		unsigned int tag = (unsigned int)read_uint_le(buffer.data() + offset, 2);
+		unsigned int length = (unsigned int)read_uint_le(buffer.data() + offset + 2, 2);
+		if (tag >= TAG_HI_SCORE && tag <= TAG_FPS_CAP)
+			read_record(tag, buffer.data() + offset + RECORD_HEADER_LENGTH, length);
+		else
+			unknown_records.insert(unknown_records.end(), buffer.begin() + offset, buffer.begin() + offset + RECORD_HEADER_LENGTH + length);
+		offset += RECORD_HEADER_LENGTH + length;
+	}
+
+	file_state = GOOD;
+
+	return 0;
+}
+
+// read a settings file of format version 1: hi_score (4 bytes), boundary_id (1 byte), font_id (1 byte), num_words_spawn (4 bytes), checksum (4 bytes).
+// The numbers are in the byte order of the machine. The checksum is a CRC32 or (in even older files) the sum of all bytes.
+// The file is converted to the current format right away. The settings that didn't exist in version 1 get their defaults.
+// buffer: input. complete content of the file
+// return: -1 if file is not ok. 0 if no error
+int SettingsFileParser::check_legacy_settings_file(const vector<char>& buffer)
+{
+	if (buffer.size() != LEGACY_FILE_LENGTH)
+		return -1;
+
+	unsigned int hi_score, num_words_spawn;
+	sf::Uint32 checksum;
+	size_t data_length = LEGACY_FILE_LENGTH - sizeof(checksum);
+	memcpy(&hi_score, buffer.data(), sizeof(hi_score));
+	memcpy(&num_words_spawn, buffer.data() + 6, sizeof(num_words_spawn));
+	memcpy(&checksum, buffer.data() + data_length, sizeof(checksum));
+	char boundary_id = buffer[4];
+	char font_id = buffer[5];
+
+	// check if every Element in the file is correct and inside its range
+	if (calculate_crc32(buffer.data(), data_length) != checksum && (sf::Uint32)calculate_legacy_checksum(buffer.data(), data_length) != checksum)
+		return -1;
+	if (boundary_id >= NUM_BOUNDS || boundary_id < 0 || font_id < 0 || font_id >= NUM_FONTS ||
+		num_words_spawn < MIN_NUM_WORDS || num_words_spawn > MAX_NUM_WORDS)
+		return -1;
+
+	file_content.hi_score = hi_score;
+	file_content.boundary_id = boundary_id;
+	file_content.font_id = font_id;
+	file_content.num_words_spawn = num_words_spawn;
+
+	// replace the old file. if this fails, the old file is still valid and is converted again on the next start
+	vector<char> new_buffer;
+	serialize_file_content(new_buffer);
+	PersistenceWorker::write_file_atomic(filename, new_buffer.data(), new_buffer.size());
+	file_state = MIGRATED;
+
+	return 0;
+}
+
+// create a new settings file with default values. used when the file doesn't exist yet, or if the current file is corrupted.
+// the file is written immediately (not by the PersistenceWorker), because the result is shown on the Start Screen
+void SettingsFileParser::create_settings_file()
+{
+	TRACE_ZONE("settings create_settings_file");
+	file_state = CREATE_NEW;
+
+	// write the default file content to the file
+	init_file_content();
+	vector<char> buffer;
+	serialize_file_content(buffer);
+	if (PersistenceWorker::write_file_atomic(filename, buffer.data(), buffer.size()) < 0)
+		file_state = CREATE_NEW_FAIL;
+}
+
+// queue the whole struct filecontent to be written to the settings file by the PersistenceWorker.
+// The file is replaced atomically (see PersistenceWorker::write_file_atomic()). Repeated saves in a short time are written only once.
+void SettingsFileParser::save_settings_file()
+{
+	if (read_only)	// check if writing is allowed
+		return;
+
+	vector<char> buffer;
+	serialize_file_content(buffer);
+	persistence.request_write(filename, buffer.data(), buffer.size());
+}
+
+// wait until all queued saves are written to the file
+void SettingsFileParser::flush_saves()
+{
+	persistence.flush();
+}
+
+// returns true if the last save couldn't be written to the file. Then the game shows a warning, because the settings and the Hi-Score are not saved
+bool SettingsFileParser::has_save_failed()
+{
+	return persistence.has_write_failed();
+}
+
+// returns the hi-score
+unsigned int SettingsFileParser::getHiScore()
+{
+	return file_content.hi_score;
+}
+
+// set a new hi-score and save it into the file
+// score: input. new hi-score to set
+void SettingsFileParser::setSaveHiScore(unsigned int score)
+{
+	TRACE_ZONE("settings setSaveHiScore");
+	file_content.hi_score = score;
+	save_settings_file();
+}
+
+// set boundary_id in the struct filecontent
+// boundary: input. boundary_id to set
+void SettingsFileParser::setBoundaryID(int boundary)
+{
+	if (boundary < 0 || boundary >= NUM_BOUNDS)
+		return;
+	file_content.boundary_id = boundary;
+}
+
+// save boundary_id to the file
+void SettingsFileParser::saveBoundaryID()
+{
+	TRACE_ZONE("settings saveBoundaryID");
+	save_settings_file();
+}
+
+// returns boundary_id
+// bound_descr: output. if not NULL, get a descriptive text to the returned boundary_id
+int SettingsFileParser::getBoundaryID(string* bound_descr)
+{
+	if (bound_descr != NULL)
+	{
+		if (file_content.boundary_id == RECT)
+			*bound_descr = "Rectangle";
+		else if (file_content.boundary_id == CIRC)
+			*bound_descr = "Circle";
+		else
+			*bound_descr = "";
+	}
+
+	return file_content.boundary_id;
+}
+
+// set font_id in the struct filecontent
+// font_identifier: input. font_id to set
+void SettingsFileParser::setFontID(int font_identifier)
+{
+	if (font_identifier < 0 || font_identifier >= NUM_FONTS)
+		return;
+	file_content.font_id = font_identifier;
+}
+
+// save font_id to the file
+void SettingsFileParser::saveFontID()
+{
+	TRACE_ZONE("settings saveFontID");
+	save_settings_file();
+}
+
+// returns font_id
+// font_name: output. if not NULL, get the name of the current font (which is the font filename)
+int SettingsFileParser::getFontID(string* font_name)
+{
+	if (font_name != NULL)
+		*font_name = get_font_name(file_content.font_id);
+
+	return file_content.font_id;
+}
+
+// returns the name of a font (which is the font filename without the extension). empty if the font id is invalid
+// font_identifier: input. the font id
+string SettingsFileParser::get_font_name(int font_identifier)
+{
+	if (font_identifier == ARIAL)
+		return "arial";
+	else if (font_identifier == TIMES)
+		return "times";
+	else if (font_identifier == CONSOLAS)
+		return "consola";
+	else if (font_identifier == OLDENGL)
+		return "OLDENGL";
+	else
+		return "";
+}
+
+// set num_words_spawn in the struct filecontent
+// max_n_words: input. num_words_spawn to set
+void SettingsFileParser::setNumWordsSpawn(unsigned int max_n_words)
+{
+	if (max_n_words < MIN_NUM_WORDS || max_n_words > max_num_words)
+		return;
+	file_content.num_words_spawn = max_n_words;
+}
+
+// save num_words_spawn to the file
+void SettingsFileParser::saveNumWordsSpawn()
+{
+	TRACE_ZONE("settings saveNumWordsSpawn");
+	save_settings_file();
+}
+
+// returns num_words_spawn
+unsigned int SettingsFileParser::getNumWordsSpawn()
+{
+	return file_content.num_words_spawn;
+}
+
+// set physics_tick_rate in the struct filecontent
+// tick_rate: input. physics ticks per second
+void SettingsFileParser::setPhysicsTickRate(unsigned int tick_rate)
+{
+	if (tick_rate < MIN_PHYSICS_TICK_RATE || tick_rate > MAX_PHYSICS_TICK_RATE)
+		return;
+	file_content.physics_tick_rate = (unsigned short)tick_rate;
+}
+
+// save physics_tick_rate to the file
+void SettingsFileParser::savePhysicsTickRate()
+{
+	TRACE_ZONE("settings savePhysicsTickRate");
+	save_settings_file();
+}
+
+// returns physics_tick_rate. in ticks per second. can be called by any thread
+unsigned int SettingsFileParser::getPhysicsTickRate()
+{
+	return file_content.physics_tick_rate;
+}
+
+// set word_mode in the struct filecontent
+// mode: input. word_mode to set
+void SettingsFileParser::setWordMode(int mode)
+{
+	if (mode < 0 || mode >= NUM_WORD_MODES)
+		return;
+	file_content.word_mode = mode;
+}
+
+// save word_mode to the file
+void SettingsFileParser::saveWordMode()
+{
+	TRACE_ZONE("settings saveWordMode");
+	save_settings_file();
+}
+
+// returns word_mode
+// mode_descr: output. if not NULL, get a descriptive text to the returned word_mode
+int SettingsFileParser::getWordMode(string* mode_descr)
+{
+	if (mode_descr != NULL)
+	{
+		if (file_content.word_mode == RANDOM_WORDS)
+			*mode_descr = "Random";
+		else if (file_content.word_mode == ADAPTIVE_WORDS)
+			*mode_descr = "Adaptive";
+		else if (file_content.word_mode == RAMP_WORDS)
+			*mode_descr = "Ramp";
+		else
+			*mode_descr = "";
+	}
+
+	return file_content.word_mode;
+}
+
+// set frame_pacing and fps_cap in the struct filecontent
+// pacing_mode: input. see FramePacer::pacing_modes
+// fps_cap: input. frame rate of the FPS_CAP mode. in frames per second
+void SettingsFileParser::setFramePacing(int pacing_mode, unsigned int fps_cap)
+{
+	if (pacing_mode < 0 || pacing_mode >= FramePacer::NUM_PACING_MODES || fps_cap < FramePacer::MIN_FPS_CAP || fps_cap > FramePacer::MAX_FPS_CAP)
+		return;
+	file_content.frame_pacing = (char)pacing_mode;
+	file_content.fps_cap = (unsigned short)fps_cap;
+}
+
+// save frame_pacing and fps_cap to the file
+void SettingsFileParser::saveFramePacing()
+{
+	TRACE_ZONE("settings saveFramePacing");
+	save_settings_file();
+}
+
+// returns frame_pacing
+// pacing_descr: output. if not NULL, get a descriptive text to the returned frame_pacing (including the fps_cap)
+int SettingsFileParser::getFramePacing(string* pacing_descr)
+{
+	if (pacing_descr != NULL)
+		*pacing_descr = FramePacer::get_mode_name(file_content.frame_pacing, file_content.fps_cap);
+	return file_content.frame_pacing;
+}
+
+// returns fps_cap. in frames per second
+unsigned int SettingsFileParser::getFpsCap()
+{
+	return file_content.fps_cap;
+}
+
+
+// Default constructor. Because the constructor of the parent class needs an Argument for its constructor (no default constructor),
+// the constructor with its argument must be called here explicitly
+GameSettings::GameSettings() : SettingsFileParser("resources/settings.bin"), score_history("resources/score_history.bin", persistence),
+	keystroke_recorder("resources/keystrokes.bin", persistence)
+{
+	window_size.x = 1200;
+	window_size.y = 800;
+	game_state = SPLASH_SCREEN;	// set the game to its initial state
+	wordlist_csv_filename = "resources/word_list.CSV";	// same case as the file name, because file names are case sensitive on linux
+	csv_delimiter = ';';
+	csv_column = CSVTokenizer::ALL_COLUMNS;
+
+	vector<string> font_paths;
+	for (int i = 0; i < NUM_FONTS; i++)
+		font_paths.push_back("resources/fonts/" + get_font_name(i) + ".ttf");	// insert the name of the font into the full path
+	font_manager.init(resources, font_paths);
+
+	// load the assets in the background (see load_phases). the font of the settings file is loaded first, because every screen needs it
+	unsigned int first_font = (unsigned int)getFontID();
+	asset_loader.add_phase("font", [this, first_font]()
+		{
+			font_manager.load_font(first_font);
+			if (!font_manager.is_loaded(first_font))
+				throw ResourceLoadError(font_manager.get_filename(first_font), "font");
+		});
+	asset_loader.add_phase("textures", [this]() { resources.preload({ "resources/textures/Sidepanel.png" }, {}); });	// the fonts are loaded by the font_manager
+	asset_loader.add_phase("word list", [this]() { word_list_watcher.load(wordlist_csv_filename, csv_delimiter, csv_column); });
+	asset_loader.add_phase("all fonts", [this]() { font_manager.load_remaining(); });
+	asset_loader.set_skip_handler([this]() { font_manager.cancel_pending(); });	// a failed phase skips "all fonts". a font request must not wait for it forever
+	asset_loader.start();
+}
+
+// prevent the saving of the settings and the storing of finished rounds and keystrokes. used by simulations, so the Hi-Score and the history of the player are not changed
+// enable: input. true: don't save anything. false: save again
+void GameSettings::set_read_only(bool enable)
+{
+	SettingsFileParser::set_read_only(enable);
+	score_history.set_read_only(enable);
+	keystroke_recorder.set_read_only(enable);
+}
+
+// returns the history of all finished rounds
+ScoreHistory& GameSettings::get_score_history()
+{
+	return score_history;
+}
+
+// returns the recorder of the keystrokes of all rounds
+KeystrokeRecorder& GameSettings::get_keystroke_recorder()
+{
+	return keystroke_recorder;
+}
+
+// returns the cache of all textures and fonts
+ResourceManager& GameSettings::get_resources()
+{
+	return resources;
+}
+
+// returns the loader of the fonts, the textures and the word list. used to wait for an asset or to query the progress of the loading
+AssetLoader& GameSettings::get_asset_loader()
+{
+	return asset_loader;
+}
+
+// returns true if every asset of the Playfield is loaded (the textures and the word list). doesn't wait
+bool GameSettings::is_playable()
+{
+	return asset_loader.is_done(TEXTURE_PHASE) && asset_loader.is_done(WORD_LIST_PHASE);
+}
+
+// wait until every asset of the Playfield is loaded. throws the exception of a failed load phase (e.g. ResourceLoadError)
+void GameSettings::wait_until_playable()
+{
+	asset_loader.wait_for(TEXTURE_PHASE);
+	asset_loader.wait_for(WORD_LIST_PHASE);
+}
+
+// returns the watcher that loads and reloads the word list
+WordListWatcher& GameSettings::get_word_list_watcher()
+{
+	return word_list_watcher;
+}
+
+// returns a constant reference to the current font. This reference can be supplied to the text objects of this program.
+// the font objects of all fonts exist as long as the GameSettings. After a font change, the text objects must get the new font with setFont()
+const sf::Font& GameSettings::getFont()
+{
+	return font_manager.get_font(getFontID());
+}
+
+// select a new font according to its ID. set the new font also in the SettingsFileParser class (but not save it)
+// all fonts are loaded when the game starts (see FontManager), so there is no disk access here
+// throws ResourceLoadError if the font can't be loaded
+void GameSettings::setFont(int font_identifier)
+{
+	setFontID(font_identifier);
+	if (!font_manager.is_loaded(getFontID()))
+		throw ResourceLoadError(font_manager.get_filename(getFontID()), "font");
+}
+
+// returns the window size of the program
+sf::Vector2f& GameSettings::get_window_size()
+{
+	return window_size;
+}
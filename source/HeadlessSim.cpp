@@ -0,0 +1,385 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include "HeadlessSim.h"
+#include "GameClock.h"
+#include "Playfield.h"
+
+using namespace std;
+
+// results of one simulated round
+typedef struct round_result
+{
+	int score;
+	unsigned int typed_words;
+	unsigned int missed_words;
+} round_result_t;
+
+// results of the whole headless simulation
+typedef struct headless_result
+{
+	unsigned long long ticks;		// number of simulated ticks (one update() and update_physics() call)
+	double simulated_seconds;		// simulated time of all rounds
+	double wall_seconds;			// real time that was needed to simulate all rounds
+	unsigned long long spawned_words;	// words that were created by the Playfield (see Playfield::get_spawned_words())
+	unsigned long long deleted_words;	// words that were deleted by the Playfield during the simulation (typed, missed or by restart())
+	unsigned long long words_left;		// words on the Playfield at the end of the simulation. deleted by the destructor of the Playfield after the time measurement
+	unsigned int keys_pressed;
+	unsigned int wrong_keys;
+	vector<round_result_t> rounds;
+} headless_result_t;
+
+// Constructor
+// words_per_minute: input. typing speed of the bot. one word is counted as 5 keystrokes
+// error_probability: input. probability (0...1) that a wrong key is pressed
+TypistBot::TypistBot(float words_per_minute, float error_probability)
+{
+	keys_pressed = 0;
+	wrong_keys = 0;
+	error_rate = error_probability;
+	if (words_per_minute <= 0)
+		words_per_minute = 1;
+	key_interval = sf::seconds(60 / (words_per_minute * 5));
+	next_key_time = sf::Time::Zero;
+}
+
+// choose the target word and create the key event for the next key press, if it is time to press a key
+// call this function repeatedly (and process the key event in between) until it returns false, because more than one key press can be due at the same time
+// word_list: input. words on the Playfield
+// now: input. current simulated time
+// key_evnt: output. key event that shall be processed by the Playfield
+// return: true if a key is pressed. false if no key is due or there is no word to type
+bool TypistBot::next_key(const list<Word*>& word_list, sf::Time now, sf::Event::KeyEvent& key_evnt)
+{
+	if (now < next_key_time)
+		return false;
+
+	// continue the word with the highest writing index. if no word is being typed, take the word that dies next
+	Word* target = NULL;
+	for (auto word_list_it = word_list.begin(); word_list_it != word_list.end(); word_list_it++)
+	{
+		Word* word = *word_list_it;
+		if (word->get_state() != Word::ALIVE || !is_typeable(word->getString()))
+			continue;
+		if (target == NULL || word->writing_index > target->writing_index ||
+			(word->writing_index == target->writing_index && word->health < target->health))
+			target = word;
+	}
+
+	if (target == NULL)		// nothing to type. wait one key interval before looking for a target again
+	{
+		next_key_time = now + key_interval;
+		return false;
+	}
+	next_key_time += key_interval;
+	if (next_key_time < now)	// don't catch up on key presses that were missed while there was nothing to type
+		next_key_time = now;
+
+	// the next character of the word, or the space key to finish the word if all characters were typed
+	sf::Uint32 expected_char = ' ';
+	if (target->writing_index < target->getString().getSize())
+		expected_char = target->getString()[target->writing_index];
+
+	sf::Uint32 pressed_char = expected_char;
+	if ((float)rand() / RAND_MAX < error_rate)
+	{
+		// press a random letter that is not the expected one
+		pressed_char = 'a' + rand() % 26;
+		if (pressed_char == expected_char)
+			pressed_char = (pressed_char == 'z') ? 'a' : pressed_char + 1;
+		wrong_keys++;
+	}
+
+	char_to_key_event(pressed_char, key_evnt);
+	keys_pressed++;
+	return true;
+}
+
+// convert a character to the key event that produces this character (inverse of the conversion in Word::key_pressed_processor())
+// character: input. character to convert
+// key_evnt: output. key event of the character
+// return: true if successful. false if the character can't be typed
+bool TypistBot::char_to_key_event(sf::Uint32 character, sf::Event::KeyEvent& key_evnt)
+{
+	key_evnt.code = sf::Keyboard::Unknown;
+	key_evnt.alt = false;
+	key_evnt.control = false;
+	key_evnt.shift = false;
+	key_evnt.system = false;
+
+	if (character >= 'a' && character <= 'z')
+	{
+		key_evnt.code = (sf::Keyboard::Key)(sf::Keyboard::A + (character - 'a'));
+	}
+	else if (character >= 'A' && character <= 'Z')
+	{
+		key_evnt.code = (sf::Keyboard::Key)(sf::Keyboard::A + (character - 'A'));
+		key_evnt.shift = true;
+	}
+	else if (character >= '0' && character <= '9')
+	{
+		key_evnt.code = (sf::Keyboard::Key)(sf::Keyboard::Num0 + (character - '0'));
+	}
+	else
+	{
+		// the special characters are on the same keys as on a german keyboard
+		switch (character)
+		{
+		case ' ':	key_evnt.code = sf::Keyboard::Space;	break;
+		case '\r':	key_evnt.code = sf::Keyboard::Enter;	break;
+		case '#':	key_evnt.code = sf::Keyboard::Slash;	break;
+		case '\'':	key_evnt.code = sf::Keyboard::Slash;	key_evnt.shift = true;	break;
+		case ',':	key_evnt.code = sf::Keyboard::Comma;	break;
+		case ';':	key_evnt.code = sf::Keyboard::Comma;	key_evnt.shift = true;	break;
+		case '-':	key_evnt.code = sf::Keyboard::Hyphen;	break;
+		case '_':	key_evnt.code = sf::Keyboard::Hyphen;	key_evnt.shift = true;	break;
+		case '.':	key_evnt.code = sf::Keyboard::Period;	break;
+		case ':':	key_evnt.code = sf::Keyboard::Period;	key_evnt.shift = true;	break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+// check if every character of a string can be typed with a key event
+// string: input. string to check
+// return: true if the string can be typed
+bool TypistBot::is_typeable(const sf::String& string)
+{
+	sf::Event::KeyEvent key_evnt;
+	for (size_t i = 0; i < string.getSize(); i++)
+	{
+		if (!char_to_key_event(string[i], key_evnt))
+			return false;
+	}
+	return true;
+}
+
+// print the command line options of the headless simulation
+static void print_headless_usage()
+{
+	cout << "usage: typing_game --headless [options]" << endl;
+	cout << "  --rounds <n>          number of rounds to play (default 1)" << endl;
+	cout << "  --wpm <n>             typing speed of the bot in words per minute (default 60)" << endl;
+	cout << "  --error-rate <p>      probability 0...1 that the bot presses a wrong key (default 0.05)" << endl;
+	cout << "  --tick-ms <t>         simulated time step in milliseconds (default 10)" << endl;
+	cout << "  --boundary rect|circ  playfield boundary (default: from the settings file)" << endl;
+	cout << "  --words <n>           number of words on the playfield (default: from the settings file)" << endl;
+	cout << "  --seed <n>            seed for the random numbers (default 1)" << endl;
+	cout << "  --report <file>       also write the results to a JSON file" << endl;
+}
+
+// parse the command line arguments of the headless simulation. The headless simulation is selected with the argument "--headless"
+// argc, argv: input. command line arguments of main()
+// config: output. configuration of the headless simulation. boundary_id and num_words are -1 / 0 if not given
+// return: 1 if the headless simulation was selected. 0 if not. -1 if an argument is invalid
+int parse_headless_args(int argc, char* argv[], headless_config_t& config)
+{
+	bool headless = false;
+
+	config.rounds = 1;
+	config.words_per_minute = 60;
+	config.error_rate = 0.05f;
+	config.tick_ms = 10;
+	config.boundary_id = -1;
+	config.num_words = 0;
+	config.seed = 1;
+	config.report_filename = "";
+
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		bool has_value = (i + 1 < argc);	// if there is an argument after the current one
+
+		if (arg == "--headless")
+			headless = true;
+		else if (arg == "--rounds" && has_value)
+			config.rounds = (unsigned int)atoi(argv[++i]);
+		else if (arg == "--wpm" && has_value)
+			config.words_per_minute = (float)atof(argv[++i]);
+		else if (arg == "--error-rate" && has_value)
+			config.error_rate = (float)atof(argv[++i]);
+		else if (arg == "--tick-ms" && has_value)
+			config.tick_ms = (float)atof(argv[++i]);
+		else if (arg == "--boundary" && has_value)
+		{
+			string bound = argv[++i];
+			if (bound == "rect")
+				config.boundary_id = GameSettings::RECT;
+			else if (bound == "circ")
+				config.boundary_id = GameSettings::CIRC;
+			else
+			{
+				print_headless_usage();
+				return -1;
+			}
+		}
+		else if (arg == "--words" && has_value)
+			config.num_words = (unsigned int)atoi(argv[++i]);
+		else if (arg == "--seed" && has_value)
+			config.seed = (unsigned int)atoi(argv[++i]);
+		else if (arg == "--report" && has_value)
+			config.report_filename = argv[++i];
+		else if (headless)
+		{
+			print_headless_usage();
+			return -1;
+		}
+	}
+
+	if (!headless)
+		return 0;
+
+	if (config.rounds == 0 || config.words_per_minute <= 0 || config.tick_ms <= 0 || config.error_rate < 0 || config.error_rate > 1)
+	{
+		print_headless_usage();
+		return -1;
+	}
+	return 1;
+}
+
+// play all rounds on a Playfield with the boundary type T
+// settings: input. game settings to create the Playfield
+// config: input. configuration of the simulation
+// result: output. results of the simulation
+template <typename T>
+static void simulate_rounds(GameSettings& settings, const headless_config_t& config, headless_result_t& result)
+{
+	Playfield<T> playfield(settings);
+	TypistBot bot(config.words_per_minute, config.error_rate);
+	sf::Time tick = sf::microseconds((sf::Int64)(config.tick_ms * 1000));
+	sf::Time sim_start = GameClock::now();
+	sf::Clock wall_clock;	// measures the real time
+	sf::Event::KeyEvent key_evnt;
+
+	for (unsigned int round = 0; round < config.rounds; round++)
+	{
+		if (round > 0)
+			playfield.restart();
+
+		while (playfield.is_game_running())
+		{
+			GameClock::advance_simulated_time(tick);
+
+			// in the game the key events are processed before update() (see main loop)
+			while (bot.next_key(playfield.get_word_list(), GameClock::now(), key_evnt))
+				playfield.key_pressed_processor(key_evnt);
+			playfield.update();
+			playfield.update_physics();
+
+			result.ticks++;
+		}
+
+		round_result_t round_result;
+		round_result.score = playfield.get_score();
+		round_result.typed_words = playfield.get_typed_words();
+		round_result.missed_words = playfield.get_missed_words();
+		result.rounds.push_back(round_result);
+	}
+
+	result.wall_seconds = wall_clock.getElapsedTime().asSeconds();
+	result.spawned_words = playfield.get_spawned_words();
+	result.deleted_words = playfield.get_deleted_words();
+	result.words_left = playfield.get_word_list().size();
+	result.simulated_seconds = (GameClock::now() - sim_start).asSeconds();
+	result.keys_pressed = bot.keys_pressed;
+	result.wrong_keys = bot.wrong_keys;
+}
+
+// write the results of the simulation to a JSON file
+// filename: input. path of the report file
+// config: input. configuration of the simulation
+// result: input. results of the simulation
+// return: -1 if the file can't be written. 0 if no error
+static int write_json_report(const string& filename, const headless_config_t& config, const headless_result_t& result)
+{
+	ofstream fout(filename);
+	if (!fout.good())	// check error state
+		return -1;
+
+	fout << "{\n";
+	fout << "  \"config\": {\"rounds\": " << config.rounds << ", \"wpm\": " << config.words_per_minute << ", \"error_rate\": " << config.error_rate
+		<< ", \"tick_ms\": " << config.tick_ms << ", \"boundary_id\": " << config.boundary_id << ", \"num_words\": " << config.num_words
+		<< ", \"seed\": " << config.seed << "},\n";
+	fout << "  \"ticks\": " << result.ticks << ",\n";
+	fout << "  \"simulated_seconds\": " << result.simulated_seconds << ",\n";
+	fout << "  \"wall_seconds\": " << result.wall_seconds << ",\n";
+	fout << "  \"ticks_per_second\": " << result.ticks / result.wall_seconds << ",\n";
+	fout << "  \"spawned_words\": " << result.spawned_words << ",\n";
+	fout << "  \"spawned_words_per_second\": " << result.spawned_words / result.wall_seconds << ",\n";
+	fout << "  \"deleted_words\": " << result.deleted_words << ",\n";
+	fout << "  \"deleted_words_per_second\": " << result.deleted_words / result.wall_seconds << ",\n";
+	fout << "  \"words_left\": " << result.words_left << ",\n";
+	fout << "  \"keys_pressed\": " << result.keys_pressed << ",\n";
+	fout << "  \"wrong_keys\": " << result.wrong_keys << ",\n";
+	fout << "  \"rounds\": [";
+	for (size_t i = 0; i < result.rounds.size(); i++)
+	{
+		fout << (i ? ", " : "") << "{\"score\": " << result.rounds[i].score << ", \"typed_words\": " << result.rounds[i].typed_words
+			<< ", \"missed_words\": " << result.rounds[i].missed_words << "}";
+	}
+	fout << "]\n";
+	fout << "}\n";
+
+	return fout.good() ? 0 : -1;
+}
+
+// run the game logic of the Playfield without a window. The time is simulated and the key events are generated by a TypistBot.
+// nothing is drawn, the Playfield update functions are called directly one after the other (there is no physics thread).
+// settings: input. game settings. the settings are changed according to the configuration, but not saved
+// config: input. configuration of the simulation
+// return: exit code for main(). 0 if no error
+int run_headless_simulation(GameSettings& settings, const headless_config_t& config)
+{
+	headless_result_t result = {};
+
+	settings.set_read_only(true);	// don't overwrite the Hi-Score of the player
+	if (config.boundary_id >= 0)
+		settings.setBoundaryID(config.boundary_id);
+	if (config.num_words > 0)
+		settings.setNumWordsSpawn(config.num_words);
+	GameClock::set_simulated(true);	// must be set before any game object is created
+	srand(config.seed);
+
+	switch (settings.getBoundaryID())
+	{
+	case GameSettings::RECT:
+		simulate_rounds<sf::RectangleShape>(settings, config, result);
+		break;
+	case GameSettings::CIRC:
+		simulate_rounds<sf::CircleShape>(settings, config, result);
+		break;
+	}
+
+	string bound_descr;
+	settings.getBoundaryID(&bound_descr);
+	double wall_seconds = result.wall_seconds > 0 ? result.wall_seconds : 1e-9;	// avoid a division by 0 for very short runs
+
+	cout << "headless simulation: " << config.rounds << " round(s), boundary " << bound_descr << ", " << settings.getNumWordsSpawn() << " words, "
+		<< config.words_per_minute << " wpm, error rate " << config.error_rate << ", tick " << config.tick_ms << " ms" << endl;
+	cout << "simulated time: " << result.simulated_seconds << " s, wall time: " << result.wall_seconds << " s" << endl;
+	cout << "ticks: " << result.ticks << " (" << result.ticks / wall_seconds << " ticks per second)" << endl;
+	cout << "spawned words: " << result.spawned_words << " (" << result.spawned_words / wall_seconds << " per second)" << endl;
+	cout << "deleted words: " << result.deleted_words << " (" << result.deleted_words / wall_seconds << " per second), words left: " << result.words_left << endl;
+	for (size_t i = 0; i < result.rounds.size(); i++)
+	{
+		cout << "round " << i + 1 << ": score " << result.rounds[i].score << ", typed words " << result.rounds[i].typed_words
+			<< ", missed words " << result.rounds[i].missed_words << endl;
+	}
+	cout << "keys pressed: " << result.keys_pressed << ", wrong keys: " << result.wrong_keys << endl;
+
+	if (!config.report_filename.empty())
+	{
+		result.wall_seconds = wall_seconds;
+		if (write_json_report(config.report_filename, config, result) < 0)
+		{
+			cout << "report file " << config.report_filename << " can't be written" << endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
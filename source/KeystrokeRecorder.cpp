@@ -0,0 +1,445 @@
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include "KeystrokeRecorder.h"
+#include "GameSettings.h"
+#include "ByteOrder.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+static const char file_magic[4] = { 'T', 'G', 'K', 'S' };	// first bytes of the keystroke file
+
+// Constructor. the keystroke file is created (or repaired) when the first chunk is appended (see init_file())
+// filename_in: input. path of the keystroke file
+// persistence_worker: input. appends the chunks in the background. must exist as long as this object
+KeystrokeRecorder::KeystrokeRecorder(const string& filename_in, PersistenceWorker& persistence_worker)
+{
+	filename = filename_in;
+	persistence = &persistence_worker;
+	read_only = false;
+	chunk_start_time = 0;
+	file_checked = false;
+}
+
+// Destructor. the keystrokes of an unfinished round are stored
+KeystrokeRecorder::~KeystrokeRecorder()
+{
+	end_round();
+}
+
+// prevent the recording of keystrokes. used when the game logic is run by a simulation
+// enable: input. true: don't record keystrokes anymore. false: record them again
+void KeystrokeRecorder::set_read_only(bool enable)
+{
+	read_only = enable;
+}
+
+// create the keystroke file, if it doesn't exist. If the file ends with an incomplete chunk (the program crashed during an append), the chunk is cut off,
+// because new chunks must be appended directly after the last complete chunk
+void KeystrokeRecorder::init_file()
+{
+	TRACE_ZONE("KeystrokeRecorder::init_file");
+	vector<char> header;
+	header.insert(header.end(), file_magic, file_magic + sizeof(file_magic));
+	append_uint_le(header, FORMAT_VERSION, 2);
+
+	ifstream fin(filename, ios::binary);
+	if (!fin.good())	// create a new file that only contains the header
+	{
+		PersistenceWorker::write_file_atomic(filename, header.data(), header.size());
+		return;
+	}
+	fin.close();
+
+	MappedFile file;
+	if (file.open(filename) < 0)
+		return;
+	if (file.size() < HEADER_LENGTH || memcmp(file.data(), file_magic, sizeof(file_magic)) != 0)	// broken header. start a new file
+	{
+		file.close();
+		PersistenceWorker::write_file_atomic(filename, header.data(), header.size());
+		return;
+	}
+
+	const char* file_end = file.data() + file.size();
+	const char* chunk = file.data() + HEADER_LENGTH;
+	const char* chunk_end;
+	while ((chunk_end = next_chunk(chunk, file_end)) != NULL)
+		chunk = chunk_end;
+
+	if (chunk != file_end)
+	{
+		vector<char> content(file.data(), chunk);
+		file.close();
+		PersistenceWorker::write_file_atomic(filename, content.data(), content.size());
+	}
+}
+
+// start recording the keystrokes of a new round. the interval of the first keystroke is measured from now
+void KeystrokeRecorder::start_round()
+{
+	end_round();
+	key_clock.restart();
+}
+
+// store one keystroke of the current round
+// expected: input. the character that should have been typed. 0 if the keystroke didn't match any word
+// typed: input. the typed character
+// word_length: input. length of the word that was typed. 0 if the keystroke didn't match any word
+void KeystrokeRecorder::record_keystroke(char expected, char typed, unsigned int word_length)
+{
+	if (read_only)
+		return;
+
+	if (expected_col.empty())
+		chunk_start_time = (sf::Int64)time(NULL);
+
+	sf::Int32 interval = key_clock.restart().asMilliseconds();
+	expected_col.push_back((sf::Uint8)expected);
+	typed_col.push_back((sf::Uint8)(typed ^ expected));
+	interval_col.push_back(interval > MAX_INTERVAL_MS ? (sf::Uint32)MAX_INTERVAL_MS : (sf::Uint32)interval);
+	word_length_col.push_back(word_length > 0xFF ? 0xFF : (sf::Uint8)word_length);
+
+	if (expected_col.size() >= CHUNK_KEYS)
+		write_chunk();
+}
+
+// store the keystrokes of the round that are not stored yet
+void KeystrokeRecorder::end_round()
+{
+	if (!expected_col.empty())
+		write_chunk();
+}
+
+// compress the keystrokes of the current chunk and queue the chunk to be appended to the file
+void KeystrokeRecorder::write_chunk()
+{
+	TRACE_ZONE("KeystrokeRecorder::write_chunk");
+	if (!file_checked)
+	{
+		file_checked = true;
+		init_file();
+	}
+
+	vector<char> chunk;
+	vector<char> column_data;
+
+	append_uint_le(chunk, expected_col.size(), 2);
+	append_uint_le(chunk, (sf::Uint64)chunk_start_time, 8);
+	for (unsigned int column = 0; column < NUM_COLUMNS; column++)
+	{
+		column_data.clear();
+		switch (column)
+		{
+		case COL_EXPECTED:
+			encode_bytes(expected_col, column_data);
+			break;
+		case COL_TYPED:
+			encode_bytes(typed_col, column_data);
+			break;
+		case COL_INTERVAL:
+			encode_varints(interval_col, column_data);
+			break;
+		case COL_WORD_LENGTH:
+			encode_bytes(word_length_col, column_data);
+			break;
+		}
+		// the encoding is the first byte of column_data. it is moved into the column header
+		append_uint_le(chunk, (sf::Uint8)column_data[0], 1);
+		append_uint_le(chunk, column_data.size() - 1, 4);
+		append_uint_le(chunk, SettingsFileParser::calculate_crc32(column_data.data() + 1, column_data.size() - 1), 4);
+		chunk.insert(chunk.end(), column_data.begin() + 1, column_data.end());
+	}
+
+	persistence->request_append(filename, chunk.data(), chunk.size());
+
+	expected_col.clear();
+	typed_col.clear();
+	interval_col.clear();
+	word_length_col.clear();
+}
+
+// map the keystroke file into memory. the queued chunks are written first
+// file: output. the mapped file
+// return: -1 if the file can't be read or has a wrong header. 0 if no error
+int KeystrokeRecorder::map_file(MappedFile& file)
+{
+	persistence->flush();
+	if (file.open(filename) < 0 || file.size() < HEADER_LENGTH || memcmp(file.data(), file_magic, sizeof(file_magic)) != 0)
+		return -1;
+	return 0;
+}
+
+// get the error rate of every expected character. only the columns of the expected and the typed characters are read
+// stats_out: output. one entry for every character that was expected at least once. sorted by error rate (descending)
+// return: number of entries in stats_out
+unsigned int KeystrokeRecorder::get_letter_stats(vector<letter_stat_t>& stats_out)
+{
+	TRACE_ZONE("KeystrokeRecorder::get_letter_stats");
+	stats_out.clear();
+	MappedFile file;
+	if (map_file(file) < 0)
+		return 0;
+
+	unsigned int num_keys[256] = { 0 };
+	unsigned int num_errors[256] = { 0 };
+	vector<sf::Uint8> expected;
+	vector<sf::Uint8> typed;
+	const char* file_end = file.data() + file.size();
+	const char* chunk_end;
+	for (const char* chunk = file.data() + HEADER_LENGTH; (chunk_end = next_chunk(chunk, file_end)) != NULL; chunk = chunk_end)
+	{
+		if (read_column(chunk, COL_EXPECTED, expected) < 0 || read_column(chunk, COL_TYPED, typed) < 0)
+			continue;
+		for (size_t i = 0; i < expected.size(); i++)
+		{
+			num_keys[expected[i]]++;
+			if (typed[i] != 0)
+				num_errors[expected[i]]++;
+		}
+	}
+
+	for (unsigned int letter = 1; letter < 256; letter++)	// 0: the keystroke didn't match any word
+	{
+		if (num_keys[letter] == 0)
+			continue;
+		letter_stat_t stat = { (char)letter, num_keys[letter], num_errors[letter] };
+		stats_out.push_back(stat);
+	}
+	sort(stats_out.begin(), stats_out.end(), [](const letter_stat_t& a, const letter_stat_t& b)
+		{ return (sf::Uint64)a.num_errors * b.num_keys > (sf::Uint64)b.num_errors * a.num_keys; });
+	return (unsigned int)stats_out.size();
+}
+
+// get the average time between two characters that were typed correctly one after another in the same word.
+// the columns of the expected and the typed characters and of the intervals are read
+// stats_out: output. one entry for every pair of characters. sorted by latency (descending)
+// return: number of entries in stats_out
+unsigned int KeystrokeRecorder::get_bigram_stats(vector<bigram_stat_t>& stats_out)
+{
+	TRACE_ZONE("KeystrokeRecorder::get_bigram_stats");
+	stats_out.clear();
+	MappedFile file;
+	if (map_file(file) < 0)
+		return 0;
+
+	vector<unsigned int> num_keys(256 * 256, 0);		// index: first character * 256 + second character
+	vector<sf::Uint64> latency_sum(256 * 256, 0);
+	vector<sf::Uint8> expected;
+	vector<sf::Uint8> typed;
+	vector<sf::Uint32> interval;
+	const char* file_end = file.data() + file.size();
+	const char* chunk_end;
+	for (const char* chunk = file.data() + HEADER_LENGTH; (chunk_end = next_chunk(chunk, file_end)) != NULL; chunk = chunk_end)
+	{
+		if (read_column(chunk, COL_EXPECTED, expected) < 0 || read_column(chunk, COL_TYPED, typed) < 0 || read_column(chunk, COL_INTERVAL, interval) < 0)
+			continue;
+		for (size_t i = 1; i < expected.size(); i++)
+		{
+			// both characters must be correct letters of a word. the space that finishes a word is not part of a bigram
+			if (typed[i - 1] != 0 || typed[i] != 0 || expected[i - 1] == 0 || expected[i] == 0 || expected[i - 1] == ' ' || expected[i] == ' ')
+				continue;
+			unsigned int bigram = expected[i - 1] * 256 + expected[i];
+			num_keys[bigram]++;
+			latency_sum[bigram] += interval[i];
+		}
+	}
+
+	for (unsigned int bigram = 0; bigram < num_keys.size(); bigram++)
+	{
+		if (num_keys[bigram] == 0)
+			continue;
+		bigram_stat_t stat = { (char)(bigram / 256), (char)(bigram % 256), num_keys[bigram], (float)latency_sum[bigram] / num_keys[bigram] };
+		stats_out.push_back(stat);
+	}
+	sort(stats_out.begin(), stats_out.end(), [](const bigram_stat_t& a, const bigram_stat_t& b) { return a.mean_latency_ms > b.mean_latency_ms; });
+	return (unsigned int)stats_out.size();
+}
+
+// get the typing speed of every chunk (usually one round). the columns of the expected and the typed characters and of the intervals are read
+// points_out: output. one entry for every chunk. in the order they were recorded
+// return: number of entries in points_out
+unsigned int KeystrokeRecorder::get_wpm_over_time(vector<wpm_point_t>& points_out)
+{
+	TRACE_ZONE("KeystrokeRecorder::get_wpm_over_time");
+	points_out.clear();
+	MappedFile file;
+	if (map_file(file) < 0)
+		return 0;
+
+	vector<sf::Uint8> expected;
+	vector<sf::Uint8> typed;
+	vector<sf::Uint32> interval;
+	const char* file_end = file.data() + file.size();
+	const char* chunk_end;
+	for (const char* chunk = file.data() + HEADER_LENGTH; (chunk_end = next_chunk(chunk, file_end)) != NULL; chunk = chunk_end)
+	{
+		if (read_column(chunk, COL_EXPECTED, expected) < 0 || read_column(chunk, COL_TYPED, typed) < 0 || read_column(chunk, COL_INTERVAL, interval) < 0)
+			continue;
+		unsigned int correct_keys = 0;
+		sf::Uint64 typing_time_ms = 0;
+		for (size_t i = 0; i < expected.size(); i++)
+		{
+			if (expected[i] != 0 && typed[i] == 0)
+				correct_keys++;
+			typing_time_ms += interval[i];
+		}
+		if (typing_time_ms == 0)
+			continue;
+		wpm_point_t point = { (sf::Int64)read_uint_le(chunk + 2, 8), (unsigned int)expected.size(), (float)correct_keys / 5 / ((float)typing_time_ms / 60000) };
+		points_out.push_back(point);
+	}
+	return (unsigned int)points_out.size();
+}
+
+// check that a chunk and all its column headers are inside the file. the data of the columns is not read
+// chunk: input. first byte of the chunk
+// file_end: input. first byte after the file
+// return: first byte of the next chunk. NULL if the chunk is incomplete or there are no more chunks
+const char* KeystrokeRecorder::next_chunk(const char* chunk, const char* file_end)
+{
+	if (file_end - chunk < CHUNK_HEADER_LENGTH)
+		return NULL;
+	const char* column = chunk + CHUNK_HEADER_LENGTH;
+	for (unsigned int i = 0; i < NUM_COLUMNS; i++)
+	{
+		if (file_end - column < COLUMN_HEADER_LENGTH)
+			return NULL;
+		sf::Uint64 length = read_uint_le(column + 1, 4);
+		if ((sf::Uint64)(file_end - column - COLUMN_HEADER_LENGTH) < length)
+			return NULL;
+		column += COLUMN_HEADER_LENGTH + length;
+	}
+	return column;
+}
+
+// returns the header of a column of a chunk. the chunk must be checked with next_chunk()
+const char* KeystrokeRecorder::find_column(const char* chunk, unsigned int column)
+{
+	const char* column_header = chunk + CHUNK_HEADER_LENGTH;
+	for (unsigned int i = 0; i < column; i++)
+		column_header += COLUMN_HEADER_LENGTH + read_uint_le(column_header + 1, 4);
+	return column_header;
+}
+
+// read and decode a column with one byte per keystroke
+// chunk: input. first byte of the chunk. the chunk must be checked with next_chunk()
+// column: input. column to read (see column_id)
+// values_out: output. one value per keystroke
+// return: -1 if the checksum is wrong or the column can't be decoded. 0 if no error
+int KeystrokeRecorder::read_column(const char* chunk, unsigned int column, vector<sf::Uint8>& values_out)
+{
+	const char* column_header = find_column(chunk, column);
+	unsigned int length = (unsigned int)read_uint_le(column_header + 1, 4);
+	const char* data = column_header + COLUMN_HEADER_LENGTH;
+	if (read_uint_le(column_header + 5, 4) != SettingsFileParser::calculate_crc32(data, length))
+		return -1;
+	return decode_bytes(data, length, (sf::Uint8)column_header[0], (unsigned int)read_uint_le(chunk, 2), values_out);
+}
+
+// read and decode a column with one variable length number per keystroke
+// chunk: input. first byte of the chunk. the chunk must be checked with next_chunk()
+// column: input. column to read (see column_id)
+// values_out: output. one value per keystroke
+// return: -1 if the checksum is wrong or the column can't be decoded. 0 if no error
+int KeystrokeRecorder::read_column(const char* chunk, unsigned int column, vector<sf::Uint32>& values_out)
+{
+	const char* column_header = find_column(chunk, column);
+	unsigned int length = (unsigned int)read_uint_le(column_header + 1, 4);
+	const char* data = column_header + COLUMN_HEADER_LENGTH;
+	if ((sf::Uint8)column_header[0] != ENC_VARINT || read_uint_le(column_header + 5, 4) != SettingsFileParser::calculate_crc32(data, length))
+		return -1;
+	return decode_varints(data, length, (unsigned int)read_uint_le(chunk, 2), values_out);
+}
+
+// decode a byte column
+// data: input. encoded data
+// length: input. length of the encoded data
+// encoding: input. ENC_RAW or ENC_RLE
+// num_keys: input. number of keystrokes of the chunk
+// values_out: output. one value per keystroke
+// return: -1 if the data doesn't contain num_keys values. 0 if no error
+int KeystrokeRecorder::decode_bytes(const char* data, unsigned int length, unsigned int encoding, unsigned int num_keys, vector<sf::Uint8>& values_out)
+{
+	values_out.clear();
+	if (encoding == ENC_RAW)
+	{
+		if (length != num_keys)
+			return -1;
+		values_out.assign((const sf::Uint8*)data, (const sf::Uint8*)data + length);
+		return 0;
+	}
+	if (encoding != ENC_RLE)
+		return -1;
+
+	const char* data_end = data + length;
+	while (data < data_end)
+	{
+		sf::Uint8 value = (sf::Uint8)*data;
+		sf::Uint32 run_length;
+		data = read_varint(data + 1, data_end, run_length);
+		if (data == NULL || values_out.size() + run_length > num_keys)
+			return -1;
+		values_out.insert(values_out.end(), run_length, value);
+	}
+	return values_out.size() == num_keys ? 0 : -1;
+}
+
+// decode a column of variable length numbers
+// data: input. encoded data
+// length: input. length of the encoded data
+// num_keys: input. number of keystrokes of the chunk
+// values_out: output. one value per keystroke
+// return: -1 if the data doesn't contain num_keys values. 0 if no error
+int KeystrokeRecorder::decode_varints(const char* data, unsigned int length, unsigned int num_keys, vector<sf::Uint32>& values_out)
+{
+	values_out.clear();
+	const char* data_end = data + length;
+	while (data < data_end && values_out.size() < num_keys)
+	{
+		sf::Uint32 value;
+		data = read_varint(data, data_end, value);
+		if (data == NULL)
+			return -1;
+		values_out.push_back(value);
+	}
+	return (data == data_end && values_out.size() == num_keys) ? 0 : -1;
+}
+
+// encode a byte column. run-length encoding is used if it is smaller than the raw bytes
+// values: input. one value per keystroke
+// buffer: output. the encoding (1 byte) followed by the encoded data
+void KeystrokeRecorder::encode_bytes(const vector<sf::Uint8>& values, vector<char>& buffer)
+{
+	buffer.clear();
+	buffer.push_back(ENC_RLE);
+	for (size_t i = 0; i < values.size(); )
+	{
+		size_t run_end = i + 1;
+		while (run_end < values.size() && values[run_end] == values[i])
+			run_end++;
+		buffer.push_back((char)values[i]);
+		append_varint((sf::Uint32)(run_end - i), buffer);
+		i = run_end;
+	}
+
+	if (buffer.size() - 1 >= values.size())		// the run-length encoding is not smaller
+	{
+		buffer.clear();
+		buffer.push_back(ENC_RAW);
+		buffer.insert(buffer.end(), values.begin(), values.end());
+	}
+}
+
+// encode a column of numbers as variable length numbers
+// values: input. one value per keystroke
+// buffer: output. the encoding (1 byte) followed by the encoded data
+void KeystrokeRecorder::encode_varints(const vector<sf::Uint32>& values, vector<char>& buffer)
+{
+	buffer.clear();
+	buffer.push_back(ENC_VARINT);
+	for (size_t i = 0; i < values.size(); i++)
+		append_varint(values[i], buffer);
+}
@@ -0,0 +1,117 @@
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "MappedFile.h"
+
+using namespace std;
+
+// Constructor. no file is mapped yet
+MappedFile::MappedFile()
+{
+	mapped_data = NULL;
+	mapped_size = 0;
+#ifdef _WIN32
+	file_handle = INVALID_HANDLE_VALUE;
+	mapping_handle = NULL;
+#endif
+}
+
+// Destructor. unmap the file
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+// map a file into memory. A file that is already mapped is unmapped first.
+// an empty file can be opened, but then data() returns NULL
+// file_name: input. path of the file
+// return: -1 if the file can't be opened or mapped. 0 if no error
+int MappedFile::open(const string& file_name)
+{
+	close();
+
+#ifdef _WIN32
+	file_handle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file_handle == INVALID_HANDLE_VALUE)
+		return -1;
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file_handle, &file_size))
+	{
+		close();
+		return -1;
+	}
+	mapped_size = (size_t)file_size.QuadPart;
+	if (mapped_size == 0)	// an empty file can't be mapped
+		return 0;
+	mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping_handle == NULL)
+	{
+		close();
+		return -1;
+	}
+	mapped_data = (const char*)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+#else
+	int fd = ::open(file_name.c_str(), O_RDONLY);
+	if (fd < 0)
+		return -1;
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) < 0)
+	{
+		::close(fd);
+		return -1;
+	}
+	mapped_size = (size_t)file_stat.st_size;
+	if (mapped_size == 0)	// an empty file can't be mapped
+	{
+		::close(fd);
+		return 0;
+	}
+	void* mapping = mmap(NULL, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);	// the mapping stays valid after the file is closed
+	mapped_data = (mapping == MAP_FAILED) ? NULL : (const char*)mapping;
+#endif
+
+	if (mapped_data == NULL)
+	{
+		close();
+		return -1;
+	}
+	return 0;
+}
+
+// unmap the file
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (mapped_data != NULL)
+		UnmapViewOfFile(mapped_data);
+	if (mapping_handle != NULL)
+		CloseHandle(mapping_handle);
+	if (file_handle != INVALID_HANDLE_VALUE)
+		CloseHandle(file_handle);
+	mapping_handle = NULL;
+	file_handle = INVALID_HANDLE_VALUE;
+#else
+	if (mapped_data != NULL)
+		munmap((void*)mapped_data, mapped_size);
+#endif
+	mapped_data = NULL;
+	mapped_size = 0;
+}
+
+// returns the first byte of the mapped file. NULL if no file or an empty file is mapped
+const char* MappedFile::data()
+{
+	return mapped_data;
+}
+
+// returns the size of the mapped file. in bytes
+size_t MappedFile::size()
+{
+	return mapped_size;
+}
@@ -1,202 +1,441 @@
-#include "OptionScreen.h"
-
-using namespace std;
-
-// Constructor. Sets up the content of the Option screen (consisting of Text and Buttons)
-OptionScreen::OptionScreen(GameSettings& game_settings) : back_btn("< save and back", game_settings.getFont(), 40)	// member initializer list: back_btn
-{
-	settings = &game_settings;	// save the Address of game_settings in a pointer
-	string optn_val;
-
-	options_text_descr[HI_SCORE_TXT].setString("Hi-Score");
-	options_text_val[HI_SCORE_TXT].setString(to_string(settings->getHiScore()));
-	options_text_descr[BOUNDARY_TXT].setString("Playfield Boundary");
-	settings->getBoundaryID(&optn_val);
-	options_text_val[BOUNDARY_TXT].setString(optn_val);
-	options_text_descr[FONT_TXT].setString("Font");
-	settings->getFontID(&optn_val);
-	options_text_val[FONT_TXT].setString(optn_val);
-	options_text_descr[NUM_WORDS_TEXT].setString("Number of Words");
-	options_text_val[NUM_WORDS_TEXT].setString(to_string(settings->getNumWordsSpawn()));
-
-	for (unsigned int i = 0; i < NUM_TEXTS; i++)
-	{
-		options_text_descr[i].setFont(settings->getFont());
-		options_text_descr[i].setCharacterSize(30);
-		options_text_descr[i].setStyle(sf::Text::Bold);
-		options_text_descr[i].setLetterSpacing(1.5);
-
-		options_text_val[i].setFont(settings->getFont());
-		options_text_val[i].setCharacterSize(30);
-		options_text_val[i].setStyle(sf::Text::Bold);
-		options_text_val[i].setLetterSpacing(1.5);
-	}
-
-	for (unsigned int i = 0; i < NUM_BUTTONS; i++)
-	{
-		options_btn_left[i].setFont(game_settings.getFont());
-		options_btn_left[i].setString("<");
-		options_btn_left[i].setCharacterSize(40);
-
-		options_btn_right[i].setFont(game_settings.getFont());
-		options_btn_right[i].setString(">");
-		options_btn_right[i].setCharacterSize(40);
-	}
-
-	update_positions();
-	back_btn.setPosition(sf::Vector2f(20.f, 20.f));
-}
-
-inline OptionScreen::~OptionScreen() {}	// virtual destructor
-
-// set the position of every object of the Option Screen
-void OptionScreen::update_positions()
-{
-	// the following variables define the layout of the Option Screen. in pixels
-	float margin_vert = 80;
-	float margin_hor = 30;
-	float text_right_margin_hor = margin_hor + 60;
-	float btn_right_margin_hor = margin_hor + 350;
-	float vert_pos_start = 150;
-	float vert_pos_cur = vert_pos_start;
-	float text_pos_diff = 0;
-
-	// set up the text
-	for (unsigned int i = 0; i < NUM_TEXTS; i++)
-	{
-		text_pos_diff = options_text_descr[i].getGlobalBounds().top - options_text_descr[i].getPosition().y;
-		options_text_descr[i].setPosition(settings->get_window_size().x / 2 - options_text_descr[i].getGlobalBounds().width - margin_hor,
-			vert_pos_cur - (text_pos_diff + options_text_descr[i].getGlobalBounds().height / 2));
-
-		text_pos_diff = options_text_val[i].getGlobalBounds().top - options_text_val[i].getPosition().y;
-		options_text_val[i].setPosition(settings->get_window_size().x / 2 + text_right_margin_hor, vert_pos_cur - (text_pos_diff + options_text_val[i].getGlobalBounds().height / 2));
-
-		vert_pos_cur += margin_vert;
-	}
-
-	// set up the Buttons
-	vert_pos_cur = vert_pos_start + margin_vert;	// no Buttons needed for the first Option (Hi-Score)
-	for (unsigned int i = 0; i < NUM_BUTTONS; i++)
-	{
-		options_btn_left[i].setPosition(sf::Vector2f(settings->get_window_size().x / 2 + margin_hor, vert_pos_cur - options_btn_left[i].getSize().y / 2));
-		options_btn_right[i].setPosition(sf::Vector2f(settings->get_window_size().x / 2 + btn_right_margin_hor, vert_pos_cur - options_btn_right[i].getSize().y / 2));
-
-		vert_pos_cur += margin_vert;
-	}
-}
-
-inline void OptionScreen::update() {}
-
-inline void OptionScreen::update_physics() {}
-
-// draw every button and text on the screen
-inline void OptionScreen::draw_on_window(sf::RenderWindow& window)
-{
-	back_btn.draw_on_window(window);
-	for (unsigned int i = 0; i < NUM_TEXTS; i++)
-	{
-		window.draw(options_text_descr[i]);
-		window.draw(options_text_val[i]);
-	}
-	for (unsigned int i = 0; i < NUM_BUTTONS; i++)
-	{
-		options_btn_left[i].draw_on_window(window);
-		options_btn_right[i].draw_on_window(window);
-	}
-}
-
-inline void OptionScreen::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt) {}
-
-// implement the functionality of every Button
-inline void OptionScreen::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt)
-{
-	// back Button: save every setting in the settings file and go back to the Start Screen
-	back_btn.mouse_clicked_processor(pressed_mouse_evnt);
-	if (back_btn.is_button_pressed())
-	{
-		settings->saveFontID();
-		settings->saveBoundaryID();
-		settings->saveNumWordsSpawn();
-		settings->game_state = GameSettings::START_SCREEN;
-		back_btn.button_pressed_reset();
-	}
-
-	options_btn_left[BOUNDARY_BTN].mouse_clicked_processor(pressed_mouse_evnt);
-	options_btn_right[BOUNDARY_BTN].mouse_clicked_processor(pressed_mouse_evnt);
-	if (options_btn_left[BOUNDARY_BTN].is_button_pressed() || options_btn_right[BOUNDARY_BTN].is_button_pressed())
-	{
-		int new_bound = settings->getBoundaryID();
-		if (options_btn_left[BOUNDARY_BTN].is_button_pressed())
-			new_bound--;
-		else if (options_btn_right[BOUNDARY_BTN].is_button_pressed())
-			new_bound++;
-
-		if (new_bound >= GameSettings::NUM_BOUNDS)
-			new_bound = 0;
-		else if (new_bound < 0)
-			new_bound = settings->NUM_BOUNDS - 1;
-
-		string bound_type;
-		settings->setBoundaryID(new_bound);
-		settings->getBoundaryID(&bound_type);
-		options_text_val[BOUNDARY_TXT].setString(bound_type);
-
-		options_btn_left[BOUNDARY_BTN].button_pressed_reset();
-		options_btn_right[BOUNDARY_BTN].button_pressed_reset();
-	}
-
-	options_btn_left[FONT_BTN].mouse_clicked_processor(pressed_mouse_evnt);
-	options_btn_right[FONT_BTN].mouse_clicked_processor(pressed_mouse_evnt);
-	if (options_btn_left[FONT_BTN].is_button_pressed() || options_btn_right[FONT_BTN].is_button_pressed())
-	{
-		int new_font = settings->getFontID();
-		if (options_btn_left[FONT_BTN].is_button_pressed())
-			new_font--;
-		else if (options_btn_right[FONT_BTN].is_button_pressed())
-			new_font++;
-
-		if (new_font >= GameSettings::NUM_FONTS)
-			new_font = 0;
-		else if (new_font < 0)
-			new_font = settings->NUM_FONTS - 1;
-
-		string font_type;
-		settings->setFont(new_font);
-		settings->getFontID(&font_type);
-		options_text_val[FONT_TXT].setString(font_type);
-		// update all Buttons to adjust to the new font
-		back_btn.update();
-		for (unsigned int i = 0; i < NUM_BUTTONS; i++)
-		{
-			options_btn_left[i].update();
-			options_btn_right[i].update();
-		}
-		// update the Position of all Elements on the Screen to adjust to the new font
-		update_positions();
-
-		options_btn_left[FONT_BTN].button_pressed_reset();
-		options_btn_right[FONT_BTN].button_pressed_reset();
-	}
-
-	options_btn_left[NUM_WORDS_BTN].mouse_clicked_processor(pressed_mouse_evnt);
-	options_btn_right[NUM_WORDS_BTN].mouse_clicked_processor(pressed_mouse_evnt);
-	if (options_btn_left[NUM_WORDS_BTN].is_button_pressed() || options_btn_right[NUM_WORDS_BTN].is_button_pressed())
-	{
-		int new_num_words_spawn = settings->getNumWordsSpawn();
-		if (options_btn_left[NUM_WORDS_BTN].is_button_pressed())
-			new_num_words_spawn--;
-		else if (options_btn_right[NUM_WORDS_BTN].is_button_pressed())
-			new_num_words_spawn++;
-
-		if (new_num_words_spawn > GameSettings::MAX_NUM_WORDS)
-			new_num_words_spawn = GameSettings::MIN_NUM_WORDS;
-		else if (new_num_words_spawn < GameSettings::MIN_NUM_WORDS)
-			new_num_words_spawn = GameSettings::MAX_NUM_WORDS;
-
-		settings->setNumWordsSpawn(new_num_words_spawn);
-		options_text_val[NUM_WORDS_TEXT].setString(to_string(new_num_words_spawn));
-
-		options_btn_left[NUM_WORDS_BTN].button_pressed_reset();
-		options_btn_right[NUM_WORDS_BTN].button_pressed_reset();
-	}
-}
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include "OptionScreen.h"
+
+using namespace std;
+
+// physics tick rates that can be selected. in ticks per second. must be inside the range of SettingsFileParser::physics_tick_rate_range
+static const unsigned int physics_tick_rates[] = { 25, 50, 100, 200, 500 };
+static const int num_physics_tick_rates = sizeof(physics_tick_rates) / sizeof(physics_tick_rates[0]);
+
+// frame pacing modes that can be selected (see FramePacer). the frame rate is only used by the FPS_CAP mode
+typedef struct frame_pacing_preset
+{
+	int mode;
+	unsigned int fps_cap;	// in frames per second
+} frame_pacing_preset_t;
+
+static const frame_pacing_preset_t frame_pacing_presets[] =
+{
+	{ FramePacer::VSYNC, FramePacer::DEFAULT_FPS_CAP },
+	{ FramePacer::FPS_CAP, 30 },
+	{ FramePacer::FPS_CAP, 60 },
+	{ FramePacer::FPS_CAP, 120 },
+	{ FramePacer::FPS_CAP, 144 },
+	{ FramePacer::FPS_CAP, 240 },
+	{ FramePacer::UNCAPPED, FramePacer::DEFAULT_FPS_CAP }
+};
+static const int num_frame_pacing_presets = sizeof(frame_pacing_presets) / sizeof(frame_pacing_presets[0]);
+
+// Constructor. Sets up the content of the Option screen (consisting of Text and Buttons)
+OptionScreen::OptionScreen(GameSettings& game_settings) : back_btn("< save and back", game_settings.getFont(), 40)	// member initializer list: back_btn
+{
+	settings = &game_settings;	// save the Address of game_settings in a pointer
+	screen_layer.create((unsigned int)settings->get_window_size().x, (unsigned int)settings->get_window_size().y);
+	string optn_val;
+
+	options_text_descr[HI_SCORE_TXT].setString("Hi-Score");
+	options_text_val[HI_SCORE_TXT].setString(to_string(settings->getHiScore()));
+	options_text_descr[BOUNDARY_TXT].setString("Playfield Boundary");
+	settings->getBoundaryID(&optn_val);
+	options_text_val[BOUNDARY_TXT].setString(optn_val);
+	options_text_descr[FONT_TXT].setString("Font");
+	settings->getFontID(&optn_val);
+	options_text_val[FONT_TXT].setString(optn_val);
+	options_text_descr[NUM_WORDS_TEXT].setString("Number of Words");
+	options_text_val[NUM_WORDS_TEXT].setString(to_string(settings->getNumWordsSpawn()));
+	options_text_descr[TICK_RATE_TXT].setString("Physics Tick Rate");
+	options_text_val[TICK_RATE_TXT].setString(to_string(settings->getPhysicsTickRate()) + " Hz");
+	options_text_descr[WORD_MODE_TXT].setString("Word Selection");
+	settings->getWordMode(&optn_val);
+	options_text_val[WORD_MODE_TXT].setString(optn_val);
+	options_text_descr[FRAME_PACING_TXT].setString("Frame Pacing");
+	settings->getFramePacing(&optn_val);
+	options_text_val[FRAME_PACING_TXT].setString(optn_val);
+
+	for (unsigned int i = 0; i < NUM_TEXTS; i++)
+	{
+		options_text_descr[i].setFont(settings->getFont());
+		options_text_descr[i].setCharacterSize(30);
+		options_text_descr[i].setStyle(sf::Text::Bold);
+		options_text_descr[i].setLetterSpacing(1.5);
+
+		options_text_val[i].setFont(settings->getFont());
+		options_text_val[i].setCharacterSize(30);
+		options_text_val[i].setStyle(sf::Text::Bold);
+		options_text_val[i].setLetterSpacing(1.5);
+	}
+
+	for (unsigned int i = 0; i < NUM_BUTTONS; i++)
+	{
+		options_btn_left[i].setFont(game_settings.getFont());
+		options_btn_left[i].setString("<");
+		options_btn_left[i].setCharacterSize(40);
+
+		options_btn_right[i].setFont(game_settings.getFont());
+		options_btn_right[i].setString(">");
+		options_btn_right[i].setCharacterSize(40);
+	}
+
+	// the warning is shown at the bottom left of the window, if a save fails
+	save_status_msg.setFont(settings->getFont());
+	save_status_msg.setCharacterSize(30);
+	save_status_msg.setStyle(sf::Text::Bold);
+	save_status_msg.setLetterSpacing(1.5);
+	save_status_msg.setFillColor(sf::Color::Red);
+
+	leaderboard_text.setFont(settings->getFont());
+	leaderboard_text.setCharacterSize(20);
+	leaderboard_text.setLetterSpacing(1.5);
+	update_leaderboard();
+
+	update_positions();
+	back_btn.setPosition(sf::Vector2f(20.f, 20.f));
+}
+
+inline OptionScreen::~OptionScreen() {}	// virtual destructor
+
+// set the position of every object of the Option Screen
+void OptionScreen::update_positions()
+{
+	// the following variables define the layout of the Option Screen. in pixels
+	float margin_vert = 62;
+	float margin_hor = 30;
+	float text_right_margin_hor = margin_hor + 60;
+	float btn_right_margin_hor = margin_hor + 350;
+	float vert_pos_start = 130;
+	float vert_pos_cur = vert_pos_start;
+	float text_pos_diff = 0;
+
+	// set up the text
+	for (unsigned int i = 0; i < NUM_TEXTS; i++)
+	{
+		text_pos_diff = options_text_descr[i].getGlobalBounds().top - options_text_descr[i].getPosition().y;
+		options_text_descr[i].setPosition(settings->get_window_size().x / 2 - options_text_descr[i].getGlobalBounds().width - margin_hor,
+			vert_pos_cur - (text_pos_diff + options_text_descr[i].getGlobalBounds().height / 2));
+
+		text_pos_diff = options_text_val[i].getGlobalBounds().top - options_text_val[i].getPosition().y;
+		options_text_val[i].setPosition(settings->get_window_size().x / 2 + text_right_margin_hor, vert_pos_cur - (text_pos_diff + options_text_val[i].getGlobalBounds().height / 2));
+
+		vert_pos_cur += margin_vert;
+	}
+
+	// set up the Buttons
+	vert_pos_cur = vert_pos_start + margin_vert;	// no Buttons needed for the first Option (Hi-Score)
+	for (unsigned int i = 0; i < NUM_BUTTONS; i++)
+	{
+		options_btn_left[i].setPosition(sf::Vector2f(settings->get_window_size().x / 2 + margin_hor, vert_pos_cur - options_btn_left[i].getSize().y / 2));
+		options_btn_right[i].setPosition(sf::Vector2f(settings->get_window_size().x / 2 + btn_right_margin_hor, vert_pos_cur - options_btn_right[i].getSize().y / 2));
+
+		vert_pos_cur += margin_vert;
+	}
+
+	save_status_msg.setPosition(20.f, settings->get_window_size().y - 60.f);
+	leaderboard_text.setPosition(settings->get_window_size().x / 2 - 300.f, vert_pos_cur);
+}
+
+// show the best rounds and the statistics of today and of the current settings.
+// the values are taken from the index of the score history, so the score log is not read
+void OptionScreen::update_leaderboard()
+{
+	enum leaderboard_size
+	{
+		NUM_TOP_ROUNDS = 5		// number of rounds that are shown
+	};
+
+	ScoreHistory& history = settings->get_score_history();
+	vector<round_record_t> top_rounds;
+	ostringstream leaderboard;
+	leaderboard << fixed << setprecision(0);
+
+	history.get_top_rounds(NUM_TOP_ROUNDS, top_rounds);
+	if (top_rounds.empty())
+		leaderboard << "Leaderboard: no rounds played yet\n";
+	else
+		leaderboard << "Leaderboard (" << history.get_num_rounds() << " rounds played)\n";
+	for (unsigned int i = 0; i < top_rounds.size(); i++)
+	{
+		unsigned int day = ScoreHistory::get_day(top_rounds[i].timestamp);
+		leaderboard << i + 1 << ".  " << top_rounds[i].score << "  " << top_rounds[i].wpm << " wpm  " << top_rounds[i].accuracy * 100 << "%  "
+			<< day % 100 << "." << day / 100 % 100 << "." << day / 10000 << "\n";
+	}
+
+	day_summary_t today;
+	if (history.get_day_summary(ScoreHistory::get_day((sf::Int64)time(NULL)), today))
+		leaderboard << "Today: " << today.num_rounds << " rounds, best " << today.best_score << ", average " << today.total_score / today.num_rounds << "\n";
+
+	setting_summary_t current_settings;
+	if (history.get_setting_summary((char)settings->getBoundaryID(), settings->getNumWordsSpawn(), current_settings))
+		leaderboard << "Current settings: best " << current_settings.best_score << ", " << current_settings.best_wpm << " wpm";
+
+	leaderboard_text.setString(leaderboard.str());
+}
+
+// show a warning if the settings couldn't be saved
+inline void OptionScreen::update()
+{
+	sf::String new_status_msg = get_save_status();
+	if (save_status_msg.getString() != new_status_msg)
+	{
+		save_status_msg.setString(new_status_msg);
+		screen_layer.invalidate();
+	}
+}
+
+inline void OptionScreen::update_physics() {}
+
+// draw every button and text on the screen. the screen is cached in a RenderLayer and only drawn again when something changed
+inline void OptionScreen::draw_on_window(DrawCommandBuffer& target)
+{
+	bool hover_changed = back_btn.update_hover(target);
+	for (unsigned int i = 0; i < NUM_BUTTONS; i++)
+	{
+		hover_changed |= options_btn_left[i].update_hover(target);
+		hover_changed |= options_btn_right[i].update_hover(target);
+	}
+	if (hover_changed)
+		screen_layer.invalidate();
+
+	if (screen_layer.needs_redraw())
+	{
+		DrawCommandBuffer& layer_target = screen_layer.begin(target);
+		layer_target.draw_entity(back_btn);
+		layer_target.draw(save_status_msg);
+		layer_target.draw(leaderboard_text);
+		for (unsigned int i = 0; i < NUM_TEXTS; i++)
+		{
+			layer_target.draw(options_text_descr[i]);
+			layer_target.draw(options_text_val[i]);
+		}
+		for (unsigned int i = 0; i < NUM_BUTTONS; i++)
+		{
+			layer_target.draw_entity(options_btn_left[i]);
+			layer_target.draw_entity(options_btn_right[i]);
+		}
+		screen_layer.end();
+	}
+	screen_layer.draw_on_window(target);
+}
+
+inline void OptionScreen::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt) {}
+
+// implement the functionality of every Button
+inline void OptionScreen::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt)
+{
+	screen_layer.invalidate();	// a click can change the text of an option, the leaderboard or the font
+
+
+	// back Button: save every setting in the settings file and go back to the Start Screen.
+	// the settings are already saved when they are changed, so these saves are coalesced with the last change (see PersistenceWorker)
+	back_btn.mouse_clicked_processor(pressed_mouse_evnt);
+	if (back_btn.is_button_pressed())
+	{
+		settings->saveFontID();
+		settings->saveBoundaryID();
+		settings->saveNumWordsSpawn();
+		settings->savePhysicsTickRate();
+		settings->saveWordMode();
+		settings->saveFramePacing();
+		settings->game_state = GameSettings::START_SCREEN;
+		back_btn.button_pressed_reset();
+	}
+
+	options_btn_left[BOUNDARY_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	options_btn_right[BOUNDARY_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	if (options_btn_left[BOUNDARY_BTN].is_button_pressed() || options_btn_right[BOUNDARY_BTN].is_button_pressed())
+	{
+		int new_bound = settings->getBoundaryID();
+		if (options_btn_left[BOUNDARY_BTN].is_button_pressed())
+			new_bound--;
+		else if (options_btn_right[BOUNDARY_BTN].is_button_pressed())
+			new_bound++;
+
+		if (new_bound >= GameSettings::NUM_BOUNDS)
+			new_bound = 0;
+		else if (new_bound < 0)
+			new_bound = settings->NUM_BOUNDS - 1;
+
+		string bound_type;
+		settings->setBoundaryID(new_bound);
+		settings->saveBoundaryID();		// the save is written in the background. clicking many times results in only one write
+		settings->getBoundaryID(&bound_type);
+		options_text_val[BOUNDARY_TXT].setString(bound_type);
+		update_leaderboard();
+
+		options_btn_left[BOUNDARY_BTN].button_pressed_reset();
+		options_btn_right[BOUNDARY_BTN].button_pressed_reset();
+	}
+
+	options_btn_left[FONT_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	options_btn_right[FONT_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	if (options_btn_left[FONT_BTN].is_button_pressed() || options_btn_right[FONT_BTN].is_button_pressed())
+	{
+		int new_font = settings->getFontID();
+		if (options_btn_left[FONT_BTN].is_button_pressed())
+			new_font--;
+		else if (options_btn_right[FONT_BTN].is_button_pressed())
+			new_font++;
+
+		if (new_font >= GameSettings::NUM_FONTS)
+			new_font = 0;
+		else if (new_font < 0)
+			new_font = settings->NUM_FONTS - 1;
+
+		string font_type;
+		settings->setFont(new_font);
+		settings->saveFontID();
+		settings->getFontID(&font_type);
+		options_text_val[FONT_TXT].setString(font_type);
+		// the fonts are preloaded, so every text only gets a pointer to the new font. update all Buttons to adjust to the new font
+		const sf::Font& font = settings->getFont();
+		for (unsigned int i = 0; i < NUM_TEXTS; i++)
+		{
+			options_text_descr[i].setFont(font);
+			options_text_val[i].setFont(font);
+		}
+		save_status_msg.setFont(font);
+		leaderboard_text.setFont(font);
+		back_btn.setFont(font);
+		back_btn.update();
+		for (unsigned int i = 0; i < NUM_BUTTONS; i++)
+		{
+			options_btn_left[i].setFont(font);
+			options_btn_right[i].setFont(font);
+			options_btn_left[i].update();
+			options_btn_right[i].update();
+		}
+		// update the Position of all Elements on the Screen to adjust to the new font
+		update_positions();
+
+		options_btn_left[FONT_BTN].button_pressed_reset();
+		options_btn_right[FONT_BTN].button_pressed_reset();
+	}
+
+	options_btn_left[NUM_WORDS_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	options_btn_right[NUM_WORDS_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	if (options_btn_left[NUM_WORDS_BTN].is_button_pressed() || options_btn_right[NUM_WORDS_BTN].is_button_pressed())
+	{
+		int new_num_words_spawn = settings->getNumWordsSpawn();
+		if (options_btn_left[NUM_WORDS_BTN].is_button_pressed())
+			new_num_words_spawn--;
+		else if (options_btn_right[NUM_WORDS_BTN].is_button_pressed())
+			new_num_words_spawn++;
+
+		if (new_num_words_spawn > GameSettings::MAX_NUM_WORDS)
+			new_num_words_spawn = GameSettings::MIN_NUM_WORDS;
+		else if (new_num_words_spawn < GameSettings::MIN_NUM_WORDS)
+			new_num_words_spawn = GameSettings::MAX_NUM_WORDS;
+
+		settings->setNumWordsSpawn(new_num_words_spawn);
+		settings->saveNumWordsSpawn();
+		options_text_val[NUM_WORDS_TEXT].setString(to_string(new_num_words_spawn));
+		update_leaderboard();
+
+		options_btn_left[NUM_WORDS_BTN].button_pressed_reset();
+		options_btn_right[NUM_WORDS_BTN].button_pressed_reset();
+	}
+
+	options_btn_left[TICK_RATE_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	options_btn_right[TICK_RATE_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	if (options_btn_left[TICK_RATE_BTN].is_button_pressed() || options_btn_right[TICK_RATE_BTN].is_button_pressed())
+	{
+		// find the current tick rate in the selectable tick rates. a rate that is not in the list counts as the lowest rate
+		int rate_index = 0;
+		for (int i = 0; i < num_physics_tick_rates; i++)
+		{
+			if (physics_tick_rates[i] == settings->getPhysicsTickRate())
+				rate_index = i;
+		}
+		if (options_btn_left[TICK_RATE_BTN].is_button_pressed())
+			rate_index--;
+		else if (options_btn_right[TICK_RATE_BTN].is_button_pressed())
+			rate_index++;
+
+		if (rate_index >= num_physics_tick_rates)
+			rate_index = 0;
+		else if (rate_index < 0)
+			rate_index = num_physics_tick_rates - 1;
+
+		settings->setPhysicsTickRate(physics_tick_rates[rate_index]);
+		settings->savePhysicsTickRate();
+		options_text_val[TICK_RATE_TXT].setString(to_string(physics_tick_rates[rate_index]) + " Hz");
+
+		options_btn_left[TICK_RATE_BTN].button_pressed_reset();
+		options_btn_right[TICK_RATE_BTN].button_pressed_reset();
+	}
+
+	options_btn_left[WORD_MODE_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	options_btn_right[WORD_MODE_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	if (options_btn_left[WORD_MODE_BTN].is_button_pressed() || options_btn_right[WORD_MODE_BTN].is_button_pressed())
+	{
+		int new_mode = settings->getWordMode();
+		if (options_btn_left[WORD_MODE_BTN].is_button_pressed())
+			new_mode--;
+		else if (options_btn_right[WORD_MODE_BTN].is_button_pressed())
+			new_mode++;
+
+		if (new_mode >= GameSettings::NUM_WORD_MODES)
+			new_mode = 0;
+		else if (new_mode < 0)
+			new_mode = GameSettings::NUM_WORD_MODES - 1;
+
+		string mode_descr;
+		settings->setWordMode(new_mode);
+		settings->saveWordMode();
+		settings->getWordMode(&mode_descr);
+		options_text_val[WORD_MODE_TXT].setString(mode_descr);
+
+		options_btn_left[WORD_MODE_BTN].button_pressed_reset();
+		options_btn_right[WORD_MODE_BTN].button_pressed_reset();
+	}
+
+	options_btn_left[FRAME_PACING_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	options_btn_right[FRAME_PACING_BTN].mouse_clicked_processor(pressed_mouse_evnt);
+	if (options_btn_left[FRAME_PACING_BTN].is_button_pressed() || options_btn_right[FRAME_PACING_BTN].is_button_pressed())
+	{
+		// find the current mode in the selectable presets. a frame rate that is not in the list counts as the first preset
+		int preset_index = 0;
+		for (int i = 0; i < num_frame_pacing_presets; i++)
+		{
+			if (frame_pacing_presets[i].mode == settings->getFramePacing() && (frame_pacing_presets[i].mode != FramePacer::FPS_CAP || frame_pacing_presets[i].fps_cap == settings->getFpsCap()))
+				preset_index = i;
+		}
+		if (options_btn_left[FRAME_PACING_BTN].is_button_pressed())
+			preset_index--;
+		else if (options_btn_right[FRAME_PACING_BTN].is_button_pressed())
+			preset_index++;
+
+		if (preset_index >= num_frame_pacing_presets)
+			preset_index = 0;
+		else if (preset_index < 0)
+			preset_index = num_frame_pacing_presets - 1;
+
+		string pacing_descr;
+		settings->setFramePacing(frame_pacing_presets[preset_index].mode, frame_pacing_presets[preset_index].fps_cap);	// applied by the main loop
+		settings->saveFramePacing();
+		settings->getFramePacing(&pacing_descr);
+		options_text_val[FRAME_PACING_TXT].setString(pacing_descr);
+
+		options_btn_left[FRAME_PACING_BTN].button_pressed_reset();
+		options_btn_right[FRAME_PACING_BTN].button_pressed_reset();
+	}
+}
+
+// the screen only changes with an input event, except the save warning, which is set by the background save (see PersistenceWorker)
+inline bool OptionScreen::is_animating()
+{
+	return save_status_msg.getString() != get_save_status();
+}
+
+// name of the Entity type for the CountingRenderBackend
+inline const char* OptionScreen::get_entity_name()
+{
+	return "OptionScreen";
+}
+
+// returns the save warning that shall be shown. empty if the last save was successful
+sf::String OptionScreen::get_save_status()
+{
+	return settings->has_save_failed() ? "Settings can't be saved!" : "";
+}
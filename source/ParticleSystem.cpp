@@ -0,0 +1,220 @@
+#include <cmath>
+#include "ParticleSystem.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// look of the effects. the colors are not taken from the static sf::Color constants, because the order of the static initialization between libraries is undefined
+// particles_per_glyph, min_speed, max_speed, drift, gravity, min_lifetime, max_lifetime, min_size, max_size, color
+const ParticleSystem::effect_params_t ParticleSystem::shatter_params = { 10, 60.f, 240.f, 0.5f, 420.f, 0.45f, 0.9f, 2.f, 4.f, sf::Color(255, 0, 0, 255) };
+const ParticleSystem::effect_params_t ParticleSystem::fade_params = { 8, 5.f, 30.f, 0.3f, -25.f, 0.9f, 1.6f, 2.f, 3.f, sf::Color(160, 160, 160, 200) };
+
+// Constructor. allocates the memory of all particles
+// capacity: input. maximum number of live particles
+ParticleSystem::ParticleSystem(unsigned int capacity)
+	// member initializer list. allocate the arrays once
+	: pos_x(capacity), pos_y(capacity), vel_x(capacity), vel_y(capacity), gravity(capacity), life(capacity), inv_lifetime(capacity), size(capacity), color(capacity),
+	vertices(sf::Quads, (size_t)capacity * 4)
+{
+	this->capacity = capacity;
+	num_particles = 0;
+	dropped_particles = 0;
+	random_state = 0x9E3779B9;	// any value except 0
+}
+
+inline ParticleSystem::~ParticleSystem() {}	// virtual destructor
+
+// spawn a burst of shards from every glyph of a typed word. the shards fly away from the center of the word and fall down
+// text: input. the typed word
+// velocity: input. velocity of the word. in pixels per second
+void ParticleSystem::spawn_shatter(const sf::Text& text, const sf::Vector2f& velocity)
+{
+	spawn_effect(text, velocity, shatter_params);
+}
+
+// spawn a slowly rising cloud from every glyph of a missed word
+// text: input. the missed word
+// velocity: input. velocity of the word. in pixels per second
+void ParticleSystem::spawn_fade(const sf::Text& text, const sf::Vector2f& velocity)
+{
+	spawn_effect(text, velocity, fade_params);
+}
+
+// move all particles and remove the expired particles
+// dt: input. time step. in seconds
+void ParticleSystem::step(float dt)
+{
+	TRACE_ZONE("ParticleSystem::step");
+	float* px = pos_x.data();
+	float* py = pos_y.data();
+	const float* vx = vel_x.data();
+	float* vy = vel_y.data();
+	const float* g = gravity.data();
+	float* l = life.data();
+
+	// the loop has no branches and every array is read contiguously, so the compiler can vectorize it
+	for (unsigned int i = 0; i < num_particles; i++)
+	{
+		vy[i] += g[i] * dt;
+		px[i] += vx[i] * dt;
+		py[i] += vy[i] * dt;
+		l[i] -= dt;
+	}
+
+	for (unsigned int i = 0; i < num_particles; )
+	{
+		if (l[i] <= 0)
+			remove_particle(i);		// the last particle is moved to i, so i is checked again
+		else
+			i++;
+	}
+}
+
+// remove all particles
+void ParticleSystem::clear()
+{
+	num_particles = 0;
+}
+
+// returns the number of live particles
+unsigned int ParticleSystem::get_num_particles()
+{
+	return num_particles;
+}
+
+// returns the maximum number of live particles
+unsigned int ParticleSystem::get_capacity()
+{
+	return capacity;
+}
+
+// returns the number of particles that were not spawned, because the pool was full
+unsigned long long ParticleSystem::get_dropped_particles()
+{
+	return dropped_particles;
+}
+
+// the particles are only changed by the physics
+inline void ParticleSystem::update() {}
+
+// move the particles by the time since the last physics tick
+inline void ParticleSystem::update_physics()
+{
+	step(physics_clock.restart().asSeconds());
+}
+
+// draw all particles as quads with a single draw call. the particles fade out over their lifetime
+inline void ParticleSystem::draw_on_window(DrawCommandBuffer& target)
+{
+	if (num_particles == 0)
+		return;
+
+	TRACE_ZONE("ParticleSystem::draw_on_window");
+	for (unsigned int i = 0; i < num_particles; i++)
+	{
+		float half_size = size[i] / 2;
+		float remaining = life[i] * inv_lifetime[i];	// 1 at the spawn, 0 at the end of the lifetime
+		sf::Color vertex_color = color[i];
+		vertex_color.a = (sf::Uint8)(vertex_color.a * (remaining > 0 ? remaining : 0));
+
+		sf::Vertex* quad = &vertices[(size_t)i * 4];
+		quad[0] = sf::Vertex(sf::Vector2f(pos_x[i] - half_size, pos_y[i] - half_size), vertex_color);
+		quad[1] = sf::Vertex(sf::Vector2f(pos_x[i] + half_size, pos_y[i] - half_size), vertex_color);
+		quad[2] = sf::Vertex(sf::Vector2f(pos_x[i] + half_size, pos_y[i] + half_size), vertex_color);
+		quad[3] = sf::Vertex(sf::Vector2f(pos_x[i] - half_size, pos_y[i] + half_size), vertex_color);
+	}
+	target.draw(&vertices[0], (size_t)num_particles * 4, sf::Quads);
+}
+
+// particles don't react to keys
+inline void ParticleSystem::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt) {}
+
+// particles don't react to the mouse
+inline void ParticleSystem::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt) {}
+
+// the particles move as long as one is alive
+inline bool ParticleSystem::is_animating()
+{
+	return num_particles > 0;
+}
+
+// name of the Entity type for the CountingRenderBackend
+inline const char* ParticleSystem::get_entity_name()
+{
+	return "ParticleSystem";
+}
+
+// spawn the particles of an effect at random positions inside the glyph bounds of a text. whitespace has no glyph bounds and gets no particles
+// text: input. the text that the particles are made of
+// velocity: input. velocity of the text. in pixels per second
+// params: input. look of the effect
+void ParticleSystem::spawn_effect(const sf::Text& text, const sf::Vector2f& velocity, const effect_params_t& params)
+{
+	const sf::Font* font = text.getFont();
+	if (font == NULL)
+		return;
+
+	const sf::String& text_string = text.getString();
+	sf::FloatRect text_bounds = text.getGlobalBounds();
+	sf::Vector2f center(text_bounds.left + text_bounds.width / 2, text_bounds.top + text_bounds.height / 2);
+	bool bold = (text.getStyle() & sf::Text::Bold) != 0;
+
+	for (size_t i = 0; i < text_string.getSize(); i++)
+	{
+		// the glyph bounds are relative to the baseline, which is one character size below the position of the character
+		const sf::Glyph& glyph = font->getGlyph(text_string[i], text.getCharacterSize(), bold);
+		sf::Vector2f origin = text.findCharacterPos(i) + sf::Vector2f(glyph.bounds.left, glyph.bounds.top + text.getCharacterSize());
+		if (glyph.bounds.width <= 0 || glyph.bounds.height <= 0)
+			continue;
+
+		for (unsigned int j = 0; j < params.particles_per_glyph; j++)
+		{
+			if (num_particles >= capacity)
+			{
+				dropped_particles++;
+				continue;
+			}
+
+			unsigned int p = num_particles++;
+			pos_x[p] = origin.x + random_range(0, glyph.bounds.width);
+			pos_y[p] = origin.y + random_range(0, glyph.bounds.height);
+
+			// away from the center of the word with a random spread of about +-35 degrees
+			float angle = atan2(pos_y[p] - center.y, pos_x[p] - center.x) + random_range(-0.6f, 0.6f);
+			float speed = random_range(params.min_speed, params.max_speed);
+			vel_x[p] = cos(angle) * speed + velocity.x * params.drift;
+			vel_y[p] = sin(angle) * speed + velocity.y * params.drift;
+
+			gravity[p] = params.gravity;
+			life[p] = random_range(params.min_lifetime, params.max_lifetime);
+			inv_lifetime[p] = 1 / life[p];
+			size[p] = random_range(params.min_size, params.max_size);
+			color[p] = params.color;
+		}
+	}
+}
+
+// returns a random number between min and max. xorshift generator, see random_state
+float ParticleSystem::random_range(float min, float max)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return min + (max - min) * (float)(random_state >> 8) / 16777216.f;	// the upper 24 bits fit exactly into a float
+}
+
+// remove a particle by moving the last live particle to its place
+// index: input. index of the particle to remove
+void ParticleSystem::remove_particle(unsigned int index)
+{
+	unsigned int last = --num_particles;
+	pos_x[index] = pos_x[last];
+	pos_y[index] = pos_y[last];
+	vel_x[index] = vel_x[last];
+	vel_y[index] = vel_y[last];
+	gravity[index] = gravity[last];
+	life[index] = life[last];
+	inv_lifetime[index] = inv_lifetime[last];
+	size[index] = size[last];
+	color[index] = color[last];
+}
@@ -0,0 +1,217 @@
+#include <chrono>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "PersistenceWorker.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor. starts the worker thread
+PersistenceWorker::PersistenceWorker() : busy(false), flush_requested(false), stop(false), write_failed(false),
+	worker_thread(&PersistenceWorker::worker_task, this)	// member initializer list. the thread is started last, after all other members are initialized
+{
+}
+
+// Destructor. write all queued requests and terminate the worker thread
+PersistenceWorker::~PersistenceWorker()
+{
+	{
+		lock_guard<mutex> lock(queue_mutex);
+		stop = true;
+	}
+	queue_cv.notify_one();
+	worker_thread.join();
+}
+
+// queue the new content of a file to be written by the worker thread. A queued request for the same file is replaced.
+// file_name: input. path of the file to replace
+// data: input. new content of the file. the data is copied
+// size: input. number of bytes
+void PersistenceWorker::request_write(const string& file_name, const char* data, size_t size)
+{
+	{
+		lock_guard<mutex> lock(queue_mutex);
+		list<write_request_t>::iterator queue_it = queue.begin();
+		while (queue_it != queue.end() && (queue_it->file_name != file_name || queue_it->append))
+			queue_it++;
+		if (queue_it == queue.end())	// no request for this file queued yet
+			queue_it = queue.insert(queue.end(), write_request_t());
+		queue_it->file_name = file_name;
+		queue_it->append = false;
+		queue_it->data.assign(data, data + size);
+	}
+	queue_cv.notify_one();
+}
+
+// queue data to be appended to a file by the worker thread. The data is joined with a queued append to the same file.
+// file_name: input. path of the file. it is created if it doesn't exist
+// data: input. data to append. the data is copied
+// size: input. number of bytes
+void PersistenceWorker::request_append(const string& file_name, const char* data, size_t size)
+{
+	{
+		lock_guard<mutex> lock(queue_mutex);
+		list<write_request_t>::iterator queue_it = queue.begin();
+		while (queue_it != queue.end() && (queue_it->file_name != file_name || !queue_it->append))
+			queue_it++;
+		if (queue_it == queue.end())	// no append for this file queued yet
+		{
+			queue_it = queue.insert(queue.end(), write_request_t());
+			queue_it->file_name = file_name;
+			queue_it->append = true;
+		}
+		queue_it->data.insert(queue_it->data.end(), data, data + size);
+	}
+	queue_cv.notify_one();
+}
+
+// write all queued requests immediately and wait until they are written
+void PersistenceWorker::flush()
+{
+	unique_lock<mutex> lock(queue_mutex);
+	flush_requested = true;
+	queue_cv.notify_one();
+	idle_cv.wait(lock, [this] { return queue.empty() && !busy; });
+}
+
+// returns true if the last write failed. The game can show a warning then, because the settings or the Hi-Score are not saved
+bool PersistenceWorker::has_write_failed()
+{
+	return write_failed;
+}
+
+// replace the content of a file, so that the file has either the old or the new content, also if the program crashes or the power fails.
+// The content is written with one write to a temporary file next to the file, which is flushed to the disk and then renamed to the file.
+// file_name: input. path of the file to replace
+// data: input. new content of the file
+// size: input. number of bytes
+// return: -1 if the file can't be written. 0 if no error
+int PersistenceWorker::write_file_atomic(const string& file_name, const char* data, size_t size)
+{
+	TRACE_ZONE("write_file_atomic");
+	string tmp_filename = file_name + ".tmp";
+
+#ifdef _WIN32
+	int fd = _open(tmp_filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+	if (fd < 0)
+		return -1;
+	bool ok = (_write(fd, data, (unsigned int)size) == (int)size);
+	ok = (_commit(fd) == 0) && ok;	// flush the file to the disk
+	ok = (_close(fd) == 0) && ok;
+	// MoveFileEx can replace an existing file (rename() can't on Windows). MOVEFILE_WRITE_THROUGH returns after the move is on the disk
+	if (ok)
+		ok = MoveFileExA(tmp_filename.c_str(), file_name.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	int fd = open(tmp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return -1;
+	bool ok = (write(fd, data, size) == (ssize_t)size);
+	ok = (fsync(fd) == 0) && ok;	// flush the file to the disk
+	ok = (close(fd) == 0) && ok;
+	if (ok)
+		ok = rename(tmp_filename.c_str(), file_name.c_str()) == 0;
+
+	// flush the directory entry of the renamed file to the disk
+	if (ok)
+	{
+		size_t separator_pos = file_name.find_last_of('/');
+		string dir_name = (separator_pos == string::npos) ? "." : file_name.substr(0, separator_pos + 1);
+		int dir_fd = open(dir_name.c_str(), O_RDONLY);
+		if (dir_fd >= 0)
+		{
+			fsync(dir_fd);
+			close(dir_fd);
+		}
+	}
+#endif
+
+	if (!ok)
+		remove(tmp_filename.c_str());
+	return ok ? 0 : -1;
+}
+
+// append data to a file with one write and flush the file to the disk.
+// if the program crashes during the append, only the end of the appended data can be missing. The reader of the file must detect an incomplete end.
+// file_name: input. path of the file. it is created if it doesn't exist
+// data: input. data to append
+// size: input. number of bytes
+// return: -1 if the file can't be written. 0 if no error
+int PersistenceWorker::append_file(const string& file_name, const char* data, size_t size)
+{
+	TRACE_ZONE("append_file");
+
+#ifdef _WIN32
+	int fd = _open(file_name.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+	if (fd < 0)
+		return -1;
+	bool ok = (_write(fd, data, (unsigned int)size) == (int)size);
+	ok = (_commit(fd) == 0) && ok;	// flush the file to the disk
+	ok = (_close(fd) == 0) && ok;
+#else
+	int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if (fd < 0)
+		return -1;
+	bool ok = (write(fd, data, size) == (ssize_t)size);
+	ok = (fsync(fd) == 0) && ok;	// flush the file to the disk
+	ok = (close(fd) == 0) && ok;
+#endif
+
+	return ok ? 0 : -1;
+}
+
+// runs in the worker thread. waits for requests and writes them
+void PersistenceWorker::worker_task()
+{
+	TRACE_THREAD_NAME("persistence");
+	unique_lock<mutex> lock(queue_mutex);
+
+	while (true)
+	{
+		queue_cv.wait(lock, [this] { return stop || flush_requested || !queue.empty(); });
+		if (queue.empty())
+		{
+			if (stop)
+				break;
+			flush_requested = false;	// flush() was called, but there is nothing to write
+			idle_cv.notify_all();
+			continue;
+		}
+
+		// give rapid repeated changes time to arrive, so they are written with one write
+		queue_cv.wait_for(lock, chrono::milliseconds(COALESCE_DELAY_MS), [this] { return stop || flush_requested; });
+
+		list<write_request_t> requests;
+		requests.swap(queue);
+		busy = true;
+		lock.unlock();		// the disk is accessed without holding the lock, so new requests can be queued in the meantime
+
+		bool ok = true;
+		for (list<write_request_t>::iterator request_it = requests.begin(); request_it != requests.end(); request_it++)
+		{
+			int ret;
+			if (request_it->append)
+				ret = append_file(request_it->file_name, request_it->data.data(), request_it->data.size());
+			else
+				ret = write_file_atomic(request_it->file_name, request_it->data.data(), request_it->data.size());
+			if (ret < 0)
+				ok = false;
+		}
+		write_failed = !ok;
+
+		lock.lock();
+		busy = false;
+		if (queue.empty())
+		{
+			flush_requested = false;
+			idle_cv.notify_all();
+		}
+	}
+}
@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include "RenderBackend.h"
+#include "RenderLayer.h"
+
+using namespace std;
+
+// Constructor
+// render_target: input. the target that the commands are drawn on. must exist as long as the backend
+TargetRenderBackend::TargetRenderBackend(sf::RenderTarget& render_target)
+{
+	target = &render_target;
+	current_target = &render_target;
+}
+
+TargetRenderBackend::~TargetRenderBackend() {}	// virtual destructor
+
+// clear the current target
+void TargetRenderBackend::clear(const sf::Color& color)
+{
+	current_target->clear(color);
+}
+
+// draw a text on the current target
+void TargetRenderBackend::draw(const sf::Text& text, const sf::RenderStates& states)
+{
+	current_target->draw(text, states);
+}
+
+// draw a shape on the current target
+void TargetRenderBackend::draw(const sf::Shape& shape, const sf::RenderStates& states)
+{
+	current_target->draw(shape, states);
+}
+
+// draw a sprite on the current target
+void TargetRenderBackend::draw(const sf::Sprite& sprite, const sf::RenderStates& states)
+{
+	current_target->draw(sprite, states);
+}
+
+// draw vertices on the current target
+void TargetRenderBackend::draw(const sf::Vertex* vertices, size_t num_vertices, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+	current_target->draw(vertices, num_vertices, type, states);
+}
+
+// the following draws go into the render texture of the layer
+void TargetRenderBackend::begin_layer(RenderLayer& layer)
+{
+	current_target = &layer.replay_begin(*target);
+}
+
+// the following draws go into the target of the frame again
+void TargetRenderBackend::end_layer(RenderLayer& layer)
+{
+	layer.replay_end();
+	current_target = target;
+}
+
+// draw the cached content of the layer on the current target
+void TargetRenderBackend::draw_layer(RenderLayer& layer)
+{
+	layer.replay_draw(*current_target);
+}
+
+
+// Constructor
+// render_window: input. the window that the commands are drawn on. must exist as long as the backend
+WindowRenderBackend::WindowRenderBackend(sf::RenderWindow& render_window)
+	// member initializer list. a RenderWindow is a RenderTarget
+	: TargetRenderBackend(render_window)
+{
+	window = &render_window;
+}
+
+WindowRenderBackend::~WindowRenderBackend() {}	// virtual destructor
+
+// show the frame on the window. waits for V-Sync if it is enabled
+void WindowRenderBackend::display()
+{
+	window->display();
+}
+
+
+// Constructor. the render texture is created by create()
+TextureRenderBackend::TextureRenderBackend()
+	// member initializer list. the texture is constructed after the base class, but the base class only stores its address
+	: TargetRenderBackend(texture)
+{
+}
+
+TextureRenderBackend::~TextureRenderBackend() {}	// virtual destructor
+
+// create the render texture
+// width, height: input. size of the texture in pixels. usually the size of the window
+// return: true if the texture was created. false if offscreen rendering is not supported
+bool TextureRenderBackend::create(unsigned int width, unsigned int height)
+{
+	return texture.create(width, height);
+}
+
+// returns the size of the render texture
+sf::Vector2u TextureRenderBackend::get_size()
+{
+	return texture.getSize();
+}
+
+// returns the render texture with the content of the last displayed frame (e.g. to capture it, see FrameCapture)
+sf::RenderTexture& TextureRenderBackend::get_render_texture()
+{
+	return texture;
+}
+
+// finish the frame. the content is copied into the texture
+void TextureRenderBackend::display()
+{
+	texture.display();
+}
+
+
+// Constructor. all counts are 0
+CountingRenderBackend::CountingRenderBackend()
+{
+	reset_stats();
+}
+
+CountingRenderBackend::~CountingRenderBackend() {}	// virtual destructor
+
+// set all counts to 0
+void CountingRenderBackend::reset_stats()
+{
+	frame_stats = render_stats_t();
+	last_frame_stats = render_stats_t();
+	total_stats = render_stats_t();
+	num_frames = 0;
+	owner_stats.clear();
+	current_owner_stats = &owner_stats["other"];
+	has_last_draw = false;
+	last_texture = NULL;
+	last_blend_mode = sf::BlendAlpha;
+	last_shader = NULL;
+}
+
+// returns the counts of the last displayed frame
+const CountingRenderBackend::render_stats_t& CountingRenderBackend::get_frame_stats()
+{
+	return last_frame_stats;
+}
+
+// returns the counts of all displayed frames since the last reset_stats()
+const CountingRenderBackend::render_stats_t& CountingRenderBackend::get_total_stats()
+{
+	return total_stats;
+}
+
+// returns the number of displayed frames since the last reset_stats()
+unsigned long long CountingRenderBackend::get_num_frames()
+{
+	return num_frames;
+}
+
+// returns the average counts per frame and the draw calls of every Entity type, sorted by the number of draw calls, e.g.:
+// "Render cost per frame (100 frames): 31.0 draw calls, 186.0 vertices, 3.0 texture binds, 2.0 state changes
+//    Word: 20.0 draw calls, 120.0 vertices ..."
+string CountingRenderBackend::get_report()
+{
+	double frames = num_frames > 0 ? (double)num_frames : 1;	// avoid a division by 0
+	ostringstream report;
+	report << fixed << setprecision(1) << "Render cost per frame (" << num_frames << " frames): " << total_stats.draw_calls / frames << " draw calls, "
+		<< total_stats.vertices / frames << " vertices, " << total_stats.texture_binds / frames << " texture binds, " << total_stats.state_changes / frames << " state changes";
+
+	vector<pair<string, render_stats_t>> owners(owner_stats.begin(), owner_stats.end());
+	sort(owners.begin(), owners.end(), [](const pair<string, render_stats_t>& a, const pair<string, render_stats_t>& b) { return a.second.draw_calls > b.second.draw_calls; });
+	for (size_t i = 0; i < owners.size(); i++)
+	{
+		const render_stats_t& stats = owners[i].second;
+		if (stats.draw_calls == 0)
+			continue;
+		report << "\n  " << owners[i].first << ": " << stats.draw_calls / frames << " draw calls, " << stats.vertices / frames << " vertices, "
+			<< stats.texture_binds / frames << " texture binds, " << stats.state_changes / frames << " state changes";
+	}
+	return report.str();
+}
+
+// clearing the target isn't counted
+void CountingRenderBackend::clear(const sf::Color& color) {}
+
+// count a text. a text without a font is not drawn
+void CountingRenderBackend::draw(const sf::Text& text, const sf::RenderStates& states)
+{
+	if (text.getFont() == NULL)
+		return;
+
+	const sf::String& text_string = text.getString();
+	size_t num_glyphs = 0;
+	for (size_t i = 0; i < text_string.getSize(); i++)
+	{
+		if (text_string[i] != ' ' && text_string[i] != '\t' && text_string[i] != '\n')
+			num_glyphs++;
+	}
+
+	sf::RenderStates text_states = states;
+	text_states.texture = &text.getFont()->getTexture(text.getCharacterSize());
+	if (text.getOutlineThickness() != 0)
+		count_draw_call(num_glyphs * 6, text_states);
+	count_draw_call(num_glyphs * 6, text_states);
+}
+
+// count a shape (fill and outline)
+void CountingRenderBackend::draw(const sf::Shape& shape, const sf::RenderStates& states)
+{
+	size_t num_points = shape.getPointCount();
+	if (num_points < 3)
+		return;
+
+	sf::RenderStates shape_states = states;
+	shape_states.texture = shape.getTexture();
+	count_draw_call(num_points + 2, shape_states);
+	if (shape.getOutlineThickness() != 0)
+	{
+		shape_states.texture = NULL;
+		count_draw_call((num_points + 1) * 2, shape_states);
+	}
+}
+
+// count a sprite. a sprite without a texture is not drawn
+void CountingRenderBackend::draw(const sf::Sprite& sprite, const sf::RenderStates& states)
+{
+	if (sprite.getTexture() == NULL)
+		return;
+
+	sf::RenderStates sprite_states = states;
+	sprite_states.texture = sprite.getTexture();
+	count_draw_call(4, sprite_states);
+}
+
+// count an array of vertices
+void CountingRenderBackend::draw(const sf::Vertex* vertices, size_t num_vertices, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+	count_draw_call(num_vertices, states);
+}
+
+// the following draws go into the render texture of the layer
+void CountingRenderBackend::begin_layer(RenderLayer& layer)
+{
+	switch_target();
+}
+
+// the following draws go into the target of the frame again
+void CountingRenderBackend::end_layer(RenderLayer& layer)
+{
+	switch_target();
+}
+
+// count drawing the layer texture
+void CountingRenderBackend::draw_layer(RenderLayer& layer)
+{
+	count_draw_call(4, sf::RenderStates(RenderLayer::get_blend_mode(), sf::Transform(), &layer.get_texture(), NULL));
+}
+
+// end of the frame. the counts of the frame are added to the total counts
+void CountingRenderBackend::display()
+{
+	last_frame_stats = frame_stats;
+	add_stats(total_stats, frame_stats);
+	num_frames++;
+	frame_stats = render_stats_t();
+	has_last_draw = false;
+}
+
+// set the Entity type that the following draw calls are counted for
+// owner_name: input. name of the Entity type (see Entity::get_entity_name()). NULL for commands outside of an Entity
+void CountingRenderBackend::set_owner(const char* owner_name)
+{
+	current_owner_stats = &owner_stats[owner_name != NULL ? owner_name : "other"];
+}
+
+// count a draw call in the frame and for the current owner
+// num_vertices: input. number of vertices of the draw call. nothing is drawn without vertices
+// states: input. render states of the draw call, including the texture
+void CountingRenderBackend::count_draw_call(size_t num_vertices, const sf::RenderStates& states)
+{
+	if (num_vertices == 0)
+		return;
+
+	render_stats_t draw_stats = render_stats_t();
+	draw_stats.draw_calls = 1;
+	draw_stats.vertices = num_vertices;
+	if (!has_last_draw || states.texture != last_texture)
+		draw_stats.texture_binds = 1;
+	if (has_last_draw ? !(states.blendMode == last_blend_mode) || states.shader != last_shader : !(states.blendMode == sf::BlendAlpha) || states.shader != NULL)
+		draw_stats.state_changes = 1;
+
+	has_last_draw = true;
+	last_texture = states.texture;
+	last_blend_mode = states.blendMode;
+	last_shader = states.shader;
+
+	add_stats(frame_stats, draw_stats);
+	add_stats(*current_owner_stats, draw_stats);
+}
+
+// count a switch of the render target. the states of the new target are unknown
+void CountingRenderBackend::switch_target()
+{
+	frame_stats.state_changes++;
+	current_owner_stats->state_changes++;
+	has_last_draw = false;
+}
+
+// add counts to a sum
+// sum: input/ output. the sum
+// stats: input. counts to add
+void CountingRenderBackend::add_stats(render_stats_t& sum, const render_stats_t& stats)
+{
+	sum.draw_calls += stats.draw_calls;
+	sum.vertices += stats.vertices;
+	sum.texture_binds += stats.texture_binds;
+	sum.state_changes += stats.state_changes;
+}
@@ -0,0 +1,134 @@
+#include "RenderLayer.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// blend mode for a texture with premultiplied colors (see RenderLayer.h)
+static const sf::BlendMode BLEND_PREMULTIPLIED(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+
+// default Constructor. the layer has no texture until create() is called, so the content is drawn directly on the target
+RenderLayer::RenderLayer()
+{
+	cached = false;
+	dirty = true;
+	recording_target = NULL;
+}
+
+// copy constructor. the copy gets its own texture with the same size. the content is drawn again on the next frame
+// layer_orig: input. layer which shall be copied
+RenderLayer::RenderLayer(const RenderLayer& layer_orig)
+{
+	cached = false;
+	dirty = true;
+	recording_target = NULL;
+	*this = layer_orig;		// use the copy assignment operator
+}
+
+// copy assignment operator. the render texture can't be copied, so a new texture with the same size is created. the content is drawn again on the next frame
+// layer_orig: input. right of the '='. layer which shall be copied
+// return: this layer
+RenderLayer& RenderLayer::operator = (const RenderLayer& layer_orig)
+{
+	if (this != &layer_orig)
+	{
+		if (layer_orig.cached)
+			create(layer_orig.texture.getSize().x, layer_orig.texture.getSize().y);
+		else
+			cached = false;
+		dirty = true;
+	}
+	return *this;
+}
+
+// create the render texture of the layer. usually the size of the window
+// width, height: input. size of the layer in pixels
+// return: true if the render texture was created. if false, the content is drawn directly on the target
+bool RenderLayer::create(unsigned int width, unsigned int height)
+{
+	cached = texture.create(width, height);
+	dirty = true;
+	return cached;
+}
+
+// mark the content as changed. it is drawn again on the next frame
+void RenderLayer::invalidate()
+{
+	dirty = true;
+}
+
+// returns true if the content must be drawn (between begin() and end()) before the layer is drawn
+bool RenderLayer::needs_redraw()
+{
+	return dirty || !cached;
+}
+
+// start recording the content of the layer
+// target: input. the command buffer of the frame that the layer is drawn in
+// return: the command buffer to record the content in. the commands are drawn on the render texture of the layer, or directly on the target if the layer has no render texture
+DrawCommandBuffer& RenderLayer::begin(DrawCommandBuffer& target)
+{
+	recording_target = &target;
+	if (cached)
+		target.begin_layer(*this);
+	return target;
+}
+
+// finish recording the content of the layer. the content stays cached until invalidate() is called
+void RenderLayer::end()
+{
+	if (!cached || recording_target == NULL)
+		return;
+	recording_target->end_layer(*this);
+	recording_target = NULL;
+	dirty = false;
+}
+
+// record drawing the cached content on the target. does nothing if the layer has no render texture (the content was already recorded for the target itself)
+// target: input. the command buffer of the frame
+void RenderLayer::draw_on_window(DrawCommandBuffer& target)
+{
+	if (!cached)
+		return;
+	target.draw_layer(*this);
+}
+
+// returns the render texture with the cached content. only valid if the layer was created
+const sf::Texture& RenderLayer::get_texture()
+{
+	return texture.getTexture();
+}
+
+// returns the blend mode that the cached content is drawn with (see RenderLayer.h)
+sf::BlendMode RenderLayer::get_blend_mode()
+{
+	return BLEND_PREMULTIPLIED;
+}
+
+// replay of begin(). called by the TargetRenderBackend in the thread that draws the frame
+// target: input. the target that the layer is drawn on
+// return: the cleared render texture of the layer
+sf::RenderTarget& RenderLayer::replay_begin(sf::RenderTarget& target)
+{
+	if (!cached)
+		return target;
+	texture.clear(sf::Color::Transparent);
+	return texture;
+}
+
+// replay of end(). the content is ready to be drawn
+void RenderLayer::replay_end()
+{
+	if (!cached)
+		return;
+	TRACE_ZONE("RenderLayer::end");
+	texture.display();
+}
+
+// replay of draw_on_window(). draw the cached content on the target (a window or any other render target)
+// target: input. the target of the frame
+void RenderLayer::replay_draw(sf::RenderTarget& target)
+{
+	if (!cached)
+		return;
+	target.draw(sf::Sprite(texture.getTexture()), sf::RenderStates(BLEND_PREMULTIPLIED));
+}
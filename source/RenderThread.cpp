@@ -0,0 +1,174 @@
+#include "RenderThread.h"
+#include "FontManager.h"
+#include "FrameProfiler.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor. the render thread is started by start()
+// render_window: input. the window that the frames are drawn on. must exist as long as this object
+// pacer: input. paces the frames. only used by the render thread while it runs
+RenderThread::RenderThread(sf::RenderWindow& render_window, FramePacer& pacer)
+	// member initializer list
+	: window_backend(render_window)
+{
+	window = &render_window;
+	frame_pacer = &pacer;
+	frame_capture = NULL;
+	for (unsigned int i = 0; i < 2; i++)
+		command_buffers[i] = DrawCommandBuffer(render_window.getSize(), &render_window);
+	record_index = 0;
+	submitted_buffer = NULL;
+	running = false;
+	pacing_changed = false;
+	new_pacing_mode = FramePacer::VSYNC;
+	new_fps_cap = FramePacer::DEFAULT_FPS_CAP;
+	skip_pacing = false;
+}
+
+// Destructor. terminates the render thread
+RenderThread::~RenderThread()
+{
+	stop();
+}
+
+// start the render thread. the OpenGL context of the window is moved to the render thread
+void RenderThread::start()
+{
+	if (render_thread.joinable())
+		return;
+
+	window->setActive(false);	// a context can only be active in one thread
+	running = true;
+	render_thread = thread(&RenderThread::render_task, this);
+}
+
+// terminate the render thread. a submitted frame that isn't drawn yet is dropped. must be called before the window is closed
+void RenderThread::stop()
+{
+	{
+		lock_guard<mutex> lock(render_mutex);
+		running = false;
+		submitted_buffer = NULL;
+	}
+	render_cv.notify_all();
+	if (render_thread.joinable())
+		render_thread.join();
+}
+
+// returns the command buffer to record the next frame in. it is empty until the first draw call of the frame
+DrawCommandBuffer& RenderThread::get_command_buffer()
+{
+	return command_buffers[record_index];
+}
+
+// hand the recorded frame to the render thread. waits until the render thread has displayed the frame before, then the other buffer is cleared for the next frame.
+// the waiting time is measured by the FrameProfiler. if the render thread doesn't run, the frame is dropped
+void RenderThread::submit()
+{
+	sf::Clock wait_clock;
+	{
+		unique_lock<mutex> lock(render_mutex);
+		render_cv.wait(lock, [this] { return submitted_buffer == NULL || !running; });
+		if (running)
+		{
+			submitted_buffer = &command_buffers[record_index];
+			record_index = 1 - record_index;
+		}
+	}
+	render_cv.notify_all();
+	frame_profiler.add_sample(FrameProfiler::RENDER_WAIT, wait_clock.getElapsedTime());
+
+	command_buffers[record_index].reset();	// the render thread doesn't use this buffer anymore
+}
+
+// wait until the submitted frame is displayed. afterwards the fonts, textures and RenderLayers of the recorded commands can be deleted (e.g. when the screen is switched)
+void RenderThread::flush()
+{
+	unique_lock<mutex> lock(render_mutex);
+	render_cv.wait(lock, [this] { return submitted_buffer == NULL || !running; });
+}
+
+// change the frame pacing. applied by the render thread before the next frame, because the V-Sync can only be changed by the thread with the OpenGL context
+// pacing_mode: input. see FramePacer::pacing_modes
+// cap: input. frame rate of the FPS_CAP mode
+void RenderThread::set_frame_pacing(int pacing_mode, unsigned int cap)
+{
+	lock_guard<mutex> lock(render_mutex);
+	pacing_changed = true;
+	new_pacing_mode = pacing_mode;
+	new_fps_cap = cap;
+}
+
+// the time until the next frame is not measured by the frame pacer. used if the main loop waited for an event (see idle mode in main.cpp)
+void RenderThread::skip_frame()
+{
+	lock_guard<mutex> lock(render_mutex);
+	skip_pacing = true;
+}
+
+// capture the frames of the window. must be called before start()
+// capture: input. the capture that receives the frames. must exist as long as the render thread runs. NULL to capture nothing
+void RenderThread::set_frame_capture(FrameCapture* capture)
+{
+	frame_capture = capture;
+}
+
+// runs in the render thread. draws every submitted frame on the window, displays it and waits for the next frame
+void RenderThread::render_task()
+{
+	TRACE_THREAD_NAME("render");
+	window->setActive(true);
+	sf::Clock stage_clock;	// measures the duration of the drawing and of display() for the FrameProfiler
+
+	while (1)
+	{
+		const DrawCommandBuffer* frame;
+		{
+			unique_lock<mutex> lock(render_mutex);
+			render_cv.wait(lock, [this] { return submitted_buffer != NULL || !running; });
+			if (!running)
+				break;
+
+			frame = submitted_buffer;
+			if (pacing_changed)
+			{
+				frame_pacer->set_mode(new_pacing_mode, new_fps_cap);
+				pacing_changed = false;
+			}
+			if (skip_pacing)
+			{
+				frame_pacer->skip_frame();
+				skip_pacing = false;
+			}
+		}
+
+		// the main thread records the next frame in the other buffer in the meantime
+		stage_clock.restart();
+		{
+			TRACE_ZONE("render");
+			{
+				// the main thread may add glyphs to the fonts of the frame in the meantime (see FontManager::warm_string())
+				lock_guard<mutex> glyph_lock(FontManager::glyph_mutex);
+				frame->replay(window_backend);
+			}
+			if (frame_capture != NULL)
+				frame_capture->capture_window(*window);		// before display(), because the back buffer is undefined afterwards
+		}
+		frame_profiler.add_sample(FrameProfiler::RENDER, stage_clock.restart());
+		{
+			TRACE_ZONE("display");	// waits for V-Sync
+			window_backend.display();
+		}
+		frame_profiler.add_sample(FrameProfiler::DISPLAY, stage_clock.restart());
+		frame_pacer->wait_frame();		// waits for the start of the next frame in the FPS_CAP mode
+
+		{
+			lock_guard<mutex> lock(render_mutex);
+			submitted_buffer = NULL;
+		}
+		render_cv.notify_all();
+	}
+
+	window->setActive(false);
+}
@@ -0,0 +1,83 @@
+#include "ResourceManager.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor
+// resource_path: input. path of the file that can't be loaded
+// resource_kind: input. kind of the resource ("texture" or "font")
+ResourceLoadError::ResourceLoadError(const string& resource_path, const string& resource_kind)
+	: runtime_error("the " + resource_kind + " " + resource_path + " can't be loaded")
+{
+	path = resource_path;
+	kind = resource_kind;
+}
+
+// returns the path of the file that can't be loaded
+const string& ResourceLoadError::get_path() const
+{
+	return path;
+}
+
+// returns the kind of the resource ("texture" or "font")
+const string& ResourceLoadError::get_kind() const
+{
+	return kind;
+}
+
+// load the resources that are known at the start of the game, so they are available without a delay later
+// texture_paths: input. paths of the textures
+// font_paths: input. paths of the fonts
+// throws ResourceLoadError if a file can't be loaded
+void ResourceManager::preload(const vector<string>& texture_paths, const vector<string>& font_paths)
+{
+	TRACE_ZONE("ResourceManager::preload");
+	for (size_t i = 0; i < texture_paths.size(); i++)
+		get_texture(texture_paths[i]);
+	for (size_t i = 0; i < font_paths.size(); i++)
+		get_font(font_paths[i]);
+}
+
+// returns the texture of a file. the file is loaded on the first call
+// path: input. path of the image file
+// throws ResourceLoadError if the file can't be loaded
+shared_ptr<const sf::Texture> ResourceManager::get_texture(const string& path)
+{
+	{
+		lock_guard<mutex> lock(cache_mutex);
+		auto texture_it = textures.find(path);
+		if (texture_it != textures.end())
+			return texture_it->second;
+	}
+
+	TRACE_ZONE("ResourceManager load texture");
+	shared_ptr<sf::Texture> texture = make_shared<sf::Texture>();
+	if (!texture->loadFromFile(path))
+		throw ResourceLoadError(path, "texture");
+
+	// if another thread loaded the same file in the meantime, its texture is used
+	lock_guard<mutex> lock(cache_mutex);
+	return textures.insert(make_pair(path, texture)).first->second;
+}
+
+// returns the font of a file. the file is loaded on the first call
+// path: input. path of the font file
+// throws ResourceLoadError if the file can't be loaded
+shared_ptr<const sf::Font> ResourceManager::get_font(const string& path)
+{
+	{
+		lock_guard<mutex> lock(cache_mutex);
+		auto font_it = fonts.find(path);
+		if (font_it != fonts.end())
+			return font_it->second;
+	}
+
+	TRACE_ZONE("ResourceManager load font");
+	shared_ptr<sf::Font> font = make_shared<sf::Font>();
+	if (!font->loadFromFile(path))
+		throw ResourceLoadError(path, "font");
+
+	// if another thread loaded the same file in the meantime, its font is used
+	lock_guard<mutex> lock(cache_mutex);
+	return fonts.insert(make_pair(path, font)).first->second;
+}
@@ -0,0 +1,530 @@
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include "ScoreHistory.h"
+#include "GameSettings.h"
+#include "ByteOrder.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+static const char log_magic[4] = { 'T', 'G', 'S', 'H' };	// first bytes of the score log
+static const char index_magic[4] = { 'T', 'G', 'S', 'I' };	// first bytes of the index
+
+// the bits of a float as unsigned number, so it can be written in little endian byte order
+static sf::Uint32 float_to_bits(float value)
+{
+	sf::Uint32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+// the float from its bits
+static float bits_to_float(sf::Uint32 bits)
+{
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// sizes of the entries of the index file. in bytes
+enum index_entry_length
+{
+	INDEX_HEADER_LENGTH = 12,	// magic, format version, reserved, number of records
+	DAY_ENTRY_LENGTH = 28,
+	SETTING_ENTRY_LENGTH = 24
+};
+
+// Constructor. the score log is opened and the index is loaded on first use (see open_log())
+// log_filename_in: input. path of the score log. the index has the same path with the extension ".idx"
+// persistence_worker: input. writes the log and the index in the background. must exist as long as this object
+ScoreHistory::ScoreHistory(const string& log_filename_in, PersistenceWorker& persistence_worker)
+{
+	log_filename = log_filename_in;
+	index_filename = log_filename.substr(0, log_filename.find_last_of('.')) + ".idx";
+	persistence = &persistence_worker;
+	read_only = false;
+	log_opened = false;
+}
+
+// Destructor. the queued appends and the index are written by the PersistenceWorker
+ScoreHistory::~ScoreHistory() {}
+
+// prevent the storing of rounds. used when the game logic is run by a simulation, so the history of the player is not changed.
+// if this is called before the first use, the files are not created or compacted either
+// enable: input. true: don't store rounds anymore. false: store rounds again
+void ScoreHistory::set_read_only(bool enable)
+{
+	read_only = enable;
+}
+
+// open the score log on first use. called by every function that reads or changes the store
+void ScoreHistory::open_log()
+{
+	if (log_opened)
+		return;
+	log_opened = true;	// set first, because init_log() calls compact()
+	init_log();
+}
+
+// open the score log. create it if it doesn't exist (not in read-only mode). load the index and add the rounds to it that are not in the index yet.
+// if the log contains broken records, it is compacted
+void ScoreHistory::init_log()
+{
+	TRACE_ZONE("ScoreHistory::init_log");
+	clear_index();
+
+	ifstream fin(log_filename, ios::binary);
+	if (!fin.good())	// create a new log that only contains the header
+	{
+		if (read_only)
+			return;
+		char header[LOG_HEADER_LENGTH];
+		memcpy(header, log_magic, sizeof(log_magic));
+		write_uint_le(header + 4, FORMAT_VERSION, 2);
+		write_uint_le(header + 6, RECORD_LENGTH, 2);
+		PersistenceWorker::write_file_atomic(log_filename, header, sizeof(header));
+		save_index();
+		return;
+	}
+	fin.close();
+
+	if (load_index() < 0)
+		clear_index();
+
+	// add the rounds to the index that were appended after the index was written
+	bool log_broken = false;
+	unsigned int num_indexed = num_records;
+	if (read_log(num_indexed, log_broken) < 0)
+	{
+		// the index contains more rounds than the log (e.g. the log was replaced). rebuild the index from the whole log
+		clear_index();
+		num_indexed = 0;
+		read_log(0, log_broken);
+	}
+
+	if (log_broken)
+		compact();
+	else if (num_records != num_indexed)
+		save_index();
+}
+
+// reset the index to an empty log
+void ScoreHistory::clear_index()
+{
+	num_records = 0;
+	top_rounds.clear();
+	days.clear();
+	settings.clear();
+}
+
+// update the leaderboard, the day summary and the setting summary with a new round
+// record: input. the new round
+// record_index: input. index of the round in the log
+void ScoreHistory::add_to_index(const round_record_t& record, unsigned int record_index)
+{
+	// insert in the leaderboard after all rounds with the same or a higher score
+	if (top_rounds.size() < TOP_K || record.score > top_rounds.back().score)
+	{
+		vector<round_record_t>::iterator top_it = top_rounds.begin();
+		while (top_it != top_rounds.end() && top_it->score >= record.score)
+			top_it++;
+		top_rounds.insert(top_it, record);
+		if (top_rounds.size() > TOP_K)
+			top_rounds.pop_back();
+	}
+
+	unsigned int day = get_day(record.timestamp);
+	map<unsigned int, day_summary_t>::iterator day_it = days.find(day);
+	if (day_it == days.end())
+	{
+		day_summary_t new_day = { day, 0, record.score, 0, record_index, record_index };
+		day_it = days.insert(make_pair(day, new_day)).first;
+	}
+	day_it->second.num_rounds++;
+	day_it->second.total_score += record.score;
+	if (record.score > day_it->second.best_score)
+		day_it->second.best_score = record.score;
+	day_it->second.last_record = record_index;
+
+	unsigned int setting_key = get_setting_key(record.boundary_id, record.num_words_spawn);
+	map<unsigned int, setting_summary_t>::iterator setting_it = settings.find(setting_key);
+	if (setting_it == settings.end())
+	{
+		setting_summary_t new_setting = { record.boundary_id, record.num_words_spawn, 0, record.score, 0, record.wpm };
+		setting_it = settings.insert(make_pair(setting_key, new_setting)).first;
+	}
+	setting_it->second.num_rounds++;
+	setting_it->second.total_score += record.score;
+	if (record.score > setting_it->second.best_score)
+		setting_it->second.best_score = record.score;
+	if (record.wpm > setting_it->second.best_wpm)
+		setting_it->second.best_wpm = record.wpm;
+}
+
+// load the index file with one read
+// return: -1 if the index doesn't exist or is broken. 0 if no error
+int ScoreHistory::load_index()
+{
+	ifstream fin(index_filename, ios::binary);
+	if (!fin.good())	// check error state
+		return -1;
+	fin.seekg(0, fin.end);
+	streamoff file_size = fin.tellg();
+	if (file_size < INDEX_HEADER_LENGTH + 3 * 4 + CHECKSUM_LENGTH)
+		return -1;
+	vector<char> buffer((size_t)file_size);
+	fin.seekg(0, fin.beg);
+	fin.read(buffer.data(), buffer.size());
+	if (fin.gcount() != file_size)
+		return -1;
+
+	size_t data_length = buffer.size() - CHECKSUM_LENGTH;
+	if (memcmp(buffer.data(), index_magic, sizeof(index_magic)) != 0 || read_uint_le(buffer.data() + 4, 2) != FORMAT_VERSION ||
+		read_uint_le(buffer.data() + data_length, CHECKSUM_LENGTH) != SettingsFileParser::calculate_crc32(buffer.data(), data_length))
+		return -1;
+
+	const char* data = buffer.data();
+	size_t offset = INDEX_HEADER_LENGTH;
+	num_records = (unsigned int)read_uint_le(data + 8, 4);
+
+	// leaderboard
+	unsigned int num_top = (unsigned int)read_uint_le(data + offset, 4);
+	offset += 4;
+	if (num_top > TOP_K || offset + (size_t)num_top * RECORD_LENGTH + 4 > data_length)
+		return -1;
+	for (unsigned int i = 0; i < num_top; i++, offset += RECORD_LENGTH)
+	{
+		round_record_t record;
+		if (!deserialize_record(data + offset, record))
+			return -1;
+		top_rounds.push_back(record);
+	}
+
+	// day summaries
+	unsigned int num_days = (unsigned int)read_uint_le(data + offset, 4);
+	offset += 4;
+	if (offset + (size_t)num_days * DAY_ENTRY_LENGTH + 4 > data_length)
+		return -1;
+	for (unsigned int i = 0; i < num_days; i++, offset += DAY_ENTRY_LENGTH)
+	{
+		day_summary_t day;
+		day.day = (unsigned int)read_uint_le(data + offset, 4);
+		day.num_rounds = (unsigned int)read_uint_le(data + offset + 4, 4);
+		day.best_score = (int)read_uint_le(data + offset + 8, 4);
+		day.total_score = (sf::Int64)read_uint_le(data + offset + 12, 8);
+		day.first_record = (unsigned int)read_uint_le(data + offset + 20, 4);
+		day.last_record = (unsigned int)read_uint_le(data + offset + 24, 4);
+		days[day.day] = day;
+	}
+
+	// setting summaries
+	unsigned int num_settings = (unsigned int)read_uint_le(data + offset, 4);
+	offset += 4;
+	if (offset + (size_t)num_settings * SETTING_ENTRY_LENGTH != data_length)
+		return -1;
+	for (unsigned int i = 0; i < num_settings; i++, offset += SETTING_ENTRY_LENGTH)
+	{
+		setting_summary_t setting;
+		setting.boundary_id = (char)read_uint_le(data + offset, 1);
+		setting.num_words_spawn = (unsigned int)read_uint_le(data + offset + 2, 2);
+		setting.num_rounds = (unsigned int)read_uint_le(data + offset + 4, 4);
+		setting.best_score = (int)read_uint_le(data + offset + 8, 4);
+		setting.total_score = (sf::Int64)read_uint_le(data + offset + 12, 8);
+		setting.best_wpm = bits_to_float((sf::Uint32)read_uint_le(data + offset + 20, 4));
+		settings[get_setting_key(setting.boundary_id, setting.num_words_spawn)] = setting;
+	}
+
+	return 0;
+}
+
+// serialize the index and queue it to be written by the PersistenceWorker. the index file is replaced atomically
+void ScoreHistory::save_index()
+{
+	if (read_only)
+		return;
+
+	vector<char> buffer(INDEX_HEADER_LENGTH + 4 + top_rounds.size() * RECORD_LENGTH + 4 + days.size() * DAY_ENTRY_LENGTH +
+		4 + settings.size() * SETTING_ENTRY_LENGTH + CHECKSUM_LENGTH, 0);
+	char* data = buffer.data();
+	size_t offset = INDEX_HEADER_LENGTH;
+
+	memcpy(data, index_magic, sizeof(index_magic));
+	write_uint_le(data + 4, FORMAT_VERSION, 2);
+	write_uint_le(data + 8, num_records, 4);
+
+	write_uint_le(data + offset, top_rounds.size(), 4);
+	offset += 4;
+	for (size_t i = 0; i < top_rounds.size(); i++, offset += RECORD_LENGTH)
+		serialize_record(top_rounds[i], data + offset);
+
+	write_uint_le(data + offset, days.size(), 4);
+	offset += 4;
+	for (map<unsigned int, day_summary_t>::iterator day_it = days.begin(); day_it != days.end(); day_it++, offset += DAY_ENTRY_LENGTH)
+	{
+		write_uint_le(data + offset, day_it->second.day, 4);
+		write_uint_le(data + offset + 4, day_it->second.num_rounds, 4);
+		write_uint_le(data + offset + 8, (sf::Uint32)day_it->second.best_score, 4);
+		write_uint_le(data + offset + 12, (sf::Uint64)day_it->second.total_score, 8);
+		write_uint_le(data + offset + 20, day_it->second.first_record, 4);
+		write_uint_le(data + offset + 24, day_it->second.last_record, 4);
+	}
+
+	write_uint_le(data + offset, settings.size(), 4);
+	offset += 4;
+	for (map<unsigned int, setting_summary_t>::iterator setting_it = settings.begin(); setting_it != settings.end(); setting_it++, offset += SETTING_ENTRY_LENGTH)
+	{
+		write_uint_le(data + offset, (sf::Uint8)setting_it->second.boundary_id, 1);
+		write_uint_le(data + offset + 2, setting_it->second.num_words_spawn, 2);
+		write_uint_le(data + offset + 4, setting_it->second.num_rounds, 4);
+		write_uint_le(data + offset + 8, (sf::Uint32)setting_it->second.best_score, 4);
+		write_uint_le(data + offset + 12, (sf::Uint64)setting_it->second.total_score, 8);
+		write_uint_le(data + offset + 20, float_to_bits(setting_it->second.best_wpm), 4);
+	}
+
+	write_uint_le(data + offset, SettingsFileParser::calculate_crc32(data, offset), CHECKSUM_LENGTH);
+	persistence->request_write(index_filename, data, buffer.size());
+}
+
+// add the records of the log from first_record to the end to the index
+// first_record: input. index of the first record to add
+// log_broken: output. set to true if the log has a broken header or contains broken records (they are not added)
+// return: -1 if the log has less than first_record records. 0 if no error
+int ScoreHistory::read_log(unsigned int first_record, bool& log_broken)
+{
+	if (log_mapping.open(log_filename) < 0 || log_mapping.size() < LOG_HEADER_LENGTH)
+	{
+		log_broken = true;
+		return first_record > 0 ? -1 : 0;
+	}
+
+	const char* data = log_mapping.data();
+	if (memcmp(data, log_magic, sizeof(log_magic)) != 0 || read_uint_le(data + 6, 2) != RECORD_LENGTH)
+	{
+		log_broken = true;
+		return first_record > 0 ? -1 : 0;
+	}
+
+	size_t records_length = log_mapping.size() - LOG_HEADER_LENGTH;
+	unsigned int num_log_records = (unsigned int)(records_length / RECORD_LENGTH);
+	if (records_length % RECORD_LENGTH != 0)	// incomplete record at the end (the program crashed during an append)
+		log_broken = true;
+	if (num_log_records < first_record)
+		return -1;
+
+	for (unsigned int i = first_record; i < num_log_records; i++)
+	{
+		round_record_t record;
+		if (deserialize_record(data + LOG_HEADER_LENGTH + (size_t)i * RECORD_LENGTH, record))
+			add_to_index(record, i);
+		else
+			log_broken = true;
+	}
+	num_records = num_log_records;
+	return 0;
+}
+
+// get a pointer to records of the log. the log is mapped again, if the records were appended after the last mapping.
+// first_record: input. index of the first record
+// num: input. number of records
+// return: pointer to the first record. NULL if the records can't be read
+const char* ScoreHistory::map_records(unsigned int first_record, unsigned int num)
+{
+	size_t end = LOG_HEADER_LENGTH + ((size_t)first_record + num) * RECORD_LENGTH;
+	if (log_mapping.size() < end)
+	{
+		persistence->flush();	// wait until the queued appends are written
+		if (log_mapping.open(log_filename) < 0 || log_mapping.size() < end)
+			return NULL;
+	}
+	return log_mapping.data() + LOG_HEADER_LENGTH + (size_t)first_record * RECORD_LENGTH;
+}
+
+// store a finished round. the record is appended to the log and the index is updated
+// record: input. the finished round
+void ScoreHistory::append_round(const round_record_t& record)
+{
+	TRACE_ZONE("ScoreHistory::append_round");
+	if (read_only)
+		return;
+	open_log();
+
+	char buffer[RECORD_LENGTH];
+	serialize_record(record, buffer);
+	persistence->request_append(log_filename, buffer, sizeof(buffer));
+
+	add_to_index(record, num_records);
+	num_records++;
+	save_index();
+}
+
+// returns the number of stored rounds
+unsigned int ScoreHistory::get_num_rounds()
+{
+	open_log();
+	return num_records;
+}
+
+// get the best rounds. the log is not read
+// k: input. maximum number of rounds. at most TOP_K
+// rounds_out: output. the best rounds sorted by score (descending)
+// return: number of rounds in rounds_out
+unsigned int ScoreHistory::get_top_rounds(unsigned int k, vector<round_record_t>& rounds_out)
+{
+	open_log();
+	if (k > top_rounds.size())
+		k = (unsigned int)top_rounds.size();
+	rounds_out.assign(top_rounds.begin(), top_rounds.begin() + k);
+	return k;
+}
+
+// get the statistics of one day. the log is not read
+// day: input. local date as number yyyymmdd (see get_day())
+// summary_out: output. statistics of the day
+// return: false if no round was played on this day
+bool ScoreHistory::get_day_summary(unsigned int day, day_summary_t& summary_out)
+{
+	open_log();
+	map<unsigned int, day_summary_t>::iterator day_it = days.find(day);
+	if (day_it == days.end())
+		return false;
+	summary_out = day_it->second;
+	return true;
+}
+
+// get the statistics of all rounds that were played with the given settings. the log is not read
+// boundary_id: input. playfield boundary
+// num_words_spawn: input. number of words on the playfield
+// summary_out: output. statistics of the settings
+// return: false if no round was played with these settings
+bool ScoreHistory::get_setting_summary(char boundary_id, unsigned int num_words_spawn, setting_summary_t& summary_out)
+{
+	open_log();
+	map<unsigned int, setting_summary_t>::iterator setting_it = settings.find(get_setting_key(boundary_id, num_words_spawn));
+	if (setting_it == settings.end())
+		return false;
+	summary_out = setting_it->second;
+	return true;
+}
+
+// get all rounds of one day. only the range of the log between the first and the last round of the day is read
+// day: input. local date as number yyyymmdd (see get_day())
+// rounds_out: output. the rounds of the day in the order they were played
+// return: number of rounds in rounds_out
+unsigned int ScoreHistory::get_rounds_of_day(unsigned int day, vector<round_record_t>& rounds_out)
+{
+	rounds_out.clear();
+	day_summary_t summary;
+	if (!get_day_summary(day, summary))
+		return 0;
+
+	unsigned int num = summary.last_record - summary.first_record + 1;
+	const char* records = map_records(summary.first_record, num);
+	if (records == NULL)
+		return 0;
+	for (unsigned int i = 0; i < num; i++)
+	{
+		round_record_t record;
+		if (deserialize_record(records + (size_t)i * RECORD_LENGTH, record) && get_day(record.timestamp) == day)
+			rounds_out.push_back(record);
+	}
+	return (unsigned int)rounds_out.size();
+}
+
+// rewrite the log without the broken records and rebuild the index. The log is replaced atomically.
+// called when the log is opened and contains broken records (e.g. an incomplete record at the end after a crash), because new records must start at a record boundary
+// return: -1 if the log can't be written. 0 if no error
+int ScoreHistory::compact()
+{
+	TRACE_ZONE("ScoreHistory::compact");
+	if (read_only)
+		return 0;
+	log_opened = true;	// the index is rebuilt from the log below
+	persistence->flush();	// the queued appends must be in the log before it is rewritten
+
+	vector<char> buffer(LOG_HEADER_LENGTH);
+	memcpy(buffer.data(), log_magic, sizeof(log_magic));
+	write_uint_le(buffer.data() + 4, FORMAT_VERSION, 2);
+	write_uint_le(buffer.data() + 6, RECORD_LENGTH, 2);
+
+	clear_index();
+	if (log_mapping.open(log_filename) == 0 && log_mapping.size() >= LOG_HEADER_LENGTH &&
+		memcmp(log_mapping.data(), log_magic, sizeof(log_magic)) == 0 && read_uint_le(log_mapping.data() + 6, 2) == RECORD_LENGTH)
+	{
+		unsigned int num_log_records = (unsigned int)((log_mapping.size() - LOG_HEADER_LENGTH) / RECORD_LENGTH);
+		for (unsigned int i = 0; i < num_log_records; i++)
+		{
+			const char* record_data = log_mapping.data() + LOG_HEADER_LENGTH + (size_t)i * RECORD_LENGTH;
+			round_record_t record;
+			if (!deserialize_record(record_data, record))
+				continue;
+			buffer.insert(buffer.end(), record_data, record_data + RECORD_LENGTH);
+			add_to_index(record, num_records);
+			num_records++;
+		}
+	}
+	log_mapping.close();
+
+	int ret = PersistenceWorker::write_file_atomic(log_filename, buffer.data(), buffer.size());
+	save_index();
+	return ret;
+}
+
+// get the local date of a timestamp as a number. e.g. 20240131
+// timestamp: input. in seconds since January 1, 1970
+// return: the date as number yyyymmdd
+unsigned int ScoreHistory::get_day(sf::Int64 timestamp)
+{
+	time_t time_value = (time_t)timestamp;
+	struct tm local_time;
+#ifdef _WIN32
+	localtime_s(&local_time, &time_value);
+#else
+	localtime_r(&time_value, &local_time);
+#endif
+	return (local_time.tm_year + 1900) * 10000 + (local_time.tm_mon + 1) * 100 + local_time.tm_mday;
+}
+
+// returns the key of a combination of settings in the map of the setting summaries
+unsigned int ScoreHistory::get_setting_key(char boundary_id, unsigned int num_words_spawn)
+{
+	return ((unsigned int)(sf::Uint8)boundary_id << 16) | (num_words_spawn & 0xFFFF);
+}
+
+// write a round into a record of the log
+// record: input. the round
+// buffer: output. the record. must have a size of RECORD_LENGTH
+void ScoreHistory::serialize_record(const round_record_t& record, char* buffer)
+{
+	write_uint_le(buffer, (sf::Uint64)record.timestamp, 8);
+	write_uint_le(buffer + 8, (sf::Uint32)record.score, 4);
+	write_uint_le(buffer + 12, record.typed_words > 0xFFFF ? 0xFFFF : record.typed_words, 2);
+	write_uint_le(buffer + 14, record.missed_words > 0xFFFF ? 0xFFFF : record.missed_words, 2);
+	write_uint_le(buffer + 16, float_to_bits(record.wpm), 4);
+	write_uint_le(buffer + 20, float_to_bits(record.accuracy), 4);
+	write_uint_le(buffer + 24, (sf::Uint8)record.boundary_id, 1);
+	write_uint_le(buffer + 25, (sf::Uint8)record.font_id, 1);
+	write_uint_le(buffer + 26, record.num_words_spawn > 0xFFFF ? 0xFFFF : record.num_words_spawn, 2);
+	write_uint_le(buffer + 28, SettingsFileParser::calculate_crc32(buffer, RECORD_LENGTH - CHECKSUM_LENGTH), CHECKSUM_LENGTH);
+}
+
+// read a round from a record of the log
+// buffer: input. the record
+// record: output. the round
+// return: false if the checksum of the record is wrong
+bool ScoreHistory::deserialize_record(const char* buffer, round_record_t& record)
+{
+	if (read_uint_le(buffer + 28, CHECKSUM_LENGTH) != SettingsFileParser::calculate_crc32(buffer, RECORD_LENGTH - CHECKSUM_LENGTH))
+		return false;
+
+	record.timestamp = (sf::Int64)read_uint_le(buffer, 8);
+	record.score = (int)read_uint_le(buffer + 8, 4);
+	record.typed_words = (unsigned int)read_uint_le(buffer + 12, 2);
+	record.missed_words = (unsigned int)read_uint_le(buffer + 14, 2);
+	record.wpm = bits_to_float((sf::Uint32)read_uint_le(buffer + 16, 4));
+	record.accuracy = bits_to_float((sf::Uint32)read_uint_le(buffer + 20, 4));
+	record.boundary_id = (char)read_uint_le(buffer + 24, 1);
+	record.font_id = (char)read_uint_le(buffer + 25, 1);
+	record.num_words_spawn = (unsigned int)read_uint_le(buffer + 26, 2);
+	return true;
+}
@@ -0,0 +1,56 @@
+#include "SplashScreen.h"
+
+// dimensions of the progress bar. in pixels
+static const sf::Vector2f PROGRESS_SIZE(400.f, 16.f);
+
+// Constructor
+SplashScreen::SplashScreen(GameSettings& game_settings)
+{
+	settings = &game_settings;	// save the Address of game_settings in a pointer
+
+	// set up the progress bar in the middle of the window
+	sf::Vector2f position((settings->get_window_size().x - PROGRESS_SIZE.x) / 2, (settings->get_window_size().y - PROGRESS_SIZE.y) / 2);
+	progress_outline.setSize(PROGRESS_SIZE);
+	progress_outline.setPosition(position);
+	progress_outline.setFillColor(sf::Color::Transparent);
+	progress_outline.setOutlineColor(sf::Color(150, 150, 150, 255));
+	progress_outline.setOutlineThickness(2);
+	progress_bar.setPosition(position);
+	progress_bar.setFillColor(sf::Color(150, 150, 150, 255));
+	update();
+}
+
+inline SplashScreen::~SplashScreen() {}	// virtual destructor
+
+// update the progress bar and show the Start Screen when the font is loaded
+inline void SplashScreen::update()
+{
+	progress_bar.setSize(sf::Vector2f(PROGRESS_SIZE.x * settings->get_asset_loader().get_progress(), PROGRESS_SIZE.y));
+	if (settings->get_asset_loader().is_done(GameSettings::FONT_PHASE))
+		settings->game_state = GameSettings::START_SCREEN;
+}
+
+inline void SplashScreen::update_physics() {}
+
+// draw the progress bar on the window
+inline void SplashScreen::draw_on_window(DrawCommandBuffer& target)
+{
+	target.draw(progress_bar);
+	target.draw(progress_outline);
+}
+
+inline void SplashScreen::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt) {}
+
+inline void SplashScreen::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt) {}
+
+// the progress bar changes without an input event
+inline bool SplashScreen::is_animating()
+{
+	return true;
+}
+
+// name of the Entity type for the CountingRenderBackend
+inline const char* SplashScreen::get_entity_name()
+{
+	return "SplashScreen";
+}
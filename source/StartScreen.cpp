@@ -1,89 +1,159 @@
-#include "StartScreen.h"
-
-// Constructor
-StartScreen::StartScreen(GameSettings& game_settings)
-	// member initializer list. Initialize the Buttons
-	: start_btn("START >", game_settings.getFont(), 40), exit_btn("< EXIT", game_settings.getFont(), 40), options_btn("OPTIONS", game_settings.getFont(), 40)
-{
-	settings = &game_settings;	// save the Address of game_settings in a pointer
-
-	// set up Game title text
-	game_title.setString("Typing Game");
-	game_title.setFont(settings->getFont());
-	game_title.setCharacterSize(40);
-	game_title.setStyle(sf::Text::Bold);
-	game_title.setLetterSpacing(1.5);
-	game_title.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (game_title.getGlobalBounds().width / 2), 80.f));
-
-	// set up the position of the buttons
-	float button_spacing = 150;		// in pixel. vertical spacing between every Button (from middle to middle)
-	start_btn.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (start_btn.getSize().x / 2),
-		(settings->get_window_size().y / 2) - (button_spacing + (start_btn.getSize().y / 2))));
-	options_btn.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (options_btn.getSize().x / 2),
-		(settings->get_window_size().y / 2) - (options_btn.getSize().y / 2)));
-	exit_btn.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (exit_btn.getSize().x / 2),
-		(settings->get_window_size().y / 2) + button_spacing - (exit_btn.getSize().y / 2)));
-
-	// set up the status message
-	status_msg.setFont(settings->getFont());
-	status_msg.setCharacterSize(30);
-	status_msg.setStyle(sf::Text::Bold);
-	status_msg.setLetterSpacing(1.5);
-	switch (settings->file_state)
-	{
-	case GameSettings::CREATE_NEW:
-		status_msg.setString("Creating new settings file.");
-		settings->file_state = GameSettings::GOOD;			// set the file state to good after the query
-		break;
-	case GameSettings::CREATE_NEW_FAIL:
-		status_msg.setString("No settings file can be created, saving not possible!");
-		break;
-	default:
-		status_msg.setString("");
-		break;
-	}	
-	// set Origin of Text to be on the bottom left of the word
-	status_msg.setOrigin(status_msg.getPosition().x, status_msg.getPosition().y + status_msg.getGlobalBounds().height + (status_msg.getGlobalBounds().top - status_msg.getPosition().y));
-	status_msg.setPosition(0, settings->get_window_size().y);	// move the bottom left of the word to the bottom of the window
-}
-
-inline StartScreen::~StartScreen() {}	// virtual destructor
-
-inline void StartScreen::update() {}
-
-inline void StartScreen::update_physics() {}
-
-// draw every Start Screen Element on the window
-inline void StartScreen::draw_on_window(sf::RenderWindow& window)
-{
-	window.draw(status_msg);
-	window.draw(game_title);
-	start_btn.draw_on_window(window);
-	options_btn.draw_on_window(window);
-	exit_btn.draw_on_window(window);
-}
-
-inline void StartScreen::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt) {}
-
-// implement the functionality of the Buttons
-inline void StartScreen::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt)
-{
-	start_btn.mouse_clicked_processor(pressed_mouse_evnt);
-	if (start_btn.is_button_pressed())
-	{
-		settings->game_state = GameSettings::PLAY_SCREEN;
-		start_btn.button_pressed_reset();
-	}
-	options_btn.mouse_clicked_processor(pressed_mouse_evnt);
-	if (options_btn.is_button_pressed())
-	{
-		settings->game_state = GameSettings::OPTIONS_SCREEN;
-		options_btn.button_pressed_reset();
-	}
-	exit_btn.mouse_clicked_processor(pressed_mouse_evnt);
-	if (exit_btn.is_button_pressed())
-	{
-		settings->game_state = GameSettings::EXIT;
-		exit_btn.button_pressed_reset();
-	}
-}
+#include "StartScreen.h"
+
+// Constructor
+StartScreen::StartScreen(GameSettings& game_settings)
+	// member initializer list. Initialize the Buttons
+	: start_btn("START >", game_settings.getFont(), 40), exit_btn("< EXIT", game_settings.getFont(), 40), options_btn("OPTIONS", game_settings.getFont(), 40),
+	stats_btn("STATISTICS", game_settings.getFont(), 40)
+{
+	settings = &game_settings;	// save the Address of game_settings in a pointer
+	screen_layer.create((unsigned int)settings->get_window_size().x, (unsigned int)settings->get_window_size().y);
+
+	// set up Game title text
+	game_title.setString("Typing Game");
+	game_title.setFont(settings->getFont());
+	game_title.setCharacterSize(40);
+	game_title.setStyle(sf::Text::Bold);
+	game_title.setLetterSpacing(1.5);
+	game_title.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (game_title.getGlobalBounds().width / 2), 80.f));
+
+	// set up the position of the buttons
+	float button_spacing = 120;		// in pixel. vertical spacing between every Button (from middle to middle)
+	start_btn.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (start_btn.getSize().x / 2),
+		(settings->get_window_size().y / 2) - (1.5f * button_spacing + (start_btn.getSize().y / 2))));
+	options_btn.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (options_btn.getSize().x / 2),
+		(settings->get_window_size().y / 2) - (0.5f * button_spacing + (options_btn.getSize().y / 2))));
+	stats_btn.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (stats_btn.getSize().x / 2),
+		(settings->get_window_size().y / 2) + 0.5f * button_spacing - (stats_btn.getSize().y / 2)));
+	exit_btn.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (exit_btn.getSize().x / 2),
+		(settings->get_window_size().y / 2) + 1.5f * button_spacing - (exit_btn.getSize().y / 2)));
+	start_btn.set_enabled(settings->is_playable());		// a round can only be started when the textures and the word list are loaded
+
+	// set up the status message
+	status_msg.setFont(settings->getFont());
+	status_msg.setCharacterSize(30);
+	status_msg.setStyle(sf::Text::Bold);
+	status_msg.setLetterSpacing(1.5);
+	switch (settings->file_state)
+	{
+	case GameSettings::CREATE_NEW:
+		set_status_msg("Creating new settings file.");
+		settings->file_state = GameSettings::GOOD;			// set the file state to good after the query
+		break;
+	case GameSettings::MIGRATED:
+		set_status_msg("Settings file converted to the new format.");
+		settings->file_state = GameSettings::GOOD;			// set the file state to good after the query
+		break;
+	case GameSettings::CREATE_NEW_FAIL:
+		set_status_msg("No settings file can be created, saving not possible!");
+		break;
+	default:
+		set_status_msg("");
+		break;
+	}
+	std::string word_list_msg;
+	if (settings->get_word_list_watcher().get_status_msg(word_list_msg))	// the word list was reloaded (or couldn't be reloaded) since the last query
+		set_status_msg(word_list_msg);
+	status_msg.setPosition(0, settings->get_window_size().y);	// move the bottom left of the word to the bottom of the window
+}
+
+inline StartScreen::~StartScreen() {}	// virtual destructor
+
+// show a warning if the settings or the Hi-Score couldn't be saved, or the result of a reload of the word list.
+// enable the START Button when the assets of the Playfield are loaded
+inline void StartScreen::update()
+{
+	if (start_btn.is_enabled() != settings->is_playable())
+	{
+		start_btn.set_enabled(settings->is_playable());
+		screen_layer.invalidate();
+	}
+
+	std::string word_list_msg;
+	if (settings->has_save_failed())
+		set_status_msg("Settings can't be saved!");
+	else if (settings->get_word_list_watcher().get_status_msg(word_list_msg))
+		set_status_msg(word_list_msg);
+}
+
+inline void StartScreen::update_physics() {}
+
+// draw every Start Screen Element on the window. the screen is cached in a RenderLayer and only drawn again when something changed
+inline void StartScreen::draw_on_window(DrawCommandBuffer& target)
+{
+	if (start_btn.update_hover(target) | options_btn.update_hover(target) | stats_btn.update_hover(target) | exit_btn.update_hover(target))	// no short circuit, every Button must be updated
+		screen_layer.invalidate();
+
+	if (screen_layer.needs_redraw())
+	{
+		DrawCommandBuffer& layer_target = screen_layer.begin(target);
+		layer_target.draw(status_msg);
+		layer_target.draw(game_title);
+		layer_target.draw_entity(start_btn);
+		layer_target.draw_entity(options_btn);
+		layer_target.draw_entity(stats_btn);
+		layer_target.draw_entity(exit_btn);
+		screen_layer.end();
+	}
+	screen_layer.draw_on_window(target);
+}
+
+inline void StartScreen::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt) {}
+
+// implement the functionality of the Buttons
+inline void StartScreen::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt)
+{
+	start_btn.mouse_clicked_processor(pressed_mouse_evnt);
+	if (start_btn.is_button_pressed())
+	{
+		settings->game_state = GameSettings::PLAY_SCREEN;
+		start_btn.button_pressed_reset();
+	}
+	options_btn.mouse_clicked_processor(pressed_mouse_evnt);
+	if (options_btn.is_button_pressed())
+	{
+		settings->game_state = GameSettings::OPTIONS_SCREEN;
+		options_btn.button_pressed_reset();
+	}
+	stats_btn.mouse_clicked_processor(pressed_mouse_evnt);
+	if (stats_btn.is_button_pressed())
+	{
+		settings->game_state = GameSettings::STATS_SCREEN;
+		stats_btn.button_pressed_reset();
+	}
+	exit_btn.mouse_clicked_processor(pressed_mouse_evnt);
+	if (exit_btn.is_button_pressed())
+	{
+		settings->game_state = GameSettings::EXIT;
+		exit_btn.button_pressed_reset();
+	}
+}
+
+// the START Button is enabled without an input event when the assets are loaded. until then the screen is updated in every frame
+inline bool StartScreen::is_animating()
+{
+	if (!start_btn.is_enabled())
+		return true;
+	// a status message of a background thread (save failed or word list reloaded) must be shown without waiting for an input event
+	if (settings->has_save_failed())
+		return status_msg.getString() != "Settings can't be saved!";
+	return settings->get_word_list_watcher().has_status_msg();
+}
+
+// name of the Entity type for the CountingRenderBackend
+inline const char* StartScreen::get_entity_name()
+{
+	return "StartScreen";
+}
+
+// change the status message. the bottom left of the message stays at the bottom left of the window
+// msg: input. the new message
+void StartScreen::set_status_msg(const sf::String& msg)
+{
+	status_msg.setString(msg);
+	FontManager::warm_text(status_msg);		// the message can contain characters that are not warmed (e.g. from the path of the word list)
+	screen_layer.invalidate();
+	// set Origin of Text to be on the bottom left of the word
+	sf::FloatRect bounds = status_msg.getLocalBounds();
+	status_msg.setOrigin(0, bounds.top + bounds.height);
+}
@@ -0,0 +1,167 @@
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include "StatsScreen.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Constructor. set up the content of the Stats Screen and start the calculation of the statistics in the background
+StatsScreen::StatsScreen(GameSettings& game_settings) : back_btn("< back", game_settings.getFont(), 40)	// member initializer list: back_btn
+{
+	settings = &game_settings;	// save the Address of game_settings in a pointer
+	query_done = false;
+	stats_shown = false;
+
+	title.setString("Statistics");
+	title.setFont(settings->getFont());
+	title.setCharacterSize(40);
+	title.setStyle(sf::Text::Bold);
+	title.setLetterSpacing(1.5);
+	title.setPosition(sf::Vector2f((settings->get_window_size().x / 2) - (title.getGlobalBounds().width / 2), 20.f));
+
+	// the lists are shown in 3 columns
+	float column_width = settings->get_window_size().x / NUM_TEXTS;
+	for (unsigned int i = 0; i < NUM_TEXTS; i++)
+	{
+		stats_text[i].setString("loading...");
+		stats_text[i].setFont(settings->getFont());
+		stats_text[i].setCharacterSize(24);
+		stats_text[i].setLetterSpacing(1.5);
+		stats_text[i].setPosition(column_width * i + 40.f, 140.f);
+	}
+
+	back_btn.setPosition(sf::Vector2f(20.f, 20.f));
+
+	query_thread = thread(&StatsScreen::query_task, this);
+}
+
+// virtual destructor. waits until the queries are finished
+inline StatsScreen::~StatsScreen()
+{
+	if (query_thread.joinable())
+		query_thread.join();
+}
+
+// runs in the query thread. read the statistics from the keystroke file
+void StatsScreen::query_task()
+{
+	TRACE_THREAD_NAME("stats query");
+	KeystrokeRecorder& recorder = settings->get_keystroke_recorder();
+	recorder.get_letter_stats(letter_stats);
+	recorder.get_bigram_stats(bigram_stats);
+	recorder.get_wpm_over_time(wpm_points);
+	query_done = true;
+}
+
+// list the letters with the highest error rate
+void StatsScreen::init_letter_text()
+{
+	ostringstream text;
+	text << fixed << setprecision(1) << "Most errors\n\n";
+
+	if (letter_stats.empty())
+		text << "no keystrokes yet";
+	for (unsigned int i = 0; i < letter_stats.size() && i < NUM_LIST_ENTRIES; i++)
+	{
+		string letter = (letter_stats[i].letter == ' ') ? "space" : string(1, letter_stats[i].letter);
+		text << letter << "   " << 100.f * letter_stats[i].num_errors / letter_stats[i].num_keys << "%  (" << letter_stats[i].num_keys << ")\n";
+	}
+	stats_text[LETTER_TXT].setString(text.str());
+}
+
+// list the pairs of letters that take the longest time to type
+void StatsScreen::init_bigram_text()
+{
+	ostringstream text;
+	text << fixed << setprecision(0) << "Slowest letter pairs\n\n";
+
+	unsigned int num_lines = 0;
+	for (unsigned int i = 0; i < bigram_stats.size() && num_lines < NUM_LIST_ENTRIES; i++)
+	{
+		if (bigram_stats[i].num_keys < MIN_BIGRAM_KEYS)
+			continue;
+		text << bigram_stats[i].first << bigram_stats[i].second << "   " << bigram_stats[i].mean_latency_ms << " ms  (" << bigram_stats[i].num_keys << ")\n";
+		num_lines++;
+	}
+	if (num_lines == 0)
+		text << "not enough keystrokes yet";
+	stats_text[BIGRAM_TXT].setString(text.str());
+}
+
+// list the average typing speed of the last days
+void StatsScreen::init_wpm_text()
+{
+	map<unsigned int, pair<double, unsigned int> > days;	// key: day (yyyymmdd). value: sum of wpm * keystrokes and the number of keystrokes
+	ostringstream text;
+	text << fixed << setprecision(1) << "Words per minute\n\n";
+
+	for (unsigned int i = 0; i < wpm_points.size(); i++)
+	{
+		pair<double, unsigned int>& day = days[ScoreHistory::get_day(wpm_points[i].timestamp)];
+		day.first += (double)wpm_points[i].wpm * wpm_points[i].num_keys;	// weight every round by its number of keystrokes
+		day.second += wpm_points[i].num_keys;
+	}
+
+	if (days.empty())
+		text << "no keystrokes yet";
+	// show the last days. the map is sorted by day
+	map<unsigned int, pair<double, unsigned int> >::iterator day_it = days.begin();
+	if (days.size() > NUM_LIST_ENTRIES)
+		advance(day_it, days.size() - NUM_LIST_ENTRIES);
+	for (; day_it != days.end(); day_it++)
+	{
+		unsigned int day = day_it->first;
+		text << day % 100 << "." << day / 100 % 100 << "." << day / 10000 << "   " << day_it->second.first / day_it->second.second << "\n";
+	}
+	stats_text[WPM_TXT].setString(text.str());
+}
+
+// show the statistics when the query thread is finished
+inline void StatsScreen::update()
+{
+	if (stats_shown || !query_done)
+		return;
+
+	query_thread.join();
+	init_letter_text();
+	init_bigram_text();
+	init_wpm_text();
+	stats_shown = true;
+}
+
+inline void StatsScreen::update_physics() {}
+
+// draw every button and text on the screen
+inline void StatsScreen::draw_on_window(DrawCommandBuffer& target)
+{
+	target.draw_entity(back_btn);
+	target.draw(title);
+	for (unsigned int i = 0; i < NUM_TEXTS; i++)
+		target.draw(stats_text[i]);
+}
+
+inline void StatsScreen::key_pressed_processor(const sf::Event::KeyEvent& pressed_key_evnt) {}
+
+// back Button: go back to the Start Screen
+inline void StatsScreen::mouse_clicked_processor(const sf::Event::MouseButtonEvent& pressed_mouse_evnt)
+{
+	back_btn.mouse_clicked_processor(pressed_mouse_evnt);
+	if (back_btn.is_button_pressed())
+	{
+		settings->game_state = GameSettings::START_SCREEN;
+		back_btn.button_pressed_reset();
+	}
+}
+
+// the screen changes when the results of the query thread are shown
+inline bool StatsScreen::is_animating()
+{
+	return !stats_shown;
+}
+
+// name of the Entity type for the CountingRenderBackend
+inline const char* StatsScreen::get_entity_name()
+{
+	return "StatsScreen";
+}
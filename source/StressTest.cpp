@@ -0,0 +1,549 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+#include "StressTest.h"
+#include "HeadlessSim.h"
+#include "GameClock.h"
+#include "Playfield.h"
+#include "RenderBackend.h"
+
+using namespace std;
+
+// subsystems that are analyzed in the scaling curve
+enum subsystem_id
+{
+	RENDERING = 0,		// draw_on_window() of the Playfield
+	COLLISION,			// update_physics() of the Playfield (word reflection and movement)
+	INPUT_MATCHING,		// key_pressed_processor() of the Playfield
+	SPAWNING,			// creation and placement of new words in update() of the Playfield
+	NUM_SUBSYSTEMS
+};
+
+static const char* subsystem_names[NUM_SUBSYSTEMS] = { "rendering", "collision", "input_matching", "spawning" };
+
+// a subsystem stops scaling linearly at the first step where its cost per word is more than this factor above the lowest cost per word of the previous steps
+static const double SCALING_TOLERANCE = 2.0;
+// steps where a subsystem takes less time than this are not used in the analysis, because the cost is dominated by the resolution of the clock. in milliseconds
+static const double MIN_MEASURABLE_MS = 0.05;
+
+// measurements of one step of the stress test
+typedef struct step_result
+{
+	unsigned int num_words;			// number of words on the playfield in this step
+	unsigned long long ticks;		// number of measured ticks (without the tick that fills the playfield)
+	double avg_live_words;			// average number of words on the playfield during the step
+	double frame_ms_avg;			// main thread work of one tick (input + update + draw). in milliseconds
+	double frame_ms_max;
+	double update_ms_avg;			// update() of the Playfield. in milliseconds
+	double physics_ms_avg;			// update_physics() of the Playfield. in milliseconds
+	double physics_ms_max;
+	double draw_ms_avg;				// draw_on_window() of the Playfield. in milliseconds. -1 if not drawn
+	unsigned int keys;				// number of processed key events
+	double input_ms_avg;			// key_pressed_processor() of the Playfield per key event. in milliseconds. -1 if no key was pressed
+	double fill_ms;					// update() that spawned all words of the step. in milliseconds
+	double spawn_us_per_word;		// fill_ms per spawned word. in microseconds
+	unsigned long long respawned_words;	// words that were spawned during the step to replace typed or missed words
+	double respawn_rate;			// respawned words per simulated second
+	double memory_mb;				// resident memory of the process at the end of the step. in megabytes. 0 if unknown
+	double wall_seconds;			// real time that was needed for the step
+	double draw_calls_avg;			// draw calls per tick (see CountingRenderBackend). -1 if not drawn
+	double vertices_avg;			// vertices per tick. -1 if not drawn
+	double texture_binds_avg;		// texture binds per tick. -1 if not drawn
+	double state_changes_avg;		// state changes per tick. -1 if not drawn
+} step_result_t;
+
+// result of the scaling analysis of one subsystem
+typedef struct scaling_result
+{
+	vector<double> cost_per_word;	// cost per word at every step. in microseconds. negative if not measured
+	int linear_until;				// index of the last step up to which the subsystem scales linearly. -1 if it couldn't be measured at any step
+	int first_superlinear;			// index of the first step that is not linear anymore. -1 if the subsystem scales linearly over all steps
+} scaling_result_t;
+
+// returns the resident memory (working set) of the process
+// return: in bytes. 0 if it can't be determined on this platform
+static size_t get_resident_memory()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.WorkingSetSize;
+	return 0;
+#elif defined(__linux__)
+	// the second value in statm is the number of resident pages
+	ifstream fin("/proc/self/statm");
+	size_t total_pages = 0, resident_pages = 0;
+	if (!(fin >> total_pages >> resident_pages))
+		return 0;
+	return resident_pages * (size_t)sysconf(_SC_PAGESIZE);
+#else
+	return 0;
+#endif
+}
+
+// print the command line options of the stress test
+static void print_stress_usage()
+{
+	cout << "usage: typing_game --stress [options]" << endl;
+	cout << "  --min-words <n>       number of words of the first step (default 10)" << endl;
+	cout << "  --max-words <n>       number of words of the last step (default 100000)" << endl;
+	cout << "  --step-seconds <s>    simulated time every step is held, at most 60 (default 2)" << endl;
+	cout << "  --tick-ms <t>         simulated time step in milliseconds (default 10)" << endl;
+	cout << "  --wpm <n>             typing speed of the bot in words per minute (default 60)" << endl;
+	cout << "  --boundary rect|circ  playfield boundary (default: from the settings file)" << endl;
+	cout << "  --seed <n>            seed for the random numbers (default 1)" << endl;
+	cout << "  --no-draw             don't measure the rendering" << endl;
+	cout << "  --csv <file>          write the scaling curve to a CSV file (default stress_report.csv)" << endl;
+	cout << "  --report <file>       also write the scaling curve and the analysis to a JSON file" << endl;
+	cout << "  --capture <file>      capture the drawn frames into a Y4M video (*.y4m) or PNG files with this prefix" << endl;
+	cout << "  --capture-fps <n>     frame rate of the capture in simulated time (default 30)" << endl;
+}
+
+// parse the command line arguments of the stress test. The stress test is selected with the argument "--stress"
+// argc, argv: input. command line arguments of main()
+// config: output. configuration of the stress test. boundary_id is -1 if not given
+// return: 1 if the stress test was selected. 0 if not. -1 if an argument is invalid
+int parse_stress_args(int argc, char* argv[], stress_config_t& config)
+{
+	bool stress = false;
+
+	config.min_words = 10;
+	config.max_words = 100000;
+	config.step_seconds = 2;
+	config.tick_ms = 10;
+	config.words_per_minute = 60;
+	config.boundary_id = -1;
+	config.seed = 1;
+	config.draw = true;
+	config.csv_filename = "stress_report.csv";
+	config.report_filename = "";
+	if (FrameCapture::parse_args(argc, argv, config.capture) < 0)
+		return -1;
+
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		bool has_value = (i + 1 < argc);	// if there is an argument after the current one
+
+		if (arg == "--stress")
+			stress = true;
+		else if (arg == "--min-words" && has_value)
+			config.min_words = (unsigned int)atoi(argv[++i]);
+		else if (arg == "--max-words" && has_value)
+			config.max_words = (unsigned int)atoi(argv[++i]);
+		else if (arg == "--step-seconds" && has_value)
+			config.step_seconds = (float)atof(argv[++i]);
+		else if (arg == "--tick-ms" && has_value)
+			config.tick_ms = (float)atof(argv[++i]);
+		else if (arg == "--wpm" && has_value)
+			config.words_per_minute = (float)atof(argv[++i]);
+		else if (arg == "--boundary" && has_value)
+		{
+			string bound = argv[++i];
+			if (bound == "rect")
+				config.boundary_id = GameSettings::RECT;
+			else if (bound == "circ")
+				config.boundary_id = GameSettings::CIRC;
+			else
+			{
+				print_stress_usage();
+				return -1;
+			}
+		}
+		else if (arg == "--seed" && has_value)
+			config.seed = (unsigned int)atoi(argv[++i]);
+		else if (arg == "--no-draw")
+			config.draw = false;
+		else if (arg == "--csv" && has_value)
+			config.csv_filename = argv[++i];
+		else if (arg == "--report" && has_value)
+			config.report_filename = argv[++i];
+		else if (FrameCapture::is_capture_arg(arg) && has_value)
+			i++;	// parsed by FrameCapture::parse_args()
+		else if (stress)
+		{
+			print_stress_usage();
+			return -1;
+		}
+	}
+
+	if (!stress)
+		return 0;
+
+	// the playtime of a round is 90 seconds and every step is played in a new round, so a step must be shorter than that
+	if (config.min_words < GameSettings::MIN_NUM_WORDS || config.max_words < config.min_words || config.step_seconds <= 0 || config.step_seconds > 60 ||
+		config.tick_ms <= 0 || config.words_per_minute <= 0)
+	{
+		print_stress_usage();
+		return -1;
+	}
+	return 1;
+}
+
+// get the number of words of every step. the steps follow a 1-3-10 sequence (10, 30, 100, 300, ...) between the first and the last step
+// config: input. configuration of the stress test
+// return: number of words of every step in ascending order
+static vector<unsigned int> get_word_steps(const stress_config_t& config)
+{
+	vector<unsigned int> steps;
+	steps.push_back(config.min_words);
+	for (unsigned long long decade = 1; decade < config.max_words; decade *= 10)
+	{
+		unsigned long long candidates[2] = { decade, 3 * decade };
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			if (candidates[i] > config.min_words && candidates[i] < config.max_words)
+				steps.push_back((unsigned int)candidates[i]);
+		}
+	}
+	if (config.max_words > config.min_words)
+		steps.push_back(config.max_words);
+	return steps;
+}
+
+// run all steps of the stress test on a Playfield with the boundary type T
+// settings: input. game settings to create the Playfield
+// config: input. configuration of the stress test
+// results: output. measurements of every step
+template <typename T>
+static void stress_playfield(GameSettings& settings, const stress_config_t& config, vector<step_result_t>& results)
+{
+	Playfield<T> playfield(settings);
+	TypistBot bot(config.words_per_minute, 0);
+	sf::Time tick = sf::microseconds((sf::Int64)(config.tick_ms * 1000));
+	sf::Time step_duration = sf::seconds(config.step_seconds);
+	sf::Event::KeyEvent key_evnt;
+	sf::Clock stage_clock;		// measures the duration of one stage of a tick
+
+	// the rendering is measured by drawing into an offscreen texture of the size of the window.
+	// the draw calls are counted in every tick, also if there is no OpenGL for the render texture
+	sf::Vector2u target_size((unsigned int)settings.get_window_size().x, (unsigned int)settings.get_window_size().y);
+	TextureRenderBackend render_backend;
+	CountingRenderBackend counting_backend;
+	bool draw = config.draw && render_backend.create(target_size.x, target_size.y);
+	DrawCommandBuffer commands(target_size);	// the draw commands are recorded and replayed in the same thread
+	if (config.draw && !draw)
+		cout << "render texture can't be created. only the draw calls are counted" << endl;
+
+	// the capture reads the frames from the render texture. it is not part of the measured time
+	FrameCapture frame_capture;
+	if (!config.capture.path.empty() && (!draw || frame_capture.start(config.capture, target_size.x, target_size.y) < 0))
+		cout << "the frames can't be captured into " << config.capture.path << endl;
+
+	vector<unsigned int> steps = get_word_steps(config);
+	for (size_t step = 0; step < steps.size(); step++)
+	{
+		step_result_t result = {};
+		double frame_ms_sum = 0, update_ms_sum = 0, physics_ms_sum = 0, draw_ms_sum = 0, input_ms_sum = 0, live_words_sum = 0;
+		sf::Clock wall_clock;
+
+		result.num_words = steps[step];
+		counting_backend.reset_stats();
+		cout << "step " << step + 1 << "/" << steps.size() << ": " << result.num_words << " words" << flush;
+
+		// start a new round with the number of words of this step. The first update() fills the playfield
+		playfield.restart();
+		settings.setNumWordsSpawn(result.num_words);
+		GameClock::advance_simulated_time(tick);
+		stage_clock.restart();
+		playfield.update();
+		result.fill_ms = stage_clock.getElapsedTime().asMicroseconds() / 1000.0;
+		result.spawn_us_per_word = result.fill_ms * 1000 / result.num_words;
+		playfield.update_physics();
+
+		sf::Time step_start = GameClock::now();
+		while (GameClock::now() - step_start < step_duration && playfield.is_game_running())
+		{
+			GameClock::advance_simulated_time(tick);
+			unsigned int removed_before = playfield.get_typed_words() + playfield.get_missed_words();
+			size_t words_before = playfield.get_word_list().size();
+			double frame_ms = 0;
+
+			// input matching. only the Playfield is measured, not the bot that chooses the key
+			while (bot.next_key(playfield.get_word_list(), GameClock::now(), key_evnt))
+			{
+				stage_clock.restart();
+				playfield.key_pressed_processor(key_evnt);
+				double input_ms = stage_clock.getElapsedTime().asMicroseconds() / 1000.0;
+				input_ms_sum += input_ms;
+				frame_ms += input_ms;
+				result.keys++;
+			}
+
+			stage_clock.restart();
+			playfield.update();
+			double update_ms = stage_clock.getElapsedTime().asMicroseconds() / 1000.0;
+			update_ms_sum += update_ms;
+			frame_ms += update_ms;
+
+			// words that were typed or missed in this tick were deleted and replaced by new words
+			unsigned int removed = playfield.get_typed_words() + playfield.get_missed_words() - removed_before;
+			result.respawned_words += playfield.get_word_list().size() + removed - words_before;
+
+			stage_clock.restart();
+			playfield.update_physics();
+			double physics_ms = stage_clock.getElapsedTime().asMicroseconds() / 1000.0;
+			physics_ms_sum += physics_ms;
+			if (physics_ms > result.physics_ms_max)
+				result.physics_ms_max = physics_ms;
+
+			if (config.draw)
+			{
+				stage_clock.restart();
+				commands.reset();
+				commands.clear();
+				commands.draw_entity(playfield);
+				if (draw)
+				{
+					commands.replay(render_backend);
+					render_backend.display();
+					double draw_ms = stage_clock.getElapsedTime().asMicroseconds() / 1000.0;
+					draw_ms_sum += draw_ms;
+					frame_ms += draw_ms;
+					frame_capture.capture_texture(render_backend.get_render_texture());
+				}
+				// counting is not part of the measured time
+				commands.replay(counting_backend);
+				counting_backend.display();
+			}
+
+			frame_ms_sum += frame_ms;
+			if (frame_ms > result.frame_ms_max)
+				result.frame_ms_max = frame_ms;
+			live_words_sum += playfield.get_word_list().size();
+			result.ticks++;
+		}
+
+		double ticks = result.ticks > 0 ? (double)result.ticks : 1;		// avoid a division by 0
+		result.avg_live_words = live_words_sum / ticks;
+		result.frame_ms_avg = frame_ms_sum / ticks;
+		result.update_ms_avg = update_ms_sum / ticks;
+		result.physics_ms_avg = physics_ms_sum / ticks;
+		result.draw_ms_avg = draw ? draw_ms_sum / ticks : -1;
+		result.input_ms_avg = result.keys > 0 ? input_ms_sum / result.keys : -1;
+		result.respawn_rate = result.respawned_words / (result.ticks * tick.asSeconds() > 0 ? result.ticks * tick.asSeconds() : 1);
+		result.memory_mb = get_resident_memory() / (1024.0 * 1024.0);
+		result.wall_seconds = wall_clock.getElapsedTime().asSeconds();
+		const CountingRenderBackend::render_stats_t& render_stats = counting_backend.get_total_stats();
+		double frames = (double)counting_backend.get_num_frames();
+		result.draw_calls_avg = frames > 0 ? render_stats.draw_calls / frames : -1;
+		result.vertices_avg = frames > 0 ? render_stats.vertices / frames : -1;
+		result.texture_binds_avg = frames > 0 ? render_stats.texture_binds / frames : -1;
+		result.state_changes_avg = frames > 0 ? render_stats.state_changes / frames : -1;
+		results.push_back(result);
+
+		cout << ", frame " << result.frame_ms_avg << " ms, physics " << result.physics_ms_avg << " ms, ";
+		if (frames > 0)
+			cout << result.draw_calls_avg << " draw calls, ";
+		cout << result.memory_mb << " MB (" << result.wall_seconds << " s)" << endl;
+	}
+
+	if (frame_capture.is_running())
+	{
+		frame_capture.stop();		// writes the remaining captured frames
+		cout << frame_capture.get_report() << endl;
+	}
+}
+
+// find the step where the cost per word of every subsystem starts to grow faster than linear
+// results: input. measurements of every step
+// scaling: output. analysis of every subsystem
+static void analyze_scaling(const vector<step_result_t>& results, scaling_result_t scaling[NUM_SUBSYSTEMS])
+{
+	for (unsigned int sub = 0; sub < NUM_SUBSYSTEMS; sub++)
+	{
+		double min_cost = -1;	// lowest cost per word of the steps so far
+		scaling[sub].linear_until = -1;
+		scaling[sub].first_superlinear = -1;
+		scaling[sub].cost_per_word.clear();
+
+		for (size_t step = 0; step < results.size(); step++)
+		{
+			const step_result_t& result = results[step];
+			double measured_ms = -1;	// measured duration of the subsystem. in milliseconds
+			switch (sub)
+			{
+			case RENDERING:
+				measured_ms = result.draw_ms_avg;
+				break;
+			case COLLISION:
+				measured_ms = result.physics_ms_avg;
+				break;
+			case INPUT_MATCHING:
+				measured_ms = result.input_ms_avg;
+				break;
+			case SPAWNING:
+				measured_ms = result.fill_ms;
+				break;
+			}
+			double cost = measured_ms >= 0 ? measured_ms * 1000 / result.num_words : -1;	// in microseconds per word
+			scaling[sub].cost_per_word.push_back(cost);
+
+			if (measured_ms < MIN_MEASURABLE_MS || scaling[sub].first_superlinear >= 0)
+				continue;
+			if (min_cost >= 0 && cost > SCALING_TOLERANCE * min_cost)
+			{
+				scaling[sub].first_superlinear = (int)step;
+				continue;
+			}
+			scaling[sub].linear_until = (int)step;
+			if (min_cost < 0 || cost < min_cost)
+				min_cost = cost;
+		}
+	}
+}
+
+// write the scaling curve to a CSV file. one line per step
+// filename: input. path of the CSV file
+// results: input. measurements of every step
+// return: -1 if the file can't be written. 0 if no error
+static int write_csv_report(const string& filename, const vector<step_result_t>& results)
+{
+	ofstream fout(filename);
+	if (!fout.good())	// check error state
+		return -1;
+
+	fout << "num_words,ticks,avg_live_words,frame_ms_avg,frame_ms_max,update_ms_avg,physics_ms_avg,physics_ms_max,draw_ms_avg,"
+		"keys,input_ms_avg,fill_ms,spawn_us_per_word,respawned_words,respawn_rate,memory_mb,wall_seconds,"
+		"draw_calls_avg,vertices_avg,texture_binds_avg,state_changes_avg\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const step_result_t& r = results[i];
+		fout << r.num_words << "," << r.ticks << "," << r.avg_live_words << "," << r.frame_ms_avg << "," << r.frame_ms_max << "," << r.update_ms_avg << ","
+			<< r.physics_ms_avg << "," << r.physics_ms_max << "," << r.draw_ms_avg << "," << r.keys << "," << r.input_ms_avg << "," << r.fill_ms << ","
+			<< r.spawn_us_per_word << "," << r.respawned_words << "," << r.respawn_rate << "," << r.memory_mb << "," << r.wall_seconds << ","
+			<< r.draw_calls_avg << "," << r.vertices_avg << "," << r.texture_binds_avg << "," << r.state_changes_avg << "\n";
+	}
+
+	return fout.good() ? 0 : -1;
+}
+
+// write the scaling curve and the scaling analysis to a JSON file
+// filename: input. path of the report file
+// config: input. configuration of the stress test
+// results: input. measurements of every step
+// scaling: input. analysis of every subsystem
+// return: -1 if the file can't be written. 0 if no error
+static int write_json_report(const string& filename, const stress_config_t& config, const vector<step_result_t>& results,
+	const scaling_result_t scaling[NUM_SUBSYSTEMS])
+{
+	ofstream fout(filename);
+	if (!fout.good())	// check error state
+		return -1;
+
+	fout << "{\n";
+	fout << "  \"config\": {\"min_words\": " << config.min_words << ", \"max_words\": " << config.max_words << ", \"step_seconds\": " << config.step_seconds
+		<< ", \"tick_ms\": " << config.tick_ms << ", \"wpm\": " << config.words_per_minute << ", \"boundary_id\": " << config.boundary_id
+		<< ", \"seed\": " << config.seed << ", \"draw\": " << (config.draw ? "true" : "false") << "},\n";
+	fout << "  \"steps\": [\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const step_result_t& r = results[i];
+		fout << "    {\"num_words\": " << r.num_words << ", \"ticks\": " << r.ticks << ", \"avg_live_words\": " << r.avg_live_words
+			<< ", \"frame_ms_avg\": " << r.frame_ms_avg << ", \"frame_ms_max\": " << r.frame_ms_max << ", \"update_ms_avg\": " << r.update_ms_avg
+			<< ", \"physics_ms_avg\": " << r.physics_ms_avg << ", \"physics_ms_max\": " << r.physics_ms_max << ", \"draw_ms_avg\": " << r.draw_ms_avg
+			<< ", \"keys\": " << r.keys << ", \"input_ms_avg\": " << r.input_ms_avg << ", \"fill_ms\": " << r.fill_ms
+			<< ", \"spawn_us_per_word\": " << r.spawn_us_per_word << ", \"respawned_words\": " << r.respawned_words << ", \"respawn_rate\": " << r.respawn_rate
+			<< ", \"memory_mb\": " << r.memory_mb << ", \"wall_seconds\": " << r.wall_seconds << ", \"draw_calls_avg\": " << r.draw_calls_avg
+			<< ", \"vertices_avg\": " << r.vertices_avg << ", \"texture_binds_avg\": " << r.texture_binds_avg << ", \"state_changes_avg\": " << r.state_changes_avg << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	fout << "  ],\n";
+	fout << "  \"scaling_tolerance\": " << SCALING_TOLERANCE << ",\n";
+	fout << "  \"scaling\": {\n";
+	for (unsigned int sub = 0; sub < NUM_SUBSYSTEMS; sub++)
+	{
+		const scaling_result_t& s = scaling[sub];
+		fout << "    \"" << subsystem_names[sub] << "\": {\"cost_us_per_word\": [";
+		for (size_t i = 0; i < s.cost_per_word.size(); i++)
+		{
+			fout << (i ? ", " : "");
+			if (s.cost_per_word[i] < 0)
+				fout << "null";
+			else
+				fout << s.cost_per_word[i];
+		}
+		fout << "], \"linear_until_words\": ";
+		if (s.linear_until < 0)
+			fout << "null";
+		else
+			fout << results[s.linear_until].num_words;
+		fout << ", \"first_superlinear_words\": ";
+		if (s.first_superlinear < 0)
+			fout << "null";
+		else
+			fout << results[s.first_superlinear].num_words;
+		fout << "}" << (sub + 1 < NUM_SUBSYSTEMS ? "," : "") << "\n";
+	}
+	fout << "  }\n";
+	fout << "}\n";
+
+	return fout.good() ? 0 : -1;
+}
+
+// put more and more words on the Playfield and measure how the cost of rendering, collision, input matching and spawning grows with the number of words.
+// The time is simulated and the key events are generated by a TypistBot like in the headless simulation. Every step is played in a new round.
+// settings: input. game settings. the settings are changed according to the configuration, but not saved
+// config: input. configuration of the stress test
+// return: exit code for main(). 0 if no error
+int run_stress_test(GameSettings& settings, const stress_config_t& config)
+{
+	vector<step_result_t> results;
+	scaling_result_t scaling[NUM_SUBSYSTEMS];
+
+	settings.set_read_only(true);	// the number of words is above the limit of the settings file and the Hi-Score of the player must not be overwritten
+	settings.set_max_num_words(config.max_words);
+	if (config.boundary_id >= 0)
+		settings.setBoundaryID(config.boundary_id);
+	GameClock::set_simulated(true);	// must be set before any game object is created
+	srand(config.seed);
+
+	string bound_descr;
+	settings.getBoundaryID(&bound_descr);
+	cout << "stress test: " << config.min_words << " to " << config.max_words << " words, boundary " << bound_descr << ", "
+		<< config.step_seconds << " s per step, tick " << config.tick_ms << " ms" << endl;
+
+	switch (settings.getBoundaryID())
+	{
+	case GameSettings::RECT:
+		stress_playfield<sf::RectangleShape>(settings, config, results);
+		break;
+	case GameSettings::CIRC:
+		stress_playfield<sf::CircleShape>(settings, config, results);
+		break;
+	}
+
+	analyze_scaling(results, scaling);
+	for (unsigned int sub = 0; sub < NUM_SUBSYSTEMS; sub++)
+	{
+		cout << subsystem_names[sub] << ": ";
+		if (scaling[sub].linear_until < 0)
+			cout << "not measurable" << endl;
+		else if (scaling[sub].first_superlinear < 0)
+			cout << "linear up to " << results[scaling[sub].linear_until].num_words << " words" << endl;
+		else
+			cout << "linear up to " << results[scaling[sub].linear_until].num_words << " words, stops scaling linearly at "
+				<< results[scaling[sub].first_superlinear].num_words << " words" << endl;
+	}
+
+	if (!config.csv_filename.empty() && write_csv_report(config.csv_filename, results) < 0)
+	{
+		cout << "report file " << config.csv_filename << " can't be written" << endl;
+		return 1;
+	}
+	if (!config.report_filename.empty() && write_json_report(config.report_filename, config, results, scaling) < 0)
+	{
+		cout << "report file " << config.report_filename << " can't be written" << endl;
+		return 1;
+	}
+
+	return 0;
+}
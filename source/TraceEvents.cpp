@@ -0,0 +1,155 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "TraceEvents.h"
+
+using namespace std;
+
+// one recorded zone
+typedef struct trace_event
+{
+	const char* name;
+	sf::Int64 start_us;		// in microseconds since the start of the trace
+	sf::Int64 duration_us;	// in microseconds
+} trace_event_t;
+
+// part of the buffer of one thread. When a chunk is full, a new chunk is appended.
+// The recording thread is the only writer. The events are published with num_events, so the file can be written while the thread still records.
+struct trace_chunk
+{
+	enum chunk_size
+	{
+		CHUNK_SIZE = 16384		// number of events in one chunk
+	};
+
+	trace_event_t events[CHUNK_SIZE];
+	atomic<unsigned int> num_events;	// number of complete events in this chunk
+	atomic<trace_chunk*> next;			// next chunk or NULL if this is the last chunk
+
+	trace_chunk() : num_events(0), next(NULL) {}
+};
+
+// buffer of one thread. consists of a linked list of chunks
+struct trace_buffer
+{
+	unsigned int thread_id;				// ID of the thread in the trace file
+	atomic<const char*> thread_name;	// name of the thread in the trace file
+	trace_chunk first_chunk;
+	trace_chunk* last_chunk;			// chunk where the next event is stored. only used by the recording thread
+
+	trace_buffer(unsigned int id) : thread_id(id), thread_name("thread"), last_chunk(&first_chunk) {}
+	~trace_buffer()
+	{
+		trace_chunk* chunk = first_chunk.next;
+		while (chunk != NULL)
+		{
+			trace_chunk* chunk_tmp = chunk;
+			chunk = chunk->next;
+			delete chunk_tmp;
+		}
+	}
+};
+
+static mutex trace_buffers_mutex;						// protects the list of the buffers (not the buffers themselves)
+static vector<unique_ptr<trace_buffer>> trace_buffers;	// buffers of all threads that recorded a zone. are kept until the program exits
+static const chrono::steady_clock::time_point trace_start = chrono::steady_clock::now();
+
+// returns the time since the start of the trace. in microseconds
+static sf::Int64 trace_time_us()
+{
+	return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - trace_start).count();
+}
+
+// returns the buffer of the current thread. The buffer is created when a thread records its first zone
+static trace_buffer* get_thread_buffer()
+{
+	thread_local trace_buffer* buffer = NULL;
+
+	if (buffer == NULL)
+	{
+		lock_guard<mutex> lock(trace_buffers_mutex);
+		trace_buffers.push_back(unique_ptr<trace_buffer>(new trace_buffer((unsigned int)trace_buffers.size() + 1)));
+		buffer = trace_buffers.back().get();
+	}
+	return buffer;
+}
+
+// Constructor. starts the zone
+// zone_name: input. name of the zone. must be a string literal
+TraceZone::TraceZone(const char* zone_name)
+{
+	name = zone_name;
+	start_us = trace_time_us();
+}
+
+// Destructor. ends the zone and stores it in the buffer of the current thread
+TraceZone::~TraceZone()
+{
+	sf::Int64 end_us = trace_time_us();
+	trace_buffer* buffer = get_thread_buffer();
+	trace_chunk* chunk = buffer->last_chunk;
+	unsigned int index = chunk->num_events.load(memory_order_relaxed);
+
+	if (index == trace_chunk::CHUNK_SIZE)	// if the chunk is full, append a new one
+	{
+		trace_chunk* new_chunk = new trace_chunk;
+		chunk->next.store(new_chunk, memory_order_release);
+		buffer->last_chunk = new_chunk;
+		chunk = new_chunk;
+		index = 0;
+	}
+
+	chunk->events[index].name = name;
+	chunk->events[index].start_us = start_us;
+	chunk->events[index].duration_us = end_us - start_us;
+	chunk->num_events.store(index + 1, memory_order_release);	// publish the event
+}
+
+// set the name of the current thread in the trace
+// thread_name: input. name of the thread. must be a string literal
+void trace_set_thread_name(const char* thread_name)
+{
+	get_thread_buffer()->thread_name = thread_name;
+}
+
+// write all zones that were recorded so far by all threads to a file in the Chrome trace event format. the recording continues afterwards
+// filename: input. path of the trace file. an existing file is overwritten
+// return: -1 if the file can't be written. 0 if no error
+int trace_write_file(const string& filename)
+{
+	ofstream fout(filename);
+	if (!fout.good())	// check error state
+		return -1;
+
+	lock_guard<mutex> lock(trace_buffers_mutex);
+	bool first_event = true;
+
+	fout << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+	for (size_t i = 0; i < trace_buffers.size(); i++)
+	{
+		trace_buffer* buffer = trace_buffers[i].get();
+
+		// metadata event with the name of the thread
+		fout << (first_event ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->thread_id
+			<< ", \"args\": {\"name\": \"" << buffer->thread_name.load() << "\"}}";
+		first_event = false;
+
+		// complete events ("ph": "X") with start time and duration
+		for (trace_chunk* chunk = &buffer->first_chunk; chunk != NULL; chunk = chunk->next.load(memory_order_acquire))
+		{
+			unsigned int num_events = chunk->num_events.load(memory_order_acquire);
+			for (unsigned int j = 0; j < num_events; j++)
+			{
+				const trace_event_t& event = chunk->events[j];
+				fout << ",\n{\"name\": \"" << event.name << "\", \"cat\": \"typing_game\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->thread_id
+					<< ", \"ts\": " << event.start_us << ", \"dur\": " << event.duration_us << "}";
+			}
+		}
+	}
+	fout << "\n]}\n";
+
+	return fout.good() ? 0 : -1;
+}
@@ -0,0 +1,182 @@
+#include "WordIndex.h"
+#include "CSVParser.h"
+
+using namespace std;
+
+// average character cost (multiplied by 10) below which a word belongs to a tier. the words above the last limit belong to the hardest tier.
+// the limits split the english word list of the game into tiers of similar size
+static const unsigned int tier_limits[WordIndex::NUM_TIERS - 1] = { 11, 12, 13, 15 };
+
+// Constructor. the index is empty
+WordIndex::WordIndex()
+{
+	clear();
+}
+
+// remove all words and start building a new index
+void WordIndex::clear()
+{
+	bucket_start.assign(NUM_BUCKETS + 1, 0);
+	words.clear();
+	new_words.assign(NUM_BUCKETS, vector<unsigned int>());
+}
+
+// put a word into its bucket. the word can't be chosen until finish() is called
+// word: input. index of the word in the word list
+// letters: input. first character of the word
+// length: input. number of characters of the word. must be bigger than 0
+void WordIndex::add_word(unsigned int word, const char* letters, unsigned int length)
+{
+	new_words[get_bucket(get_tier(letters, length), get_letter_set(letters, length), length)].push_back(word);
+}
+
+// store the buckets one after another in one array. called after the last add_word()
+void WordIndex::finish()
+{
+	size_t num_words = words.size();
+	for (unsigned int bucket = 0; bucket < NUM_BUCKETS; bucket++)
+		num_words += new_words[bucket].size();
+	words.reserve(num_words);
+
+	for (unsigned int bucket = 0; bucket < NUM_BUCKETS; bucket++)
+	{
+		bucket_start[bucket] = (unsigned int)words.size();
+		words.insert(words.end(), new_words[bucket].begin(), new_words[bucket].end());
+	}
+	bucket_start[NUM_BUCKETS] = (unsigned int)words.size();
+	new_words.assign(NUM_BUCKETS, vector<unsigned int>());
+}
+
+// choose a random word with a length in a range and from a tier. If the tier has no word with this length, the nearest tier with such a word is taken
+// takes constant time (at most NUM_TIERS * NUM_LETTER_SETS ranges are checked)
+// min_length: input. minimum number of characters
+// max_length: input. maximum number of characters. lengths above MAX_LENGTH count as MAX_LENGTH
+// tier: input. preferred difficulty tier
+// letter_sets: input. bit mask of the allowed letter sets (see letter_set_mask)
+// return: index of the word in the word list. -1 if no word with this length exists in any tier
+int WordIndex::get_word(unsigned int min_length, unsigned int max_length, unsigned int tier, unsigned int letter_sets) const
+{
+	if (tier >= NUM_TIERS)
+		tier = NUM_TIERS - 1;
+
+	// try the tier first, then the tiers around it with growing distance
+	for (unsigned int distance = 0; distance < NUM_TIERS; distance++)
+	{
+		for (int direction = -1; direction <= 1; direction += 2)
+		{
+			int cur_tier = (int)tier + direction * (int)distance;
+			if (cur_tier < 0 || cur_tier >= NUM_TIERS || (distance == 0 && direction > 0))
+				continue;
+
+			unsigned int num = get_num_words(min_length, max_length, (unsigned int)cur_tier, letter_sets);
+			if (num == 0)
+				continue;
+
+			// the words of every letter set are a range in words. choose the range by its number of words
+			unsigned int rand_val = CSVParser::random_index(num);
+			for (unsigned int set = 0; set < NUM_LETTER_SETS; set++)
+			{
+				if ((letter_sets & (1u << set)) == 0)
+					continue;
+				unsigned int first;
+				unsigned int range_size = get_range(min_length, max_length, (unsigned int)cur_tier, set, first);
+				if (rand_val < range_size)
+					return (int)words[first + rand_val];
+				rand_val -= range_size;
+			}
+		}
+	}
+	return -1;
+}
+
+// returns the number of words with a length in a range, a tier and one of the letter sets
+unsigned int WordIndex::get_num_words(unsigned int min_length, unsigned int max_length, unsigned int tier, unsigned int letter_sets) const
+{
+	unsigned int num = 0;
+	unsigned int first;
+	for (unsigned int set = 0; set < NUM_LETTER_SETS; set++)
+	{
+		if ((letter_sets & (1u << set)) != 0)
+			num += get_range(min_length, max_length, tier, set, first);
+	}
+	return num;
+}
+
+// calculate the difficulty tier of a word from the average cost of its characters
+// letters: input. first character of the word
+// length: input. number of characters of the word
+// return: tier 0 ... NUM_TIERS - 1
+unsigned int WordIndex::get_tier(const char* letters, unsigned int length)
+{
+	unsigned int cost = 0;
+	for (unsigned int i = 0; i < length; i++)
+	{
+		char letter = letters[i];
+		if (letter >= 'a' && letter <= 'z')
+		{
+			switch (letter)
+			{
+			case 'e': case 't': case 'a': case 'o': case 'i': case 'n': case 's': case 'h': case 'r': case 'd': case 'l': case 'u':
+				cost += 10;		// the most common letters
+				break;
+			case 'j': case 'q': case 'x': case 'z':
+				cost += 30;		// the rarest letters
+				break;
+			default:
+				cost += 20;
+				break;
+			}
+		}
+		else if ((letter >= 'A' && letter <= 'Z') || (letter >= '0' && letter <= '9'))
+			cost += 30;		// needs the shift key or the number row
+		else
+			cost += 40;		// other characters
+	}
+	if (length == 0)
+		return 0;
+
+	unsigned int average_cost = cost / length;
+	unsigned int tier = 0;
+	while (tier < NUM_TIERS - 1 && average_cost >= tier_limits[tier])
+		tier++;
+	return tier;
+}
+
+// returns the letter set of a word (see letter_set)
+unsigned int WordIndex::get_letter_set(const char* letters, unsigned int length)
+{
+	unsigned int set = LOWER_CASE;
+	for (unsigned int i = 0; i < length; i++)
+	{
+		if (letters[i] >= 'A' && letters[i] <= 'Z')
+			set = MIXED_CASE;
+		else if (letters[i] < 'a' || letters[i] > 'z')
+			return SYMBOLS;
+	}
+	return set;
+}
+
+// returns the index of the bucket of a word
+unsigned int WordIndex::get_bucket(unsigned int tier, unsigned int letter_set, unsigned int length)
+{
+	if (length > MAX_LENGTH)
+		length = MAX_LENGTH;
+	if (length == 0)
+		length = 1;
+	return (tier * NUM_LETTER_SETS + letter_set) * MAX_LENGTH + (length - 1);
+}
+
+// get the range in words with all words of a tier and letter set with a length in a range
+// first: output. first word of the range
+// return: number of words in the range
+unsigned int WordIndex::get_range(unsigned int min_length, unsigned int max_length, unsigned int tier, unsigned int letter_set, unsigned int& first) const
+{
+	if (min_length < 1)
+		min_length = 1;
+	if (min_length > max_length)
+		return 0;
+	if (min_length > MAX_LENGTH)
+		min_length = MAX_LENGTH;
+	first = bucket_start[get_bucket(tier, letter_set, min_length)];
+	return bucket_start[get_bucket(tier, letter_set, max_length) + 1] - first;
+}
@@ -0,0 +1,226 @@
+#include <chrono>
+#include <filesystem>
+#include <set>
+#include "WordListWatcher.h"
+#include "TraceEvents.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// default Constructor. the word list is empty until load() is called
+WordListWatcher::WordListWatcher()
+{
+	csv_delimiter = ';';
+	csv_column = CSVTokenizer::ALL_COLUMNS;
+	snapshot = make_shared<const word_list_snapshot_t>();
+	new_status = false;
+	stop = false;
+}
+
+// Destructor. terminates the watch thread
+WordListWatcher::~WordListWatcher()
+{
+	stop = true;
+	if (watch_thread.joinable())
+		watch_thread.join();
+}
+
+// load the word list and start watching the file. the first load is done in the calling thread, so the word list is available after the call.
+// a malformed file is used anyway for the first load (see CSVTokenizer), because there is no previous word list
+// file_name: input. path of the csv file
+// delimiter: input. delimiter which separates the values in the file
+// column: input. column of the file with the words or CSVTokenizer::ALL_COLUMNS
+void WordListWatcher::load(const string& file_name, char delimiter, int column)
+{
+	stop = true;
+	if (watch_thread.joinable())
+		watch_thread.join();
+
+	csv_filename = file_name;
+	csv_delimiter = delimiter;
+	csv_column = column;
+	shared_ptr<word_list_snapshot_t> new_snapshot = read_snapshot();
+	if (!new_snapshot->words.get_error_msg().empty())
+		set_status_msg("Word list: " + new_snapshot->words.get_error_msg());
+	WordSampler::build_index(new_snapshot->words, new_snapshot->letter_index);
+	collect_glyphs(new_snapshot->words, new_snapshot->glyphs);
+	atomic_store(&snapshot, shared_ptr<const word_list_snapshot_t>(new_snapshot));
+
+	stop = false;
+	watch_thread = thread(&WordListWatcher::watch_task, this);
+}
+
+// returns the current word list with its indexes. the caller can use it as long as it keeps the shared_ptr, also if the file is reloaded in the meantime
+shared_ptr<const WordListWatcher::word_list_snapshot_t> WordListWatcher::get_snapshot() const
+{
+	return atomic_load(&snapshot);
+}
+
+// returns the words of the current word list. the returned shared_ptr keeps the whole snapshot alive (aliasing constructor)
+shared_ptr<const CSVParser> WordListWatcher::get_word_list() const
+{
+	shared_ptr<const word_list_snapshot_t> current_snapshot = get_snapshot();
+	return shared_ptr<const CSVParser>(current_snapshot, &current_snapshot->words);
+}
+
+// get the result of the last reload (or the error of the first load)
+// msg: output. the message. not changed if there is no new message
+// return: true if there is a message that was not queried yet
+bool WordListWatcher::get_status_msg(string& msg)
+{
+	lock_guard<mutex> lock(status_mutex);
+	if (!new_status)
+		return false;
+	msg = status_msg;
+	new_status = false;
+	return true;
+}
+
+// returns true if there is a message that was not queried yet with get_status_msg(). doesn't change the message
+bool WordListWatcher::has_status_msg()
+{
+	lock_guard<mutex> lock(status_mutex);
+	return new_status;
+}
+
+// In this task the file is watched until the WordListWatcher is destroyed or load() is called again. the file is reloaded after every change
+void WordListWatcher::watch_task()
+{
+	TRACE_THREAD_NAME("word list watcher");
+	filesystem::path file_path(csv_filename);
+	bool changed = false;								// a change was detected that is not reloaded yet
+	chrono::steady_clock::time_point last_change;		// time of the last detected change
+
+#ifdef __linux__
+	// watch the directory of the file. an editor that saves the file as a new file and renames it replaces the watched inode, so watching the file itself would stop working
+	int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	string dir_name = file_path.has_parent_path() ? file_path.parent_path().string() : ".";
+	if (inotify_fd < 0 || inotify_add_watch(inotify_fd, dir_name.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+	{
+		if (inotify_fd >= 0)
+			close(inotify_fd);
+		return;
+	}
+	string file_name = file_path.filename().string();
+	alignas(inotify_event) char event_buffer[4096];
+#else
+	error_code err;
+	filesystem::file_time_type last_write = filesystem::last_write_time(file_path, err);
+#endif
+
+	while (!stop)
+	{
+#ifdef __linux__
+		pollfd poll_fd = { inotify_fd, POLLIN, 0 };
+		if (poll(&poll_fd, 1, POLL_INTERVAL_MS) > 0)
+		{
+			ssize_t length;
+			while ((length = read(inotify_fd, event_buffer, sizeof(event_buffer))) > 0)
+			{
+				for (char* event_ptr = event_buffer; event_ptr < event_buffer + length; )
+				{
+					const inotify_event* event = (const inotify_event*)event_ptr;
+					if (event->len > 0 && file_name == event->name)
+					{
+						changed = true;
+						last_change = chrono::steady_clock::now();
+					}
+					event_ptr += sizeof(inotify_event) + event->len;
+				}
+			}
+		}
+#else
+		this_thread::sleep_for(chrono::milliseconds(POLL_INTERVAL_MS));
+		filesystem::file_time_type write_time = filesystem::last_write_time(file_path, err);
+		if (!err && write_time != last_write)
+		{
+			last_write = write_time;
+			changed = true;
+			last_change = chrono::steady_clock::now();
+		}
+#endif
+
+		if (changed && chrono::steady_clock::now() - last_change >= chrono::milliseconds(SETTLE_DELAY_MS))
+		{
+			changed = false;
+			reload();
+		}
+	}
+
+#ifdef __linux__
+	close(inotify_fd);
+#endif
+}
+
+// read the file again, build the indexes and publish the new word list. the previous word list stays active if the file can't be read, is malformed or empty
+void WordListWatcher::reload()
+{
+	TRACE_ZONE("WordListWatcher::reload");
+	shared_ptr<word_list_snapshot_t> new_snapshot = read_snapshot();
+	if (!new_snapshot->words.get_error_msg().empty())
+	{
+		set_status_msg("Word list not reloaded: " + new_snapshot->words.get_error_msg());
+		return;
+	}
+	if (new_snapshot->words.num_elem == 0)
+	{
+		set_status_msg("Word list not reloaded: " + csv_filename + " is empty");
+		return;
+	}
+
+	// the words of the letters and the characters are collected here, so the Playfields only swap the pointer during a round
+	WordSampler::build_index(new_snapshot->words, new_snapshot->letter_index);
+	collect_glyphs(new_snapshot->words, new_snapshot->glyphs);
+	atomic_store(&snapshot, shared_ptr<const word_list_snapshot_t>(new_snapshot));
+	set_status_msg("Word list reloaded (" + to_string(new_snapshot->words.num_elem) + " words).");
+}
+
+// read the word list file into a new snapshot. the indexes of the snapshot are not built yet
+shared_ptr<WordListWatcher::word_list_snapshot_t> WordListWatcher::read_snapshot()
+{
+	shared_ptr<word_list_snapshot_t> new_snapshot = make_shared<word_list_snapshot_t>();
+	new_snapshot->words = CSVParser(csv_filename, csv_delimiter, csv_column);
+	return new_snapshot;
+}
+
+// collect the characters of all words that are not printable ASCII. the words are converted like the Playfield converts them into a Word (sf::String with the current locale)
+// words: input. the word list
+// glyphs: output. every collected character once, in ascending order
+void WordListWatcher::collect_glyphs(const CSVParser& words, sf::String& glyphs)
+{
+	set<sf::Uint32> characters;
+	string word;
+	for (unsigned int i = 0; i < words.num_elem; i++)
+	{
+		words.get_elem(i, word);
+		bool ascii = true;
+		for (size_t j = 0; j < word.size() && ascii; j++)
+			ascii = word[j] >= ' ' && word[j] <= '~';
+		if (ascii)		// most words. no conversion needed
+			continue;
+
+		sf::String word_string(word);
+		for (size_t j = 0; j < word_string.getSize(); j++)
+		{
+			if (word_string[j] < ' ' || word_string[j] > '~')
+				characters.insert(word_string[j]);
+		}
+	}
+
+	glyphs.clear();
+	for (set<sf::Uint32>::const_iterator it = characters.begin(); it != characters.end(); it++)
+		glyphs += *it;
+}
+
+// store a new status message. replaces a message that was not queried yet
+void WordListWatcher::set_status_msg(const string& msg)
+{
+	lock_guard<mutex> lock(status_mutex);
+	status_msg = msg;
+	new_status = true;
+}
@@ -0,0 +1,278 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "WordSampler.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// values of the error rate and the target length
+static const float KEY_DECAY = 0.97f;			// weight of the older keystrokes of a letter with every new keystroke. about the last 30 keystrokes of a letter count
+static const float PRIOR_KEYS = 2.f;			// every letter starts with an error rate of PRIOR_ERRORS / PRIOR_KEYS, until enough keystrokes are recorded
+static const float PRIOR_ERRORS = 1.f;
+static const float MISSED_WORD_ERRORS = 0.5f;	// errors that are added to every letter of a missed word
+static const float LENGTH_STEP_TYPED = 0.2f;	// change of the target length after a typed word
+static const float LENGTH_STEP_MISSED = 1.f;	// change of the target length after a missed word
+
+// Constructor. no word list is set yet
+WordSampler::WordSampler()
+{
+	index = make_shared<const letter_index_t>();	// empty word list
+	target_length = 0;
+	for (unsigned int i = 0; i < NUM_LETTERS; i++)
+	{
+		letter_keys[i] = 0;
+		letter_errors[i] = 0;
+		letter_weights[i] = 0;
+		letter_tree[i + 1] = 0;
+	}
+	letter_tree[0] = 0;
+}
+
+// build the word lists of all letters and reset the error rates. the target length starts at the average word length
+// word_list: input. the words to choose from. get_word_index() returns an index of this list
+void WordSampler::init(const CSVParser& word_list)
+{
+	shared_ptr<letter_index_t> word_index = make_shared<letter_index_t>();
+	build_index(word_list, *word_index);
+	init(word_index);
+}
+
+// use the already built word lists of all letters and reset the error rates. the target length starts at the average word length
+// word_index: input. the words of the letters of the word list, see build_index(). get_word_index() returns an index of this word list
+void WordSampler::init(const shared_ptr<const letter_index_t>& word_index)
+{
+	*this = WordSampler();
+	index = word_index;
+	target_length = index->average_length;
+
+	// every letter that appears in a word starts with the prior error rate
+	for (unsigned int letter = 0; letter < NUM_LETTERS; letter++)
+		update_letter((unsigned char)letter, 0, 0);
+}
+
+// replace the word list, e.g. after the word list file was changed. the error rates of the letters and the target length are kept.
+// the words of the letters are already built (see WordListWatcher), so this only takes constant time and can be called during a round
+// word_index: input. the words of the letters of the new word list, see build_index(). get_word_index() returns an index of this word list
+void WordSampler::set_word_list(const shared_ptr<const letter_index_t>& word_index)
+{
+	bool had_words = (index->num_words > 0);
+	index = word_index;
+	for (unsigned int letter = 0; letter < NUM_LETTERS; letter++)
+	{
+		set_letter_weight((unsigned char)letter, 0);	// letters that are not in the new word list get no weight
+		update_letter((unsigned char)letter, 0, 0);		// only sets the weight of the letters of the new word list
+	}
+	if (!had_words)
+		target_length = index->average_length;
+	else if (index->num_words > 0)
+		target_length = (target_length < index->min_length) ? index->min_length : (target_length > index->max_length) ? index->max_length : target_length;
+}
+
+// choose a word from the word list. takes constant time
+// return: index of the word in the word list. 0 if the word list is empty
+unsigned int WordSampler::get_word_index()
+{
+	const letter_index_t& words = *index;
+	if (words.num_words == 0)
+		return 0;
+
+	unsigned int best_word = 0;
+	float best_acceptance = -1;
+	double total_weight = letter_tree[NUM_LETTERS];		// the last node of the Fenwick tree contains the sum of all weights (256 is a power of 2)
+	for (unsigned int i = 0; i < MAX_TRIES; i++)
+	{
+		unsigned int word;
+		int letter = -1;
+		if (total_weight > 0 && CSVParser::random_index(100) < ADAPTIVE_SHARE)
+			letter = find_letter(random_unit() * total_weight);
+
+		if (letter >= 0 && words.letter_word_start[letter + 1] > words.letter_word_start[letter])
+			word = words.letter_words[words.letter_word_start[letter] + CSVParser::random_index(words.letter_word_start[letter + 1] - words.letter_word_start[letter])];
+		else
+			word = CSVParser::random_index(words.num_words);
+
+		float acceptance = length_acceptance(words.word_lengths[word]);
+		if (random_unit() < acceptance)
+			return word;
+		if (acceptance > best_acceptance)	// if no word is accepted, the word with the best length is taken
+		{
+			best_acceptance = acceptance;
+			best_word = word;
+		}
+	}
+	return best_word;
+}
+
+// update the error rate of a letter with a keystroke
+// expected: input. the letter that should have been typed
+// correct: input. if the letter was typed
+void WordSampler::record_keystroke(char expected, bool correct)
+{
+	update_letter((unsigned char)expected, 1, correct ? 0.f : 1.f);
+}
+
+// a word was typed. increase the target length, if the word was not much shorter than the target length
+// length: input. length of the typed word
+void WordSampler::record_typed_word(unsigned int length)
+{
+	if ((float)length + 1 < target_length)
+		return;
+	target_length += LENGTH_STEP_TYPED;
+	if (target_length > index->max_length)
+		target_length = index->max_length;
+}
+
+// a word was missed. every letter of the word gets an error and the target length is decreased
+// word: input. the missed word
+void WordSampler::record_missed_word(const string& word)
+{
+	for (size_t i = 0; i < word.size(); i++)
+		update_letter((unsigned char)word[i], 0, MISSED_WORD_ERRORS);
+
+	target_length -= LENGTH_STEP_MISSED;
+	if (target_length < index->min_length)
+		target_length = index->min_length;
+}
+
+// returns the current error rate of a letter (including the prior error rate). 0...1
+float WordSampler::get_error_rate(char letter)
+{
+	unsigned char index = (unsigned char)letter;
+	return (letter_errors[index] + PRIOR_ERRORS) / (letter_keys[index] + PRIOR_KEYS);
+}
+
+// returns the preferred word length
+float WordSampler::get_target_length()
+{
+	return target_length;
+}
+
+// build the word lists of all letters and the lengths of the words. takes linear time in the size of the word list, so it is done once per word list
+// word_list: input. the words
+// word_index: output. the words of every letter
+void WordSampler::build_index(const CSVParser& word_list, letter_index_t& word_index)
+{
+	TRACE_ZONE("WordSampler::build_index");
+	word_index = letter_index_t();
+	word_index.num_words = word_list.num_elem;
+	if (word_index.num_words == 0)
+		return;
+
+	// count the words of every letter, then store the words in the same order (counting sort)
+	bool letter_seen[NUM_LETTERS];
+	vector<unsigned int> letter_count(NUM_LETTERS + 1, 0);
+	double length_sum = 0;
+	word_index.word_lengths.resize(word_index.num_words);
+	string word_string;
+	word_list.get_elem(0, word_string);
+	word_index.min_length = (float)word_string.size();
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (unsigned int word = 0; word < word_index.num_words; word++)
+		{
+			word_list.get_elem(word, word_string);
+			const unsigned char* letters = (const unsigned char*)word_string.data();
+			unsigned int length = (unsigned int)word_string.size();
+			memset(letter_seen, 0, sizeof(letter_seen));
+			for (unsigned int i = 0; i < length; i++)
+			{
+				if (letter_seen[letters[i]])
+					continue;
+				letter_seen[letters[i]] = true;
+				if (pass == 0)
+					letter_count[letters[i]]++;
+				else
+					word_index.letter_words[word_index.letter_word_start[letters[i]] + letter_count[letters[i]]++] = word;
+			}
+
+			if (pass == 0)
+			{
+				word_index.word_lengths[word] = (unsigned char)(length > 255 ? 255 : length);
+				length_sum += length;
+				if (length < word_index.min_length)
+					word_index.min_length = (float)length;
+				if (length > word_index.max_length)
+					word_index.max_length = (float)length;
+			}
+		}
+
+		if (pass == 0)
+		{
+			word_index.letter_word_start.resize(NUM_LETTERS + 1);
+			word_index.letter_word_start[0] = 0;
+			for (unsigned int letter = 0; letter < NUM_LETTERS; letter++)
+				word_index.letter_word_start[letter + 1] = word_index.letter_word_start[letter] + letter_count[letter];
+			word_index.letter_words.resize(word_index.letter_word_start[NUM_LETTERS]);
+			letter_count.assign(NUM_LETTERS + 1, 0);	// used as fill position in the second pass
+		}
+	}
+
+	if (word_index.max_length > 255)
+		word_index.max_length = 255;
+	word_index.average_length = (float)(length_sum / word_index.num_words);
+}
+
+// add keystrokes to a letter and update its weight in the Fenwick tree. letters that aren't in any word keep the weight 0
+// letter: input. the letter
+// keys: input. number of new keystrokes. the older keystrokes are decayed once per new keystroke
+// errors: input. number of new errors
+void WordSampler::update_letter(unsigned char letter, float keys, float errors)
+{
+	if (index->letter_word_start.empty() || index->letter_word_start[letter + 1] == index->letter_word_start[letter])
+		return;
+
+	if (keys > 0)
+	{
+		letter_keys[letter] *= KEY_DECAY;
+		letter_errors[letter] *= KEY_DECAY;
+	}
+	letter_keys[letter] += keys;
+	letter_errors[letter] += errors;
+	if (letter_errors[letter] > letter_keys[letter] + PRIOR_KEYS - PRIOR_ERRORS)	// the error rate can't be higher than 1
+		letter_errors[letter] = letter_keys[letter] + PRIOR_KEYS - PRIOR_ERRORS;
+
+	set_letter_weight(letter, get_error_rate((char)letter));
+}
+
+// change the weight of a letter in the Fenwick tree. every node that contains the letter is updated (8 nodes)
+// letter: input. the letter
+// weight: input. new weight
+void WordSampler::set_letter_weight(unsigned char letter, double weight)
+{
+	double delta = weight - letter_weights[letter];
+	letter_weights[letter] = weight;
+	for (unsigned int node = letter + 1; node <= NUM_LETTERS; node += node & (~node + 1))	// node & -node: lowest set bit
+		letter_tree[node] += delta;
+}
+
+// find the letter where the sum of the weights of all letters before it is below value and the sum including it is above value
+// value: input. 0...sum of all weights
+// return: the letter. -1 if no letter was found (because of rounding errors)
+int WordSampler::find_letter(double value)
+{
+	unsigned int node = 0;
+	for (unsigned int step = NUM_LETTERS; step > 0; step >>= 1)
+	{
+		if (node + step <= NUM_LETTERS && letter_tree[node + step] <= value)
+		{
+			node += step;
+			value -= letter_tree[node];
+		}
+	}
+	if (node >= NUM_LETTERS || letter_weights[node] <= 0)
+		return -1;
+	return (int)node;	// the node after the found prefix is the letter + 1
+}
+
+// probability that a word with the given length is accepted. 1 for the target length
+float WordSampler::length_acceptance(unsigned int length)
+{
+	return 1.f / (1.f + fabs((float)length - target_length));
+}
+
+// returns a random number between 0 (included) and 1 (excluded)
+double WordSampler::random_unit()
+{
+	return (double)rand() / ((double)RAND_MAX + 1);
+}
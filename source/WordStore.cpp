@@ -0,0 +1,208 @@
+#include <cstring>
+#include "WordStore.h"
+#include "ByteOrder.h"
+
+using namespace std;
+
+// compare two words byte by byte like strcmp (the words are not terminated by '\0')
+// return: < 0 if word_a is sorted before word_b, 0 if the words are equal, > 0 if word_a is sorted after word_b
+static int compare_words(const char* letters_a, unsigned int length_a, const char* letters_b, unsigned int length_b)
+{
+	int result = memcmp(letters_a, letters_b, (length_a < length_b) ? length_a : length_b);
+	if (result != 0)
+		return result;
+	return (length_a < length_b) ? -1 : (length_a > length_b) ? 1 : 0;
+}
+
+// Constructor. the store is empty
+OffsetTableStore::OffsetTableStore()
+{
+	word_offsets.push_back(0);
+}
+
+// append a word at the end of the store
+// letters: input. first character of the word
+// length: input. number of characters of the word
+void OffsetTableStore::add_word(const char* letters, unsigned int length)
+{
+	word_data.insert(word_data.end(), letters, letters + length);
+	word_offsets.push_back((unsigned int)word_data.size());
+}
+
+// called after the last add_word(). frees the memory that was reserved for more words
+void OffsetTableStore::finish()
+{
+	word_data.shrink_to_fit();
+	word_offsets.shrink_to_fit();
+}
+
+unsigned int OffsetTableStore::get_num_words() const
+{
+	return (unsigned int)word_offsets.size() - 1;
+}
+
+// copy the word with the given ordinal into a string
+// index: input. ordinal of the word. must be smaller than get_num_words()
+// word: output. the word
+void OffsetTableStore::get_word(unsigned int index, string& word) const
+{
+	word.assign(word_data.data() + word_offsets[index], word_offsets[index + 1] - word_offsets[index]);
+}
+
+// search a word by comparing every word of the store
+// letters: input. first character of the word
+// length: input. number of characters of the word
+// return: ordinal of the first equal word. -1 if the word is not in the store
+int OffsetTableStore::find_word(const char* letters, unsigned int length) const
+{
+	for (unsigned int i = 0; i < get_num_words(); i++)
+	{
+		if (word_offsets[i + 1] - word_offsets[i] == length && memcmp(word_data.data() + word_offsets[i], letters, length) == 0)
+			return (int)i;
+	}
+	return -1;
+}
+
+// returns the number of bytes that are used by the words and the offset table
+size_t OffsetTableStore::get_memory_size() const
+{
+	return sizeof(*this) + word_data.capacity() + word_offsets.capacity() * sizeof(unsigned int);
+}
+
+// Constructor. the store is empty
+FrontCodedStore::FrontCodedStore()
+{
+	num_words = 0;
+}
+
+// append a word at the end of the store. the words must be added in sorted order (see compare_words()) and without duplicates
+// letters: input. first character of the word
+// length: input. number of characters of the word
+void FrontCodedStore::add_word(const char* letters, unsigned int length)
+{
+	if (num_words % BLOCK_SIZE == 0)	// first word of a new block
+	{
+		block_offsets.push_back((unsigned int)block_data.size());
+		append_varint(length, block_data);
+		block_data.insert(block_data.end(), letters, letters + length);
+	}
+	else
+	{
+		unsigned int prefix_length = 0;
+		while (prefix_length < length && prefix_length < last_word.size() && last_word[prefix_length] == letters[prefix_length])
+			prefix_length++;
+		append_varint(prefix_length, block_data);
+		append_varint(length - prefix_length, block_data);
+		block_data.insert(block_data.end(), letters + prefix_length, letters + length);
+	}
+	last_word.assign(letters, length);
+	num_words++;
+}
+
+// called after the last add_word(). frees the memory that was reserved for more words
+void FrontCodedStore::finish()
+{
+	block_offsets.push_back((unsigned int)block_data.size());
+	block_data.shrink_to_fit();
+	block_offsets.shrink_to_fit();
+	string().swap(last_word);
+}
+
+unsigned int FrontCodedStore::get_num_words() const
+{
+	return num_words;
+}
+
+// decode the word with the given ordinal. the words of its block are decoded from the first word of the block up to the word
+// index: input. ordinal of the word. must be smaller than get_num_words()
+// word: output. the word
+void FrontCodedStore::get_word(unsigned int index, string& word) const
+{
+	unsigned int block = index / BLOCK_SIZE;
+	const char* data_end = block_data.data() + block_offsets[block + 1];
+	unsigned int length;
+	const char* data = get_first_word(block, length);
+	word.assign(data, length);
+	data += length;
+
+	for (unsigned int i = 0; i < index % BLOCK_SIZE; i++)
+		data = read_next_word(data, data_end, word);
+}
+
+// search a word with a binary search over the first words of the blocks and a linear search in the block
+// letters: input. first character of the word
+// length: input. number of characters of the word
+// return: ordinal of the word. -1 if the word is not in the store
+int FrontCodedStore::find_word(const char* letters, unsigned int length) const
+{
+	unsigned int num_blocks = (unsigned int)block_offsets.size() - 1;
+	if (num_words == 0)
+		return -1;
+
+	// find the last block whose first word is not sorted after the word
+	unsigned int low = 0, high = num_blocks;	// the block is in [low, high)
+	while (high - low > 1)
+	{
+		unsigned int middle = (low + high) / 2;
+		unsigned int first_length;
+		const char* first_word = get_first_word(middle, first_length);
+		if (compare_words(first_word, first_length, letters, length) <= 0)
+			low = middle;
+		else
+			high = middle;
+	}
+
+	// decode the words of the block until the word is found or a word is sorted after it
+	unsigned int first_index = low * BLOCK_SIZE;
+	unsigned int block_words = (num_words - first_index < BLOCK_SIZE) ? num_words - first_index : (unsigned int)BLOCK_SIZE;
+	const char* data_end = block_data.data() + block_offsets[low + 1];
+	unsigned int first_length;
+	const char* data = get_first_word(low, first_length);
+	string word(data, first_length);
+	data += first_length;
+	for (unsigned int i = 0; i < block_words; i++)
+	{
+		if (i > 0)
+			data = read_next_word(data, data_end, word);
+		int result = compare_words(word.data(), (unsigned int)word.size(), letters, length);
+		if (result == 0)
+			return (int)(first_index + i);
+		if (result > 0)
+			break;
+	}
+	return -1;
+}
+
+// returns the number of bytes that are used by the blocks and the block index
+size_t FrontCodedStore::get_memory_size() const
+{
+	return sizeof(*this) + block_data.capacity() + block_offsets.capacity() * sizeof(unsigned int) + last_word.capacity();
+}
+
+// returns the first word of a block (stored completely)
+// block: input. index of the block
+// length: output. number of characters of the word
+// return: first character of the word
+const char* FrontCodedStore::get_first_word(unsigned int block, unsigned int& length) const
+{
+	const char* data = block_data.data() + block_offsets[block];
+	sf::Uint32 first_length;
+	data = read_varint(data, block_data.data() + block_offsets[block + 1], first_length);
+	length = first_length;
+	return data;
+}
+
+// decode the next word of a block. the word shares the first letters with the previous word
+// data: input. start of the next word in block_data
+// data_end: input. end of the block
+// word: input/ output. the previous word as input, the next word as output
+// return: start of the word after the next word
+const char* FrontCodedStore::read_next_word(const char* data, const char* data_end, string& word)
+{
+	sf::Uint32 prefix_length, suffix_length;
+	data = read_varint(data, data_end, prefix_length);
+	data = read_varint(data, data_end, suffix_length);
+	word.resize(prefix_length);
+	word.append(data, suffix_length);
+	return data + suffix_length;
+}
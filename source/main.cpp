@@ -1,158 +1,421 @@
-#include <list>
-#include <thread>
-#include <mutex>
-#include "Entity.h"
-#include "GameSettings.h"
-#include "StartScreen.h"
-#include "OptionScreen.h"
-#include "Playfield.h"
-
-using namespace std;
-
-// Explanation of some C++ Terminology: see Entity.h
-// Tutorial for running SFML in Visual Studio: https://www.sfml-dev.org/tutorials/2.5/start-vc.php
-// SFML Version used: 2.5.1
-
-mutex mutex_glob;	// the mutex is used to prevent the manipulation of the same data in different threads at the same time.
-
-// Template Function. deletes every Element of a list (considering that the memory of the Elements were allocated by 'new')
-// list_in: input/ output. list with Elements of the template type T
-template <typename T> void delete_list(list<T>& list_in)
-{
-	for (auto entity_it = list_in.begin(); entity_it != list_in.end(); )	// iterator is used to point at the Elements of the list. get the fitting type automatically with auto
-	{
-		T entity_tmp = *entity_it;				// store the current Element to still have a pointer on it after the erase from the list and to delete it afterwards
-		// delete the Element from the list pointed by the iterator. return a new iterator with the updated list which points on the Element after the deleted one
-		entity_it = list_in.erase(entity_it);
-		// after the element is erased from the list, delete must still be called. delete calls the destructor and frees up the memory that was allocated by new.
-		delete entity_tmp;
-	}
-}
-
-// In this task all Entities that have a physic are getting updated.
-// phys_entity: input. Reference to the list of the entities to update.
-// running: input. this reference is used to signal the thread to terminate.
-void physic_task(list<Entity*>& phys_entity, bool& running)
-{
-	while (1)
-	{
-		for (list<Entity*>::iterator entity_it = phys_entity.begin(); entity_it != phys_entity.end(); entity_it++)	// iterator is used to point at the Elements of the list.
-		{
-			// entity_it is a pointer to a list Element which is a pointer to an Entity. To get a Entity object, the iterator must be dereferenced 2 times.
-			(*entity_it)->update_physics();
-		}
-
-		this_thread::sleep_for(chrono::milliseconds(10));	// sleep some time before updating the physics again
-
-		if (!running)
-			break;
-	}
-}
-
-// main game loop
-int main()
-{
-	srand((unsigned int)time(0));	// use current time in seconds since January 1, 1970 as seed for rand() functions
-	(void)rand();					// returns an integer between 0 and RAND_MAX. use rand one time to make the next call more random
-	
-	GameSettings settings;			// create a GameSettings object that is valid for the whole main thread
-	list<Entity*> entities;			// list where Pointer to all Entities to process are stored
-
-	// create the game window. window can be closed and has a titlebar but cannot be resized
-	sf::RenderWindow window(sf::VideoMode((unsigned int)settings.get_window_size().x, (unsigned int)settings.get_window_size().y), "typing_game", sf::Style::Titlebar | sf::Style::Close);
-	window.setVerticalSyncEnabled(true);	// enable V-Sync
-
-	// start a separate thread to compute the physics of all objects (not really needed in this case, just to demonstrate the concept)
-	bool physic_thread_running = true;	// flag to signal the thread to terminate
-	// The first argument is the name of the function/ method that shall be started in a new thread.
-	// if a reference needs to be passed to a thread, it must be wrapped in std::ref()
-	thread physic_thread(physic_task, ref(entities), ref(physic_thread_running));
-
-	GameSettings::game_state_t last_game_state = settings.game_state;		// always store the last game_state to detect a change in game_state
-	
-	while (window.isOpen())
-	{
-		// delete entity list
-		mutex_glob.lock();		// lock the mutex if free or wait here and lock it when its free
-		delete_list(entities);
-		mutex_glob.unlock();	// release the mutex again
-
-		// put Entities in the Entity list according to the game_state. Process these Entities in the main loop (invoke all functions that are declared in the Entity class)
-		switch (settings.game_state)
-		{
-		case GameSettings::START_SCREEN:
-			last_game_state = settings.game_state;
-			entities.push_back(new StartScreen(settings));
-			break;
-
-		case GameSettings::PLAY_SCREEN:
-			last_game_state = settings.game_state;
-			switch (settings.getBoundaryID())
-			{
-			case GameSettings::RECT:
-				entities.push_back(new PlayfieldRect(settings));
-				break;
-			case GameSettings::CIRC:
-				entities.push_back(new PlayfieldCirlce(settings));
-				break;
-			}
-			break;
-
-		case GameSettings::OPTIONS_SCREEN:
-			last_game_state = settings.game_state;
-			entities.push_back(new OptionScreen(settings));
-			break;
-
-		case GameSettings::EXIT:		// if game window was closed or exit Button was pressed
-			last_game_state = settings.game_state;
-			window.close();
-			break;
-		}
-		
-		while (window.isOpen())
-		{
-			sf::Event event;
-			while (window.pollEvent(event))		// process all SFML events that occurred since the last poll
-			{
-				if (event.type == sf::Event::Closed)
-					settings.game_state = GameSettings::EXIT;
-
-				if (event.type == sf::Event::KeyPressed)
-				{
-					for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
-					{
-						(*entity_it)->key_pressed_processor(event.key);
-					}
-				}
-
-				if (event.type == sf::Event::MouseButtonPressed)
-				{
-					for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
-					{
-						(*entity_it)->mouse_clicked_processor(event.mouseButton);
-					}
-				}
-			}
-
-			for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
-			{
-				(*entity_it)->update();
-			}
-
-			window.clear();
-			for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
-			{
-				(*entity_it)->draw_on_window(window);
-			}
-			window.display();
-
-			if (last_game_state != settings.game_state)	// if game state changed
-				break;
-		}
-	}
-	// end the physics thread before exiting the main.
-	physic_thread_running = false;	// set flag to signal to the thread to end
-	physic_thread.join();			// wait for thread to finish
-
-	return 0;
-}
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <iostream>
+#include "Entity.h"
+#include "GameSettings.h"
+#include "SplashScreen.h"
+#include "StartScreen.h"
+#include "OptionScreen.h"
+#include "StatsScreen.h"
+#include "Playfield.h"
+#include "HeadlessSim.h"
+#include "StressTest.h"
+#include "FrameProfiler.h"
+#include "FramePacer.h"
+#include "FrameCapture.h"
+#include "RenderThread.h"
+#include "TraceEvents.h"
+
+using namespace std;
+
+// Explanation of some C++ Terminology: see Entity.h
+// Tutorial for running SFML in Visual Studio: https://www.sfml-dev.org/tutorials/2.5/start-vc.php
+// SFML Version used: 2.5.1
+
+mutex mutex_glob;	// the mutex is used to prevent the manipulation of the same data in different threads at the same time.
+
+enum idle_timing
+{
+	IDLE_POLL_MS = 10		// in milliseconds. how often the main loop checks for events and background changes in the idle mode (the same interval as sf::Window::waitEvent())
+};
+
+// controls the physics thread. the thread sleeps on the condition variable while no entity is animating (e.g. on the Start Screen or after a round), instead of waking up on every tick
+typedef struct physics_control
+{
+	mutex control_mutex;				// protects running and active
+	condition_variable control_cv;		// signals the physics thread that running or active changed
+	bool running;						// false signals the thread to terminate
+	bool active;						// true if an entity is animating, so the physics must be updated
+	// the mutex also protects the entity list while the physics thread iterates it. lock order: control_mutex before mutex_glob
+} physics_control_t;
+
+// Template Function. deletes every Element of a list (considering that the memory of the Elements were allocated by 'new')
+// list_in: input/ output. list with Elements of the template type T
+template <typename T> void delete_list(list<T>& list_in)
+{
+	for (auto entity_it = list_in.begin(); entity_it != list_in.end(); )	// iterator is used to point at the Elements of the list. get the fitting type automatically with auto
+	{
+		T entity_tmp = *entity_it;				// store the current Element to still have a pointer on it after the erase from the list and to delete it afterwards
+		// delete the Element from the list pointed by the iterator. return a new iterator with the updated list which points on the Element after the deleted one
+		entity_it = list_in.erase(entity_it);
+		// after the element is erased from the list, delete must still be called. delete calls the destructor and frees up the memory that was allocated by new.
+		delete entity_tmp;
+	}
+}
+
+// In this task all Entities that have a physic are getting updated.
+// phys_entity: input. Reference to the list of the entities to update.
+// control: input. signals the thread to terminate or to sleep until an entity is animating
+// settings: input. the physics tick rate is taken from the settings on every tick, so a change in the Option Screen is applied immediately
+void physic_task(list<Entity*>& phys_entity, physics_control_t& control, GameSettings& settings)
+{
+	sf::Clock tick_clock;	// measures the duration of one physics tick for the FrameProfiler
+	TRACE_THREAD_NAME("physics");
+
+	while (1)
+	{
+		{
+			// sleep until the physics is needed again or the thread shall terminate.
+			// the lock is held during the tick, so the main thread can't change the entity list (when the screen is switched) while it is iterated
+			unique_lock<mutex> lock(control.control_mutex);
+			control.control_cv.wait(lock, [&]() { return control.active || !control.running; });
+			if (!control.running)
+				break;
+
+			tick_clock.restart();
+			TRACE_ZONE("physics tick");
+			for (list<Entity*>::iterator entity_it = phys_entity.begin(); entity_it != phys_entity.end(); entity_it++)	// iterator is used to point at the Elements of the list.
+			{
+				// entity_it is a pointer to a list Element which is a pointer to an Entity. To get a Entity object, the iterator must be dereferenced 2 times.
+				(*entity_it)->update_physics();
+			}
+		}
+		frame_profiler.add_sample(FrameProfiler::PHYSICS_TICK, tick_clock.getElapsedTime());
+		frame_profiler.flush_accumulator(FrameProfiler::MUTEX_WAIT_PHYSICS);
+
+		// sleep the rest of the tick interval before updating the physics again
+		sf::Time tick_interval = sf::microseconds(1000000 / settings.getPhysicsTickRate());
+		sf::Time tick_duration = tick_clock.getElapsedTime();
+		if (tick_duration < tick_interval)
+			this_thread::sleep_for(chrono::microseconds((tick_interval - tick_duration).asMicroseconds()));
+	}
+}
+
+// returns true if any entity is animating (see Entity::is_animating())
+// entities: input. the entities of the current screen
+// overlay: input. the profiler overlay, which is not in the entity list
+static bool is_any_entity_animating(list<Entity*>& entities, ProfilerOverlay& overlay)
+{
+	for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
+	{
+		if ((*entity_it)->is_animating())
+			return true;
+	}
+	return overlay.is_animating();
+}
+
+// wait in the idle mode until an event occurs or an entity is animating again (e.g. a status message of a background thread).
+// SFML 2.5 implements waitEvent() by polling the events every 10 ms (because of the joysticks), so this loop doesn't wake up more often than waitEvent(),
+// but it also notices the changes of the background threads, which don't produce a window event
+// window: input. the game window
+// event: output. the event that ended the waiting
+// entities: input. the entities of the current screen
+// overlay: input. the profiler overlay
+// return: true if an event occurred. false if an entity is animating
+static bool wait_for_event(sf::RenderWindow& window, sf::Event& event, list<Entity*>& entities, ProfilerOverlay& overlay)
+{
+	while (window.isOpen())
+	{
+		if (window.pollEvent(event))
+			return true;
+		if (is_any_entity_animating(entities, overlay))
+			return false;
+		this_thread::sleep_for(chrono::milliseconds(IDLE_POLL_MS));
+	}
+	return false;
+}
+
+// main game loop
+// the game can also be run without a window with the command line argument "--headless" (see HeadlessSim.h) or "--stress" (see StressTest.h)
+// return: exit code of the program
+static int run_game(int argc, char* argv[])
+{
+	srand((unsigned int)time(0));	// use current time in seconds since January 1, 1970 as seed for rand() functions
+	(void)rand();					// returns an integer between 0 and RAND_MAX. use rand one time to make the next call more random
+	sf::Clock startup_clock;		// measures the time until the window shows the first frame
+	
+	GameSettings settings;			// create a GameSettings object that is valid for the whole main thread. starts loading the assets in the background
+	list<Entity*> entities;			// list where Pointer to all Entities to process are stored
+
+	headless_config_t headless_config;
+	int headless_arg = parse_headless_args(argc, argv, headless_config);
+	if (headless_arg < 0)			// if invalid command line arguments
+		return 1;
+	TRACE_THREAD_NAME("main");
+	if (headless_arg > 0)			// run the simulation instead of the game
+	{
+		int exit_code = run_headless_simulation(settings, headless_config);
+		TRACE_WRITE_FILE(TRACE_FILENAME);
+		return exit_code;
+	}
+
+	stress_config_t stress_config;
+	int stress_arg = parse_stress_args(argc, argv, stress_config);
+	if (stress_arg < 0)				// if invalid command line arguments
+		return 1;
+	if (stress_arg > 0)				// run the stress test instead of the game
+	{
+		int exit_code = run_stress_test(settings, stress_config);
+		TRACE_WRITE_FILE(TRACE_FILENAME);
+		return exit_code;
+	}
+
+	// the frame pacing of the settings can be overridden for this run with "--fps vsync|uncapped|<n>" (e.g. for render benchmarks). the override is not saved
+	int pacing_mode = settings.getFramePacing();
+	unsigned int fps_cap = settings.getFpsCap();
+	int fps_arg = FramePacer::parse_args(argc, argv, pacing_mode, fps_cap);
+	if (fps_arg < 0)				// if invalid command line arguments
+		return 1;
+
+	// the frames can be recorded with "--capture <file.y4m | png prefix>" (see FrameCapture.h)
+	FrameCapture::capture_config_t capture_config;
+	int capture_arg = FrameCapture::parse_args(argc, argv, capture_config);
+	if (capture_arg < 0)			// if invalid command line arguments
+		return 1;
+
+	// create the game window. window can be closed and has a titlebar but cannot be resized
+	sf::RenderWindow window(sf::VideoMode((unsigned int)settings.get_window_size().x, (unsigned int)settings.get_window_size().y), "typing_game", sf::Style::Titlebar | sf::Style::Close);
+	FramePacer frame_pacer(&window);	// sets the V-Sync of the window
+	frame_pacer.set_mode(pacing_mode, fps_cap);
+
+	// overlay with the frame timings. toggled with F3. it is not in the entity list, because it is shown on every screen
+	ProfilerOverlay profiler_overlay;
+	profiler_overlay.load_font("resources/fonts/consola.ttf");
+	profiler_overlay.set_frame_pacer(&frame_pacer);
+	sf::Clock stage_clock;	// measures the duration of every stage of a frame for the FrameProfiler
+	sf::Clock frame_clock;	// measures the duration of a whole frame for the FrameProfiler
+
+	// the frames are captured by the render thread and written by the encoder threads of the capture. declared before the render thread, which uses it
+	FrameCapture frame_capture;
+	if (capture_arg > 0 && frame_capture.start(capture_config, window.getSize().x, window.getSize().y) < 0)
+		cerr << "capture file " << capture_config.path << " can't be written" << endl;
+
+	// the frames are drawn and displayed by the render thread. the main loop only records the draw commands of every frame.
+	// declared after the profiler overlay and the settings, because the recorded commands use their fonts and textures
+	RenderThread render_thread(window, frame_pacer);
+	render_thread.set_frame_capture(&frame_capture);
+	render_thread.start();
+
+	// start a separate thread to compute the physics of all objects (not really needed in this case, just to demonstrate the concept)
+	physics_control_t physics_control;
+	physics_control.running = true;		// flag to signal the thread to terminate
+	physics_control.active = false;		// the thread sleeps until an entity is animating
+	bool physics_active = false;		// last value of physics_control.active. only changed by the main thread, so it can be read without the mutex
+	// The first argument is the name of the function/ method that shall be started in a new thread.
+	// if a reference needs to be passed to a thread, it must be wrapped in std::ref()
+	thread physic_thread(physic_task, ref(entities), ref(physics_control), ref(settings));
+
+	GameSettings::game_state_t last_game_state = settings.game_state;		// always store the last game_state to detect a change in game_state
+	sf::Time window_shown_time = sf::Time::Zero;	// time from the start of the program until the first frame was submitted to the render thread
+	bool startup_reported = false;	// the timings of the startup are printed once, when all assets are loaded
+	bool idle = false;				// true if no entity was animating in the last frame. then the next frame is only drawn after an event
+	
+	int exit_code = 0;
+	try
+	{
+		while (window.isOpen())
+		{
+			{
+				TRACE_ZONE("switch screen");	// delete the entities of the last screen and create the entities of the new screen
+				lock_guard<mutex> physics_lock(physics_control.control_mutex);	// the physics thread must not iterate the entity list while it is changed
+				render_thread.flush();		// the render thread must not draw the last frame of the old screen while its entities are deleted
+				// delete entity list
+				frame_profiler.lock(mutex_glob, FrameProfiler::MUTEX_WAIT_MAIN);	// lock the mutex if free or wait here and lock it when its free. the waiting time is measured
+				delete_list(entities);
+				mutex_glob.unlock();	// release the mutex again
+
+				// put Entities in the Entity list according to the game_state. Process these Entities in the main loop (invoke all functions that are declared in the Entity class)
+				switch (settings.game_state)
+				{
+				case GameSettings::SPLASH_SCREEN:
+					last_game_state = settings.game_state;
+					entities.push_back(new SplashScreen(settings));
+					break;
+
+				case GameSettings::START_SCREEN:
+					last_game_state = settings.game_state;
+					entities.push_back(new StartScreen(settings));
+					break;
+
+				case GameSettings::PLAY_SCREEN:
+					last_game_state = settings.game_state;
+					switch (settings.getBoundaryID())
+					{
+					case GameSettings::RECT:
+						entities.push_back(new PlayfieldRect(settings));
+						break;
+					case GameSettings::CIRC:
+						entities.push_back(new PlayfieldCirlce(settings));
+						break;
+					}
+					break;
+
+				case GameSettings::OPTIONS_SCREEN:
+					last_game_state = settings.game_state;
+					entities.push_back(new OptionScreen(settings));
+					break;
+
+				case GameSettings::STATS_SCREEN:
+					last_game_state = settings.game_state;
+					entities.push_back(new StatsScreen(settings));
+					break;
+
+				case GameSettings::EXIT:		// if game window was closed or exit Button was pressed
+					last_game_state = settings.game_state;
+					render_thread.stop();	// the window can only be closed after the render thread has terminated
+					window.close();
+					break;
+				}
+			}
+		
+			idle = false;		// the first frame of a new screen is always drawn
+			while (window.isOpen())
+			{
+				sf::Event event;
+				bool event_pending = false;		// true if waitEvent() returned an event that is not processed yet
+				if (idle)
+				{
+					TRACE_ZONE("idle wait");	// nothing changes on the screen without an event or a background change, so the frame isn't drawn again until then
+					event_pending = wait_for_event(window, event, entities, profiler_overlay);
+					frame_clock.restart();		// the waiting time is not part of the frame
+					render_thread.skip_frame();
+				}
+
+				stage_clock.restart();
+				TRACE_ZONE("frame");
+				{
+					TRACE_ZONE("event poll");
+					while (event_pending || window.pollEvent(event))		// process all SFML events that occurred since the last poll
+					{
+						event_pending = false;
+						if (event.type == sf::Event::Closed)
+							settings.game_state = GameSettings::EXIT;
+
+						if (event.type == sf::Event::KeyPressed)
+						{
+							profiler_overlay.key_pressed_processor(event.key);
+							if (event.key.code == sf::Keyboard::F4)		// write the trace file without exiting the game
+								TRACE_WRITE_FILE(TRACE_FILENAME);
+							for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
+							{
+								(*entity_it)->key_pressed_processor(event.key);
+							}
+						}
+
+						if (event.type == sf::Event::MouseButtonPressed)
+						{
+							for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
+							{
+								(*entity_it)->mouse_clicked_processor(event.mouseButton);
+							}
+						}
+					}
+				}
+
+				frame_profiler.add_sample(FrameProfiler::EVENT_POLL, stage_clock.restart());
+
+				{
+					TRACE_ZONE("update");
+					for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
+					{
+						(*entity_it)->update();
+					}
+					profiler_overlay.update();
+					settings.get_asset_loader().rethrow_error();	// a font or a texture that can't be loaded ends the game
+				}
+				frame_profiler.add_sample(FrameProfiler::UPDATE, stage_clock.restart());
+
+				// go into the idle mode if no entity is animating. the physics thread sleeps until an entity is animating again.
+				// the physics thread holds control_mutex during a whole tick, so the mutex is only locked when the state changes
+				idle = !is_any_entity_animating(entities, profiler_overlay);
+				if (physics_active == idle)
+				{
+					physics_active = !idle;
+					lock_guard<mutex> lock(physics_control.control_mutex);
+					physics_control.active = physics_active;
+					physics_control.control_cv.notify_one();
+				}
+
+				{
+					TRACE_ZONE("draw");		// record the draw commands of the frame. they are drawn by the render thread
+					DrawCommandBuffer& commands = render_thread.get_command_buffer();
+					commands.clear();
+					for (auto entity_it = entities.begin(); entity_it != entities.end(); entity_it++)
+					{
+						commands.draw_entity(**entity_it);
+					}
+					commands.draw_entity(profiler_overlay);
+				}
+				frame_profiler.add_sample(FrameProfiler::DRAW, stage_clock.restart());
+
+				{
+					TRACE_ZONE("submit");	// waits until the render thread has displayed the frame before (and for V-Sync or the frame pacing)
+					render_thread.submit();
+				}
+
+				// apply a frame pacing that was changed in the Option Screen (unless it is set by the command line)
+				if (fps_arg == 0 && (settings.getFramePacing() != pacing_mode || settings.getFpsCap() != fps_cap))
+				{
+					pacing_mode = settings.getFramePacing();
+					fps_cap = settings.getFpsCap();
+					render_thread.set_frame_pacing(pacing_mode, fps_cap);
+				}
+
+				if (window_shown_time == sf::Time::Zero)
+					window_shown_time = startup_clock.getElapsedTime();
+				if (!startup_reported && settings.get_asset_loader().is_finished())	// print the duration of every load phase, so a slower startup is noticed
+				{
+					cout << settings.get_asset_loader().get_report() << ", window shown after " << window_shown_time.asMicroseconds() / 1000.0 << " ms" << endl;
+					startup_reported = true;
+				}
+				frame_profiler.add_sample(FrameProfiler::FRAME, frame_clock.restart());
+				frame_profiler.flush_accumulator(FrameProfiler::MUTEX_WAIT_MAIN);
+
+				if (last_game_state != settings.game_state)	// if game state changed
+					break;
+			}
+		}
+	}
+	catch (const ResourceLoadError& err)	// a texture or a font of a screen can't be loaded
+	{
+		cerr << err.what() << endl;
+		exit_code = 1;
+		render_thread.stop();
+		window.close();
+	}
+
+	// end the physics thread before exiting the main.
+	{
+		lock_guard<mutex> lock(physics_control.control_mutex);
+		physics_control.running = false;	// set flag to signal to the thread to end
+		physics_control.control_cv.notify_one();
+	}
+	physic_thread.join();			// wait for thread to finish
+
+	render_thread.stop();			// the frame pacer is only used by the render thread
+	TRACE_WRITE_FILE(TRACE_FILENAME);	// write all recorded zones (if the game is compiled with TYPING_GAME_TRACE)
+	cout << frame_pacer.get_report() << endl;
+	if (frame_capture.is_running())
+	{
+		frame_capture.stop();		// writes the remaining captured frames
+		cout << frame_capture.get_report() << endl;
+	}
+
+	return exit_code;
+}
+
+// start the game. a texture or a font that can't be loaded ends the program with an error message
+int main(int argc, char* argv[])
+{
+	try
+	{
+		return run_game(argc, argv);
+	}
+	catch (const ResourceLoadError& err)
+	{
+		cerr << err.what() << endl;
+		return 1;
+	}
+}